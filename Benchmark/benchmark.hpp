@@ -0,0 +1,81 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+#include <SymbolGenerator/logger.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+
+namespace symgen::bench {
+    // Runs benchmarks and reports their throughput. Every benchmark is repeated until it has run for at least the minimum time,
+    // and reports the number of symbols and bytes it processed per second, based on the amount of work done by a single iteration.
+    class benchmark_runner {
+    public:
+        // Results are logged through a logger of their own, so the output of SymbolGenerator itself can be silenced while benchmarks run.
+        benchmark_runner(std::chrono::milliseconds min_time, std::string filter) :
+            log(logger::instance().fork("Benchmark")),
+            min_time(min_time),
+            filter(std::move(filter))
+        {}
+
+
+        // Runs the given function as a benchmark, unless its name does not contain the filter.
+        // Setup is invoked before every iteration and is not included in the measurement.
+        template <typename Setup, typename Fn>
+        void run(std::string_view name, std::uint64_t symbols, std::uint64_t bytes, Setup&& setup, Fn&& fn) {
+            using namespace std::chrono;
+            if (name.find(filter) == std::string_view::npos) return;
+
+
+            std::size_t iterations = 0;
+            nanoseconds elapsed { 0 };
+
+            do {
+                setup();
+
+                auto start = steady_clock::now();
+                fn();
+                elapsed += steady_clock::now() - start;
+
+                ++iterations;
+            } while (elapsed < min_time);
+
+
+            const double seconds = duration<double> { elapsed }.count() / (double) iterations;
+
+            std::ostringstream stream;
+            stream << std::fixed << std::setprecision(3)
+                << std::left << std::setw(40) << name << std::right
+                << std::setw(12) << seconds * 1e3 << " ms/iter"
+                << std::setw(14) << (double) symbols / seconds / 1e6 << " M symbols/s"
+                << std::setw(12) << (double) bytes / seconds / (1 << 20) << " MiB/s"
+                << "  (" << iterations << " iterations)";
+
+            log.normal(stream.str());
+        }
+
+
+        template <typename Fn> void run(std::string_view name, std::uint64_t symbols, std::uint64_t bytes, Fn&& fn) {
+            run(name, symbols, bytes, [] { }, std::forward<Fn>(fn));
+        }
+    private:
+        logger log;
+        std::chrono::milliseconds min_time;
+        std::string filter;
+    };
+
+
+    inline volatile std::size_t keep_alive_sink = 0;
+
+    // Prevents the compiler from optimizing away the computation of a value that is never used.
+    inline void keep_alive(std::size_t value) {
+        keep_alive_sink = value;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,202 @@
+#include <Benchmark/corpus_generator.hpp>
+#include <SymbolGenerator/utility.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+
+
+namespace symgen::bench {
+    constexpr std::uint16_t MACHINE_AMD64 = 0x8664;
+
+    constexpr std::uint32_t TEXT_SECTION_FLAGS = 0x60500020; // Code, aligned to 16 bytes, readable and executable.
+    constexpr std::uint32_t DATA_SECTION_FLAGS = 0xC0300040; // Initialized data, aligned to 4 bytes, readable and writable.
+
+    constexpr std::uint8_t STORAGE_CLASS_EXTERNAL = 2;
+    constexpr std::uint16_t SYMBOL_TYPE_FUNCTION  = 0x20;
+
+    // Number of different namespaces generated for every level of nesting, so that namespaces are shared between symbols like in real code.
+    constexpr std::size_t NAMESPACES_PER_LEVEL = 8;
+
+
+    corpus_generator::corpus_generator(corpus_settings settings) : settings(settings), random(settings.seed) {
+        // Sharing symbols only makes a difference if there are enough shared symbols for objects to share some, but not all of them.
+        const std::size_t shared_count = settings.symbols_per_object * 2;
+        shared_symbols.reserve(shared_count);
+
+        for (std::size_t i = 0; i < shared_count; ++i) {
+            bool is_data = chance(settings.data_percentage);
+            shared_symbols.emplace_back(make_symbol_name(is_data), is_data);
+        }
+    }
+
+
+    corpus_statistics corpus_generator::generate(const fs::path& directory) {
+        fs::remove_all(directory);
+        fs::create_directories(directory);
+
+        corpus_statistics result;
+
+
+        for (std::size_t i = 0; i < settings.object_count; ++i) {
+            std::vector<std::pair<std::string, bool>> symbols;
+            symbols.reserve(settings.symbols_per_object);
+
+            // Shared symbols are taken from a random window of the shared pool, so every symbol occurs at most once per object.
+            const std::size_t shared_count = settings.symbols_per_object * (std::min)(settings.duplicate_percentage, std::size_t { 100 }) / 100;
+            const std::size_t shared_start = std::uniform_int_distribution<std::size_t> { 0, shared_symbols.size() - shared_count } (random);
+
+            symbols.insert(symbols.end(), shared_symbols.begin() + shared_start, shared_symbols.begin() + shared_start + shared_count);
+
+            while (symbols.size() < settings.symbols_per_object) {
+                bool is_data = chance(settings.data_percentage);
+                symbols.emplace_back(make_symbol_name(is_data), is_data);
+            }
+
+            std::ranges::shuffle(symbols, random);
+
+
+            auto contents = make_object(symbols);
+            auto path = directory / stream_to_string("object", i, ".obj");
+
+            std::ofstream stream { path, std::ios::binary | std::ios::trunc };
+            stream.write((const char*) contents.data(), (std::streamsize) contents.size());
+
+            result.objects.push_back(std::move(path));
+            result.symbol_count += symbols.size();
+            result.byte_count   += contents.size();
+        }
+
+
+        return result;
+    }
+
+
+    std::string corpus_generator::make_symbol_name(bool is_data) {
+        const std::string id = stream_to_string(next_name++);
+
+        // Global variable of type int: ?name@scope@@3HA
+        if (is_data) return stream_to_string("?g", id, "@", make_scope(), "@3HA");
+
+
+        const bool is_template = chance(settings.template_percentage);
+        const bool is_member   = chance(50);
+
+        if (is_member) {
+            // Member function void f(void) of a class or class template: ?f@class@scope@@QEAAXXZ
+            std::string owner = is_template
+                ? stream_to_string("?$box", random() % NAMESPACES_PER_LEVEL, "@", make_template_argument(settings.template_depth), "@")
+                : stream_to_string("c", random() % NAMESPACES_PER_LEVEL, "@");
+
+            return stream_to_string("?f", id, "@", owner, make_scope(), "@QEAAXXZ");
+        } else {
+            // Free function int f(int) or a function template: ?f@scope@@YAHH@Z or ??$f@args@scope@@YAHH@Z
+            std::string name = is_template
+                ? stream_to_string("?$f", id, "@", make_template_argument(settings.template_depth), "@")
+                : stream_to_string("f", id, "@");
+
+            return stream_to_string("?", name, make_scope(), "@YAHH@Z");
+        }
+    }
+
+
+    bool corpus_generator::chance(std::size_t percentage) {
+        return random() % 100 < percentage;
+    }
+
+
+    std::string corpus_generator::make_scope(void) {
+        // Scopes are stored from the innermost to the outermost namespace, each terminated by an @.
+        std::string result;
+
+        for (std::size_t level = settings.namespace_depth; level > 1; --level) {
+            result += stream_to_string("n", level, "_", random() % NAMESPACES_PER_LEVEL, "@");
+        }
+
+        return result + "bench@";
+    }
+
+
+    std::string corpus_generator::make_template_argument(std::size_t depth) {
+        constexpr std::array primitive_types { "H", "N", "_K", "M", "_N" }; // int, double, unsigned long long, float, bool
+
+        if (depth == 0) return primitive_types[random() % primitive_types.size()];
+
+        // Class template instantiation bench::wrapN<argument>: V?$wrapN@argument@bench@@
+        return stream_to_string("V?$wrap", depth, "@", make_template_argument(depth - 1), "@bench@@");
+    }
+
+
+    std::vector<std::byte> corpus_generator::make_object(const std::vector<std::pair<std::string, bool>>& symbols) const {
+        constexpr std::size_t FILE_HEADER_SIZE    = 20;
+        constexpr std::size_t SECTION_HEADER_SIZE = 40;
+        constexpr std::size_t SECTION_COUNT       = 2;
+
+        std::vector<std::byte> result;
+
+        auto append = [&] (const auto& value) {
+            const auto* bytes = (const std::byte*) &value;
+            result.insert(result.end(), bytes, bytes + sizeof(value));
+        };
+
+        auto append_zeroes = [&] (std::size_t count) {
+            result.insert(result.end(), count, std::byte { 0 });
+        };
+
+
+        // File header. Sections contain no data, since SymbolGenerator only reads their characteristics.
+        append(MACHINE_AMD64);
+        append((std::uint16_t) SECTION_COUNT);
+        append((std::uint32_t) 0);
+        append((std::uint32_t) (FILE_HEADER_SIZE + SECTION_COUNT * SECTION_HEADER_SIZE));
+        append((std::uint32_t) symbols.size());
+        append((std::uint16_t) 0);
+        append((std::uint16_t) 0);
+
+
+        for (const auto& [name, flags] : { std::pair { ".text", TEXT_SECTION_FLAGS }, std::pair { ".data", DATA_SECTION_FLAGS } }) {
+            char section_name[8] = { };
+            std::ranges::copy(std::string_view { name }, section_name);
+
+            append(section_name);
+            append_zeroes(SECTION_HEADER_SIZE - sizeof(section_name) - sizeof(flags));
+            append(flags);
+        }
+
+
+        // The string table starts with its own size, so the first string is at offset four.
+        std::string string_table(sizeof(std::uint32_t), '\0');
+
+        for (const auto& [name, is_data] : symbols) {
+            if (name.size() <= 8) {
+                char short_name[8] = { };
+                std::ranges::copy(name, short_name);
+
+                append(short_name);
+            } else {
+                append((std::uint32_t) 0);
+                append((std::uint32_t) string_table.size());
+
+                string_table += name;
+                string_table += '\0';
+            }
+
+            append((std::uint32_t) 0);
+            append((std::int16_t) (is_data ? 2 : 1));
+            append((std::uint16_t) (is_data ? 0 : SYMBOL_TYPE_FUNCTION));
+            append(STORAGE_CLASS_EXTERNAL);
+            append((std::uint8_t) 0);
+        }
+
+
+        const auto string_table_size = (std::uint32_t) string_table.size();
+        std::memcpy(string_table.data(), &string_table_size, sizeof(string_table_size));
+
+        const auto* bytes = (const std::byte*) string_table.data();
+        result.insert(result.end(), bytes, bytes + string_table.size());
+
+
+        return result;
+    }
+}
\ No newline at end of file
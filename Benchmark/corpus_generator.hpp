@@ -0,0 +1,63 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace symgen::bench {
+    struct corpus_settings {
+        std::size_t object_count       = 200;
+        std::size_t symbols_per_object = 2000;
+        // Number of namespaces every symbol is nested in. The outermost namespace is always "bench".
+        std::size_t namespace_depth    = 3;
+        // Number of class templates nested in the arguments of every templated symbol, e.g. 2 for f<wrap0<wrap1<int>>>.
+        std::size_t template_depth     = 2;
+        // Percentage of symbols that are (members of) template instantiations.
+        std::size_t template_percentage    = 50;
+        // Percentage of the symbols of every object that are shared with other objects, like inline functions and template instantiations.
+        std::size_t duplicate_percentage   = 30;
+        // Percentage of symbols that are global variables rather than functions.
+        std::size_t data_percentage        = 10;
+        std::uint64_t seed = 1;
+    };
+
+
+    struct corpus_statistics {
+        std::vector<fs::path> objects;
+        std::size_t symbol_count = 0;
+        std::size_t byte_count   = 0;
+    };
+
+
+    // Generates MSVC-style x64 object files containing only a symbol table, which is all SymbolGenerator ever reads.
+    // Objects can be generated on any platform, so the benchmarks do not depend on a Windows toolchain.
+    class corpus_generator {
+    public:
+        explicit corpus_generator(corpus_settings settings);
+
+
+        // Writes the objects to the given directory, replacing any objects from earlier runs.
+        corpus_statistics generate(const fs::path& directory);
+
+        // Returns a random mangled symbol name. Data symbols are global variables, others are functions.
+        [[nodiscard]] std::string make_symbol_name(bool is_data);
+    private:
+        corpus_settings settings;
+        std::mt19937_64 random;
+        std::uint64_t next_name = 0;
+
+        // Symbols that may appear in more than one object.
+        std::vector<std::pair<std::string, bool>> shared_symbols;
+
+
+        [[nodiscard]] bool chance(std::size_t percentage);
+        [[nodiscard]] std::string make_scope(void);
+        [[nodiscard]] std::string make_template_argument(std::size_t depth);
+        [[nodiscard]] std::vector<std::byte> make_object(const std::vector<std::pair<std::string, bool>>& symbols) const;
+    };
+}
\ No newline at end of file
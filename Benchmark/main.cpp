@@ -0,0 +1,574 @@
+#include <Benchmark/benchmark.hpp>
+#include <Benchmark/corpus_generator.hpp>
+#include <SymbolGenerator/argument_parser.hpp>
+#include <SymbolGenerator/coff_reader.hpp>
+#include <SymbolGenerator/demangler.hpp>
+#include <SymbolGenerator/export_generator.hpp>
+#include <SymbolGenerator/import_library.hpp>
+#include <SymbolGenerator/logger.hpp>
+#include <SymbolGenerator/mapped_file.hpp>
+#include <SymbolGenerator/namespace_cache.hpp>
+#include <SymbolGenerator/object_cache.hpp>
+#include <SymbolGenerator/rule_engine.hpp>
+#include <SymbolGenerator/symbol_registry.hpp>
+#include <SymbolGenerator/symbol_scanner.hpp>
+#include <SymbolGenerator/utility.hpp>
+
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+using namespace symgen;
+using namespace symgen::bench;
+
+
+// Number of symbol names used by the benchmarks of individual stages, which would otherwise take unreasonably long for large corpora.
+constexpr std::size_t MAX_SAMPLE_SIZE = 100'000;
+
+
+static void remove_caches(const fs::path& directory) {
+    for (const auto& entry : fs::directory_iterator { directory }) {
+        if (entry.path().extension() == ".objcache") fs::remove(entry.path());
+    }
+}
+
+
+// Checks that the vectorized namespace splitter agrees with the reference implementation for every supported instruction set,
+// both for the names of the corpus and for random names made of structural characters, which are up to a few blocks long.
+// Returns the first name for which they disagree.
+static std::optional<std::string> verify_namespace_splitter(const std::vector<std::string>& names, std::size_t random_names, std::uint64_t seed) {
+    constexpr std::string_view alphabet = "ab::<>`'";
+
+    std::mt19937_64 random { seed };
+    std::string random_name;
+
+    auto check = [] (std::string_view name) {
+        const auto expected = split_symbol_namespaces_reference(name);
+
+        for (auto isa : { scanner_isa::SCALAR, scanner_isa::SSE2, scanner_isa::AVX2 }) {
+            if (is_scanner_isa_supported(isa) && split_symbol_namespaces(name, isa) != expected) return false;
+        }
+
+        return true;
+    };
+
+
+    for (const auto& name : names) {
+        if (!check(name)) return name;
+    }
+
+    for (std::size_t i = 0; i < random_names; ++i) {
+        random_name.resize(random() % 300);
+        for (auto& c : random_name) c = alphabet[random() % alphabet.size()];
+
+        if (!check(random_name)) return random_name;
+    }
+
+    return std::nullopt;
+}
+
+
+// Checks that the rules in rule_tables.cpp (generated by -emit-matcher and compiled into the benchmarks) match the same names as std::regex_match,
+// both when loaded from the tables and when compiled from their patterns at runtime. The names are those of the corpus and random names made of
+// fragments that occur in the patterns. Returns a description of the first name on which they disagree.
+static std::optional<std::string> verify_rule_tables(const precompiled_rules& tables, const std::vector<std::string>& names, std::size_t random_names, std::uint64_t seed) {
+    constexpr std::array fragments { "ve"sv, "::"sv, "symgen"sv, "detail"sv, "impl"sv, "meta"sv, "vertex_layout"sv, "<"sv, ">"sv, "_"sv, "#"sv, "0"sv, "42"sv, "a"sv, "f"sv, " "sv };
+
+    constexpr std::array rule_sets {
+        std::pair { &precompiled_rules::include,       "y"sv  },
+        std::pair { &precompiled_rules::exclude,       "n"sv  },
+        std::pair { &precompiled_rules::force_include, "yo"sv },
+        std::pair { &precompiled_rules::force_exclude, "no"sv }
+    };
+
+
+    std::mt19937_64 random { seed };
+
+    std::vector<std::string> random_names_list;
+    for (std::size_t i = 0; i < random_names; ++i) {
+        auto& name = random_names_list.emplace_back();
+        for (auto count = random() % 12; count > 0; --count) name += fragments[random() % fragments.size()];
+    }
+
+
+    for (const auto& [field, argument] : rule_sets) {
+        const auto& set = tables.*field;
+
+        const std::vector<std::string> patterns { set.patterns.begin(), set.patterns.end() };
+        const rule_engine loaded { set }, compiled { patterns };
+
+        std::vector<std::regex> regexes;
+        for (const auto& pattern : patterns) regexes.emplace_back(pattern);
+
+
+        for (const auto* list : { &names, &std::as_const(random_names_list) }) {
+            for (const auto& name : *list) {
+                std::optional<std::size_t> expected;
+
+                for (const auto& [i, rgx] : regexes | views::enumerate) {
+                    if (std::regex_match(name, rgx)) {
+                        expected = (std::size_t) i;
+                        break;
+                    }
+                }
+
+                for (const auto& [engine, source] : { std::pair { &loaded, "precompiled"sv }, std::pair { &compiled, "compiled"sv } }) {
+                    if (auto verdict = engine->match(name); verdict != expected) {
+                        auto describe = [&] (const auto& index) { return index ? stream_to_string("pattern ", patterns[*index]) : std::string { "no pattern" }; };
+
+                        return stream_to_string(
+                            "The ", source, " -", argument, " rules match ", describe(verdict), " for the name \"", name, "\", whereas std::regex_match matches ", describe(expected), "."
+                        );
+                    }
+                }
+            }
+        }
+    }
+
+    return std::nullopt;
+}
+
+
+// Checks the demangler against the checked-in corpus of mangled names and the names they are expected to demangle to.
+// The expected names were derived from llvm-undname rather than generated with DbgHelp (see the corpus), so on other platforms this does not prove agreement with DbgHelp.
+// On Windows, where demangle_symbol uses DbgHelp, the expected names are checked against DbgHelp as well.
+// Returns a description of the first name that is not demangled as expected.
+static std::optional<std::string> verify_demangler(const fs::path& corpus_path) {
+    std::ifstream corpus { corpus_path };
+    if (!corpus) return stream_to_string("Failed to open the demangler corpus ", corpus_path, ".");
+
+
+    std::string line;
+
+    while (std::getline(corpus, line)) {
+        if (line.empty() || line.starts_with('#')) continue;
+
+        // Names without an expected result must be rejected by the demangler.
+        const auto tab = line.find('\t');
+        const auto mangled = std::string_view { line }.substr(0, tab);
+        const auto expected = (tab == std::string::npos) ? std::nullopt : std::optional<std::string> { line.substr(tab + 1) };
+
+        if (auto demangled = demangle_msvc_name(mangled); demangled != expected) {
+            return stream_to_string(
+                "The demangler produced ", demangled.value_or("no result"), " for ", mangled, ", rather than ", expected.value_or("no result"), "."
+            );
+        }
+
+        #ifdef _WIN32
+            if (auto undecorated = demangle_symbol(mangled); expected && undecorated != *expected) {
+                return stream_to_string("DbgHelp produced ", undecorated, " for ", mangled, ", rather than the expected ", *expected, ".");
+            }
+        #endif
+    }
+
+    return std::nullopt;
+}
+
+
+#ifdef _WIN32
+    // Checks the built-in demangler against DbgHelp, which demangle_symbol uses on Windows, for every name it supports.
+    // Returns the first name they demangle differently.
+    static std::optional<std::string> compare_demangler_with_dbghelp(const std::vector<std::string>& mangled_names, const std::vector<std::string>& demangled_names) {
+        for (std::size_t i = 0; i < mangled_names.size(); ++i) {
+            if (auto demangled = demangle_msvc_name(mangled_names[i]); demangled && *demangled != demangled_names[i]) {
+                return stream_to_string(mangled_names[i], " (", *demangled, " rather than ", demangled_names[i], ")");
+            }
+        }
+
+        return std::nullopt;
+    }
+#endif
+
+
+// Exports of a .def file in the format SymbolGenerator writes. The exports refer to the names.
+struct def_file {
+    std::string library;
+    std::vector<std::string> names;
+    std::vector<def_export> exports;
+};
+
+
+static def_file read_def_file(const fs::path& path) {
+    def_file result;
+    std::ifstream file { path };
+    std::string line;
+
+    while (std::getline(file, line)) {
+        std::istringstream tokens { line };
+        std::string name, token;
+
+        if (!(tokens >> name) || name == "EXPORTS") continue;
+
+        if (name == "LIBRARY") {
+            tokens >> result.library;
+            continue;
+        }
+
+
+        // Like lib.exe, exports without an ordinal are numbered in the order they appear in.
+        def_export entry { .name = { }, .is_data = false, .ordinal = (std::uint16_t) (result.exports.size() + 1), .has_name = true };
+
+        while (tokens >> token) {
+            if      (token == "DATA")       entry.is_data  = true;
+            else if (token == "NONAME")     entry.has_name = false;
+            else if (token.starts_with('@')) entry.ordinal = (std::uint16_t) std::stoul(token.substr(1));
+        }
+
+        result.names.push_back(std::move(name));
+        result.exports.push_back(entry);
+    }
+
+    for (std::size_t i = 0; i < result.exports.size(); ++i) result.exports[i].name = result.names[i];
+    return result;
+}
+
+
+// Members of an archive in the order they are stored, except for the linker members and the long name table,
+// and the symbols listed in the first linker member together with the index of the member that defines them.
+struct archive_contents {
+    std::vector<std::span<const std::byte>> members;
+    std::vector<std::pair<std::string, std::size_t>> symbols;
+};
+
+
+static archive_contents read_archive(std::span<const std::byte> data) {
+    archive_contents result;
+
+    std::span<const std::byte> symbol_table;
+    std::vector<std::size_t> member_offsets;
+
+    for (std::size_t offset = 8; offset + 60 <= data.size(); ) {
+        const std::string_view header { (const char*) data.data() + offset, 60 };
+        const std::string_view name = header.substr(0, header.find(' '));
+        const std::size_t size = std::stoull(std::string { header.substr(48, 10) });
+
+        const auto contents = data.subspan(offset + 60, (std::min)(size, data.size() - offset - 60));
+
+        if (name == "/") {
+            if (symbol_table.empty()) symbol_table = contents;
+        } else if (name != "//") {
+            member_offsets.push_back(offset);
+            result.members.push_back(contents);
+        }
+
+        offset += 60 + size + (size & 1);
+    }
+
+
+    // The first linker member has the same layout in the archives of lib.exe and GNU ar: a big-endian symbol count,
+    // the big-endian offsets of the members defining each symbol, and the null-terminated names of the symbols.
+    auto read_be = [&] (std::size_t offset) {
+        std::uint32_t value = 0;
+        for (std::size_t i = 0; i < 4; ++i) value = (value << 8) | (std::uint32_t) symbol_table[offset + i];
+
+        return value;
+    };
+
+    const std::size_t symbol_count = symbol_table.size() >= 4 ? read_be(0) : 0;
+    std::string_view names { (const char*) symbol_table.data() + 4 + 4 * symbol_count, symbol_table.size() - 4 - 4 * symbol_count };
+
+    for (std::size_t i = 0; i < symbol_count; ++i) {
+        const auto name = names.substr(0, names.find('\0'));
+        names.remove_prefix((std::min)(name.size() + 1, names.size()));
+
+        const auto member = std::ranges::find(member_offsets, read_be(4 + 4 * i)) - member_offsets.begin();
+        result.symbols.emplace_back(name, (std::size_t) member);
+    }
+
+    std::ranges::sort(result.symbols);
+    return result;
+}
+
+
+// Checks the import libraries written by write_import_library against the reference files in the given directory.
+// For every .def file, <name>_<machine>.lib was created from it by llvm-dlltool.
+//
+// llvm-dlltool writes the archive in the GNU format, which has no second linker member, so the members and the symbols that are defined by them
+// are compared rather than the archive as a whole. The hint of named imports is not compared either: llvm-dlltool uses the ordinal from the .def file
+// (or zero if there is none), whereas the hint written here is the index of the name in the name pointer table of the DLL, as lib.exe does.
+// Instead, the hint is checked against the position of the name among the named exports, which the name pointer table lists in lexical order.
+static std::optional<std::string> verify_import_library(const fs::path& directory, const fs::path& output_directory) {
+    constexpr std::size_t HINT_OFFSET = 16, TYPE_OFFSET = 18, NAME_OFFSET = 20;
+
+    fs::create_directories(output_directory);
+
+    for (const auto& entry : fs::directory_iterator { directory }) {
+        if (entry.path().extension() != ".def") continue;
+
+        const auto def = read_def_file(entry.path());
+
+        std::vector<std::string_view> named_exports;
+        for (const auto& e : def.exports) if (e.has_name) named_exports.push_back(e.name);
+
+        std::ranges::sort(named_exports);
+
+        for (std::string_view machine_name : { "x64", "arm64" }) {
+            const auto name = stream_to_string(entry.path().stem().string(), "_", machine_name);
+            const auto path = output_directory / (name + ".lib");
+
+            if (auto error = write_import_library(path, def.library, *parse_machine_name(machine_name), def.exports); error) return error;
+
+
+            const mapped_file expected_lib { directory / (name + ".lib") }, written_lib { path };
+            const auto expected = read_archive(expected_lib.data()), written = read_archive(written_lib.data());
+
+            if (expected.symbols != written.symbols) return stream_to_string("The import library ", name, ".lib defines different symbols than the reference file.");
+            if (expected.members.size() != written.members.size()) return stream_to_string("The import library ", name, ".lib has a different number of members than the reference file.");
+
+            for (const auto& [i, member] : written.members | views::enumerate) {
+                const auto& reference = expected.members[i];
+                if (member.size() != reference.size()) return stream_to_string("Member ", i, " of the import library ", name, ".lib differs from the reference file.");
+
+                // Import objects (which start with an anonymous object header) that are imported by name have a hint.
+                const bool has_hint =
+                    member.size() > TYPE_OFFSET + 1 && read_le<std::uint16_t>(member, 2) == 0xFFFF &&
+                    (read_le<std::uint16_t>(member, TYPE_OFFSET) >> 2 & 0x7) != 0;
+
+                if (has_hint) {
+                    std::string_view symbol { (const char*) member.data() + NAME_OFFSET, member.size() - NAME_OFFSET };
+                    symbol = symbol.substr(0, symbol.find('\0'));
+
+                    const auto it = std::ranges::lower_bound(named_exports, symbol);
+
+                    if (it == named_exports.end() || *it != symbol || read_le<std::uint16_t>(member, HINT_OFFSET) != (std::uint16_t) (it - named_exports.begin())) {
+                        return stream_to_string("Member ", i, " of the import library ", name, ".lib does not have the index of ", symbol, " in the name pointer table as its hint.");
+                    }
+                }
+
+                for (std::size_t offset = 0; offset < member.size(); ++offset) {
+                    if (has_hint && (offset == HINT_OFFSET || offset == HINT_OFFSET + 1)) continue;
+
+                    if (member[offset] != reference[offset]) {
+                        return stream_to_string("Member ", i, " of the import library ", name, ".lib differs from the reference file at offset ", offset, ".");
+                    }
+                }
+            }
+        }
+    }
+
+    return std::nullopt;
+}
+
+
+int main(int argc, char** argv) {
+    std::vector<std::string> args { argv + 1, argv + argc };
+
+    auto& arg_parser = argument_parser::instance();
+    auto& log        = logger::instance();
+
+    arg_parser.add_arguments(args);
+
+
+    corpus_settings settings;
+    auto get_setting = [&] (std::string_view key, auto& value) {
+        if (auto arg = arg_parser.get_argument<long long>(key); arg) value = (std::remove_reference_t<decltype(value)>) *arg;
+    };
+
+    get_setting("objects",       settings.object_count);
+    get_setting("symbols",       settings.symbols_per_object);
+    get_setting("nsdepth",       settings.namespace_depth);
+    get_setting("templatedepth", settings.template_depth);
+    get_setting("templates",     settings.template_percentage);
+    get_setting("duplicates",    settings.duplicate_percentage);
+    get_setting("data",          settings.data_percentage);
+    get_setting("seed",          settings.seed);
+
+    const fs::path corpus_path   = fs::absolute(arg_parser.get_argument<std::string>("corpus").value_or("benchmark_corpus"));
+    const fs::path refdata_path  = arg_parser.get_argument<std::string>("refdata").value_or(SYMGEN_BENCHMARK_DATA);
+    const auto min_time          = std::chrono::milliseconds { arg_parser.get_argument<long long>("time").value_or(1000) };
+    const std::size_t max_concurrency = arg_parser.get_argument<long long>("j").value_or(std::thread::hardware_concurrency());
+
+    benchmark_runner runner { min_time, arg_parser.get_argument<std::string>("filter").value_or("") };
+
+
+    // Make sure the demangler produces the expected names before measuring it.
+    if (auto error = verify_demangler(refdata_path / "demangler_corpus.txt"); error) {
+        log.error(*error);
+        return 1;
+    }
+
+    log.normal("Demangler agrees with the corpus in ", refdata_path, ".");
+
+
+    // Likewise for the import libraries, which are written to a temporary directory.
+    const fs::path import_library_path = fs::temp_directory_path() / "symgen_benchmark_import_library";
+    const auto import_library_error = verify_import_library(refdata_path / "import_library", import_library_path);
+
+    fs::remove_all(import_library_path);
+
+    if (import_library_error) {
+        log.error(*import_library_error);
+        return 1;
+    }
+
+    log.normal("Import libraries agree with the reference files in ", refdata_path / "import_library", ".");
+
+
+    // Generate the corpus.
+    auto corpus = corpus_generator { settings }.generate(corpus_path);
+
+    log.normal(
+        "Generated ", corpus.objects.size(), " objects with ", corpus.symbol_count, " symbols (", corpus.byte_count, " bytes) in ", corpus_path, "."
+    );
+
+
+    // Keep all objects in memory, so the benchmarks of individual stages do not depend on the disk.
+    std::vector<mapped_file> objects;
+    for (const auto& path : corpus.objects) objects.emplace_back(path);
+
+    std::vector<std::string> mangled_names, demangled_names;
+    std::size_t mangled_bytes = 0, demangled_bytes = 0;
+
+    for (const auto& object : objects) {
+        for (const auto& sym : coff_reader { object.data() }) {
+            if (mangled_names.size() == MAX_SAMPLE_SIZE) break;
+
+            mangled_names.emplace_back(sym.name);
+            mangled_bytes += sym.name.size();
+        }
+    }
+
+    for (const auto& name : mangled_names) {
+        demangled_names.push_back(demangle_symbol(name));
+        demangled_bytes += demangled_names.back().size();
+    }
+
+    log.normal("Example symbol: ", mangled_names.front(), " => ", demangled_names.front());
+
+    #ifdef _WIN32
+        if (auto name = compare_demangler_with_dbghelp(mangled_names, demangled_names); name) {
+            log.error("The built-in demangler and DbgHelp disagree on the symbol ", *name, ".");
+            return 1;
+        }
+
+        log.normal("The built-in demangler agrees with DbgHelp on ", mangled_names.size(), " names.");
+    #endif
+
+
+    // Make sure all variants of the namespace splitter produce the same results before measuring them.
+    const std::size_t fuzz_count = arg_parser.get_argument<long long>("fuzz").value_or(100'000);
+
+    if (auto name = verify_namespace_splitter(demangled_names, fuzz_count, settings.seed); name) {
+        log.error("Namespace splitters disagree on the symbol ", *name, ".");
+        return 1;
+    }
+
+    log.normal("Namespace splitters agree on ", demangled_names.size() + fuzz_count, " names (using ", scanner_isa_names[(std::size_t) get_scanner_isa()], ").");
+
+
+    // Likewise for the rule tables generated by -emit-matcher, which rule_tables.cpp registers when the benchmarks start.
+    // They are unregistered afterwards, since the end-to-end runs use different rules, which would otherwise print a warning.
+    const auto* rule_tables = precompiled_rules::registered();
+    log.assert_that(rule_tables != nullptr, "rule_tables.cpp was not compiled into the benchmarks.");
+
+    if (auto error = verify_rule_tables(*rule_tables, demangled_names, fuzz_count, settings.seed); error) {
+        log.error(*error);
+        return 1;
+    }
+
+    precompiled_rules::registered() = nullptr;
+    log.normal("Precompiled rule tables agree with std::regex_match on ", demangled_names.size() + fuzz_count, " names.");
+
+
+    // Benchmarks of individual stages.
+    runner.run("coff_reader", corpus.symbol_count, corpus.byte_count, [&] {
+        std::size_t total = 0;
+
+        for (const auto& object : objects) {
+            for (const auto& sym : coff_reader { object.data() }) total += sym.name.size();
+        }
+
+        keep_alive(total);
+    });
+
+    runner.run("demangle_symbol", mangled_names.size(), mangled_bytes, [&] {
+        std::size_t total = 0;
+        for (const auto& name : mangled_names) total += demangle_symbol(name).size();
+
+        keep_alive(total);
+    });
+
+    runner.run("split_symbol_namespaces (reference)", demangled_names.size(), demangled_bytes, [&] {
+        std::size_t total = 0;
+        for (const auto& name : demangled_names) total += split_symbol_namespaces_reference(name).size();
+
+        keep_alive(total);
+    });
+
+    for (auto isa : { scanner_isa::SCALAR, scanner_isa::SSE2, scanner_isa::AVX2 }) {
+        if (!is_scanner_isa_supported(isa)) continue;
+
+        runner.run(stream_to_string("split_symbol_namespaces (", scanner_isa_names[(std::size_t) isa], ")"), demangled_names.size(), demangled_bytes, [&] {
+            std::size_t total = 0;
+            for (const auto& name : demangled_names) total += split_symbol_namespaces(name, isa).size();
+
+            keep_alive(total);
+        });
+    }
+
+
+    std::vector<std::pair<std::string_view, symbol_state>> symbol_states;
+    for (const auto& name : mangled_names) symbol_states.emplace_back(name, symbol_state::FUNCTION);
+
+    const hash_map<std::string, std::string> cache_settings { { "y", "bench" } };
+    const auto serialized_cache = object_cache::serialize({ }, cache_settings, symbol_states);
+
+    runner.run("object_cache::serialize", symbol_states.size(), serialized_cache.size(), [&] {
+        keep_alive(object_cache::serialize({ }, cache_settings, symbol_states).size());
+    });
+
+    runner.run("object_cache::find", mangled_names.size(), mangled_bytes, [&] {
+        object_cache cache { serialized_cache };
+        std::size_t found = 0;
+
+        for (const auto& name : mangled_names) found += cache.find(name).has_value();
+
+        keep_alive(found);
+    });
+
+
+    // End-to-end runs over the whole corpus. SymbolGenerator's own output is silenced, so only the results are printed.
+    // Every run starts from a fresh export_generator, and unless stated otherwise, without any known symbols or namespaces, like a new process would.
+    // Only the interned names stay in the string pool, since they must remain valid for as long as the program runs, and the rules stay compiled.
+    arg_parser.add_arguments(std::vector<std::string> { "-i", corpus_path.string(), "-y", "bench" });
+    log.set_level(logger::WARNING);
+
+    auto run_generator = [&] {
+        export_generator generator { corpus_path, max_concurrency };
+        generator.update();
+
+        keep_alive(generator.get_symbol_count());
+    };
+
+    auto clear_registry = [] {
+        symbol_registry::instance().clear();
+        namespace_cache::instance().clear();
+    };
+
+
+    remove_caches(corpus_path);
+
+    runner.run("end_to_end",                  corpus.symbol_count, corpus.byte_count, clear_registry, run_generator);
+    runner.run("end_to_end (known symbols)",  corpus.symbol_count, corpus.byte_count, run_generator);
+
+
+    // Settings cannot be removed once added, so all benchmarks with caching enabled have to run last.
+    arg_parser.add_arguments(std::vector<std::string> { "-cache" });
+
+    runner.run("end_to_end -cache (writing)", corpus.symbol_count, corpus.byte_count, [&] { clear_registry(); remove_caches(corpus_path); }, run_generator);
+    runner.run("end_to_end -cache (reading)", corpus.symbol_count, corpus.byte_count, clear_registry, run_generator);
+
+    remove_caches(corpus_path);
+
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,986 @@
+// Generated by SymbolGenerator -emit-matcher. Do not edit, rerun SymbolGenerator with the new rules instead.
+// Generated from the following rules:
+//  -y ve ve::.* symgen::[a-z_]+::.*
+//  -n .*detail.* .*impl.* meta .*\bmeta\b.* (\w+)::\1 .*<[^<>]{3,8}>.*
+//  -yo .*vertex_layout.* .*(_[0-9]{2,4}|#).*
+//  -no .*_.{5} .*:.{5} .*[a-d].[e-h]..[0-3].*
+#include <SymbolGenerator/rule_engine.hpp>
+
+
+namespace {
+    using namespace std::string_view_literals;
+
+
+    constexpr std::string_view rules_y_patterns[] = {
+        "ve"sv,
+        "ve::.*"sv,
+        "symgen::[a-z_]+::.*"sv,
+    };
+
+    constexpr std::uint8_t rules_y_0_classes[] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3,
+        0, 3, 3, 3, 3, 4, 3, 5, 3, 3, 3, 3, 3, 6, 7, 3,
+        3, 3, 3, 8, 3, 3, 9, 3, 3, 10, 3, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    };
+
+    constexpr std::uint32_t rules_y_0_transitions[] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 2, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        4, 0, 0, 0, 0, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 6, 0, 0, 0, 0, 0, 0, 7, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 8, 0, 0, 0, 0, 0, 0, 0, 9,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 10, 0, 0, 0,
+        0, 0, 0, 9, 0, 9, 9, 9, 9, 9, 9, 9, 9, 9, 0, 0,
+        0, 0, 0, 0, 0, 11, 0, 0, 0, 0, 0, 12, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 13, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 14, 14, 14, 14, 14, 14, 14, 14, 0, 0, 15, 14, 14, 14,
+        14, 14, 14, 14, 14, 0, 0, 16, 0, 0, 0, 0, 0, 0, 0, 0,
+        16, 0, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+    };
+
+    constexpr std::uint32_t rules_y_0_accepts[] = {
+        4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 0, 4294967295, 4294967295, 4294967295, 1, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295,
+        2,
+    };
+
+    constexpr symgen::precompiled_automaton rules_y_automata[] = {
+        symgen::precompiled_automaton { rules_y_0_classes, 11, rules_y_0_transitions, rules_y_0_accepts },
+    };
+
+    constexpr symgen::precompiled_rule_set rules_y {
+        std::span { rules_y_patterns }.first(3),
+        rules_y_automata,
+        { }
+    };
+
+
+    constexpr std::string_view rules_n_patterns[] = {
+        ".*detail.*"sv,
+        ".*impl.*"sv,
+        "meta"sv,
+        ".*\\bmeta\\b.*"sv,
+        "(\\w+)::\\1"sv,
+        ".*<[^<>]{3,8}>.*"sv,
+    };
+
+    constexpr std::uint8_t rules_n_0_classes[] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 4, 0, 0, 5, 6, 0, 0, 0, 7, 0, 0, 8, 9, 0, 0,
+        10, 0, 0, 0, 11, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    };
+
+    constexpr std::uint32_t rules_n_0_transitions[] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 2,
+        2, 4, 2, 5, 2, 6, 2, 2, 2, 0, 3, 2, 2, 4, 2, 5,
+        2, 2, 2, 2, 7, 8, 3, 2, 7, 9, 7, 10, 7, 7, 7, 7,
+        2, 0, 3, 2, 2, 4, 11, 5, 2, 2, 2, 2, 2, 0, 3, 2,
+        2, 4, 2, 5, 2, 12, 2, 2, 2, 0, 3, 2, 2, 4, 13, 5,
+        2, 2, 2, 2, 14, 15, 3, 2, 14, 16, 14, 17, 14, 14, 14, 14,
+        15, 15, 0, 0, 15, 15, 15, 15, 15, 15, 15, 15, 14, 15, 3, 2,
+        14, 16, 18, 17, 14, 14, 14, 14, 14, 15, 3, 2, 14, 16, 14, 17,
+        14, 19, 14, 14, 2, 0, 3, 2, 2, 4, 2, 5, 2, 2, 2, 20,
+        2, 0, 3, 2, 2, 4, 2, 5, 2, 2, 21, 2, 2, 0, 3, 2,
+        2, 4, 2, 5, 2, 2, 2, 22, 23, 24, 3, 2, 23, 25, 23, 26,
+        23, 23, 23, 23, 24, 24, 0, 0, 24, 24, 24, 24, 24, 24, 24, 24,
+        23, 24, 3, 2, 23, 25, 27, 26, 23, 23, 23, 23, 23, 24, 3, 2,
+        23, 25, 23, 26, 23, 28, 23, 23, 23, 24, 3, 2, 23, 25, 23, 26,
+        23, 23, 23, 29, 23, 24, 3, 2, 23, 25, 23, 26, 23, 23, 30, 23,
+        2, 0, 3, 2, 31, 4, 2, 5, 2, 2, 2, 2, 2, 0, 3, 2,
+        2, 4, 2, 5, 32, 2, 2, 2, 2, 0, 3, 2, 33, 4, 2, 5,
+        2, 2, 2, 2, 34, 35, 3, 36, 34, 37, 34, 38, 34, 34, 34, 34,
+        35, 35, 0, 39, 35, 35, 35, 35, 35, 35, 35, 35, 34, 35, 3, 36,
+        34, 37, 40, 38, 34, 34, 34, 34, 34, 35, 3, 36, 34, 37, 34, 38,
+        34, 41, 34, 34, 34, 35, 3, 36, 34, 37, 34, 38, 34, 34, 34, 42,
+        34, 35, 3, 36, 34, 37, 34, 38, 34, 34, 43, 34, 34, 35, 3, 36,
+        44, 37, 34, 38, 34, 34, 34, 34, 34, 35, 3, 36, 34, 37, 34, 38,
+        45, 34, 34, 34, 2, 0, 3, 2, 2, 4, 2, 46, 2, 2, 2, 2,
+        32, 0, 47, 32, 32, 48, 32, 49, 32, 32, 32, 32, 2, 0, 3, 2,
+        2, 4, 2, 5, 2, 2, 2, 2, 50, 51, 3, 36, 50, 52, 50, 53,
+        50, 50, 50, 50, 51, 51, 0, 39, 51, 51, 51, 51, 51, 51, 51, 51,
+        36, 0, 54, 36, 36, 55, 36, 56, 36, 36, 36, 36, 50, 51, 3, 36,
+        50, 52, 57, 53, 50, 50, 50, 50, 50, 51, 3, 36, 50, 52, 50, 53,
+        50, 58, 50, 50, 39, 0, 39, 39, 39, 39, 39, 39, 39, 39, 39, 39,
+        50, 51, 3, 36, 50, 52, 50, 53, 50, 50, 50, 59, 50, 51, 3, 36,
+        50, 52, 50, 53, 50, 50, 60, 50, 50, 51, 3, 36, 61, 52, 50, 53,
+        50, 50, 50, 50, 50, 51, 3, 36, 50, 52, 50, 53, 62, 50, 50, 50,
+        50, 51, 3, 36, 50, 52, 50, 63, 50, 50, 50, 50, 62, 51, 47, 64,
+        62, 65, 62, 66, 62, 62, 62, 62, 2, 0, 3, 2, 2, 4, 2, 5,
+        67, 12, 2, 2, 68, 8, 47, 32, 68, 69, 68, 70, 68, 68, 68, 68,
+        32, 0, 47, 32, 32, 48, 71, 49, 32, 32, 32, 32, 32, 0, 47, 32,
+        32, 48, 32, 49, 32, 72, 32, 32, 73, 74, 3, 36, 73, 75, 73, 76,
+        73, 73, 73, 73, 74, 74, 0, 39, 74, 74, 74, 74, 74, 74, 74, 74,
+        73, 74, 3, 36, 73, 75, 77, 76, 73, 73, 73, 73, 73, 74, 3, 36,
+        73, 75, 73, 76, 73, 78, 73, 73, 79, 8, 54, 36, 79, 80, 79, 81,
+        79, 79, 79, 79, 36, 0, 54, 36, 36, 55, 82, 56, 36, 36, 36, 36,
+        36, 0, 54, 36, 36, 55, 36, 56, 36, 83, 36, 36, 73, 74, 3, 36,
+        73, 75, 73, 76, 73, 73, 73, 84, 73, 74, 3, 36, 73, 75, 73, 76,
+        73, 73, 85, 73, 73, 74, 3, 36, 86, 75, 73, 76, 73, 73, 73, 73,
+        73, 74, 3, 36, 73, 75, 73, 76, 87, 73, 73, 73, 73, 74, 3, 36,
+        73, 75, 73, 88, 73, 73, 73, 73, 87, 74, 47, 64, 87, 89, 87, 90,
+        87, 87, 87, 87, 73, 74, 3, 36, 73, 75, 73, 76, 91, 78, 73, 73,
+        64, 0, 92, 64, 64, 93, 64, 94, 64, 64, 64, 64, 87, 74, 47, 64,
+        87, 89, 95, 90, 87, 87, 87, 87, 87, 74, 47, 64, 87, 89, 87, 90,
+        87, 96, 87, 87, 67, 0, 97, 67, 67, 98, 67, 99, 67, 67, 67, 67,
+        100, 15, 47, 32, 100, 101, 100, 102, 100, 100, 100, 100, 100, 15, 47, 32,
+        100, 101, 103, 102, 100, 100, 100, 100, 100, 15, 47, 32, 100, 101, 100, 102,
+        100, 104, 100, 100, 32, 0, 47, 32, 32, 48, 32, 49, 32, 32, 32, 105,
+        32, 0, 47, 32, 32, 48, 32, 49, 32, 32, 106, 32, 107, 108, 3, 36,
+        107, 109, 107, 110, 107, 107, 107, 107, 108, 108, 0, 39, 108, 108, 108, 108,
+        108, 108, 108, 108, 107, 108, 3, 36, 107, 109, 111, 110, 107, 107, 107, 107,
+        107, 108, 3, 36, 107, 109, 107, 110, 107, 112, 107, 107, 107, 108, 3, 36,
+        107, 109, 107, 110, 107, 107, 107, 113, 107, 108, 3, 36, 107, 109, 107, 110,
+        107, 107, 114, 107, 115, 15, 54, 36, 115, 116, 115, 117, 115, 115, 115, 115,
+        115, 15, 54, 36, 115, 116, 118, 117, 115, 115, 115, 115, 115, 15, 54, 36,
+        115, 116, 115, 117, 115, 119, 115, 115, 36, 0, 54, 36, 36, 55, 36, 56,
+        36, 36, 36, 120, 36, 0, 54, 36, 36, 55, 36, 56, 36, 36, 121, 36,
+        107, 108, 3, 36, 122, 109, 107, 110, 107, 107, 107, 107, 107, 108, 3, 36,
+        107, 109, 107, 110, 123, 107, 107, 107, 107, 108, 3, 36, 107, 109, 107, 124,
+        107, 107, 107, 107, 123, 108, 47, 64, 123, 125, 123, 126, 123, 123, 123, 123,
+        107, 108, 3, 36, 107, 109, 107, 110, 127, 112, 107, 107, 123, 108, 47, 64,
+        123, 125, 128, 126, 123, 123, 123, 123, 123, 108, 47, 64, 123, 125, 123, 126,
+        123, 129, 123, 123, 127, 108, 97, 130, 127, 131, 127, 132, 127, 127, 127, 127,
+        133, 8, 92, 64, 133, 134, 133, 135, 133, 133, 133, 133, 64, 0, 92, 64,
+        64, 93, 136, 94, 64, 64, 64, 64, 64, 0, 92, 64, 64, 93, 64, 94,
+        64, 137, 64, 64, 123, 108, 47, 64, 123, 125, 123, 126, 123, 123, 123, 138,
+        123, 108, 47, 64, 123, 125, 123, 126, 123, 123, 139, 123, 140, 8, 97, 67,
+        140, 141, 140, 142, 140, 140, 140, 140, 67, 0, 97, 67, 67, 98, 143, 99,
+        67, 67, 67, 67, 67, 0, 97, 67, 67, 98, 67, 99, 67, 144, 67, 67,
+        145, 24, 47, 32, 145, 146, 145, 147, 145, 145, 145, 145, 145, 24, 47, 32,
+        145, 146, 148, 147, 145, 145, 145, 145, 145, 24, 47, 32, 145, 146, 145, 147,
+        145, 149, 145, 145, 145, 24, 47, 32, 145, 146, 145, 147, 145, 145, 145, 150,
+        145, 24, 47, 32, 145, 146, 145, 147, 145, 145, 151, 145, 32, 0, 47, 32,
+        152, 48, 32, 49, 32, 32, 32, 32, 32, 0, 47, 32, 32, 48, 32, 49,
+        32, 32, 32, 32, 153, 154, 3, 36, 153, 155, 153, 156, 153, 153, 153, 153,
+        154, 154, 0, 39, 154, 154, 154, 154, 154, 154, 154, 154, 153, 154, 3, 36,
+        153, 155, 157, 156, 153, 153, 153, 153, 153, 154, 3, 36, 153, 155, 153, 156,
+        153, 158, 153, 153, 153, 154, 3, 36, 153, 155, 153, 156, 153, 153, 153, 159,
+        153, 154, 3, 36, 153, 155, 153, 156, 153, 153, 160, 153, 153, 154, 3, 36,
+        161, 155, 153, 156, 153, 153, 153, 153, 153, 154, 3, 36, 153, 155, 153, 156,
+        162, 153, 153, 153, 163, 24, 54, 36, 163, 164, 163, 165, 163, 163, 163, 163,
+        163, 24, 54, 36, 163, 164, 166, 165, 163, 163, 163, 163, 163, 24, 54, 36,
+        163, 164, 163, 165, 163, 167, 163, 163, 163, 24, 54, 36, 163, 164, 163, 165,
+        163, 163, 163, 168, 163, 24, 54, 36, 163, 164, 163, 165, 163, 163, 169, 163,
+        36, 0, 54, 36, 170, 55, 36, 56, 36, 36, 36, 36, 36, 0, 54, 36,
+        36, 55, 36, 56, 64, 36, 36, 36, 153, 154, 3, 36, 153, 155, 153, 171,
+        153, 153, 153, 153, 162, 154, 47, 64, 162, 172, 162, 173, 162, 162, 162, 162,
+        153, 154, 3, 36, 153, 155, 153, 156, 174, 158, 153, 153, 162, 154, 47, 64,
+        162, 172, 175, 173, 162, 162, 162, 162, 162, 154, 47, 64, 162, 172, 162, 173,
+        162, 176, 162, 162, 174, 154, 97, 130, 174, 177, 174, 178, 174, 174, 174, 174,
+        162, 154, 47, 64, 162, 172, 162, 173, 162, 162, 162, 179, 162, 154, 47, 64,
+        162, 172, 162, 173, 162, 162, 180, 162, 130, 0, 181, 130, 130, 182, 130, 183,
+        130, 130, 130, 130, 174, 154, 97, 130, 174, 177, 184, 178, 174, 174, 174, 174,
+        174, 154, 97, 130, 174, 177, 174, 178, 174, 185, 174, 174, 186, 15, 92, 64,
+        186, 187, 186, 188, 186, 186, 186, 186, 186, 15, 92, 64, 186, 187, 189, 188,
+        186, 186, 186, 186, 186, 15, 92, 64, 186, 187, 186, 188, 186, 190, 186, 186,
+        64, 0, 92, 64, 64, 93, 64, 94, 64, 64, 64, 191, 64, 0, 92, 64,
+        64, 93, 64, 94, 64, 64, 192, 64, 162, 154, 47, 64, 193, 172, 162, 173,
+        162, 162, 162, 162, 162, 154, 47, 64, 162, 172, 162, 173, 162, 162, 162, 162,
+        194, 15, 97, 67, 194, 195, 194, 196, 194, 194, 194, 194, 194, 15, 97, 67,
+        194, 195, 197, 196, 194, 194, 194, 194, 194, 15, 97, 67, 194, 195, 194, 196,
+        194, 198, 194, 194, 67, 0, 97, 67, 67, 98, 67, 99, 67, 67, 67, 199,
+        67, 0, 97, 67, 67, 98, 67, 99, 67, 67, 200, 67, 45, 35, 47, 64,
+        45, 201, 45, 202, 45, 45, 45, 45, 45, 35, 47, 64, 45, 201, 203, 202,
+        45, 45, 45, 45, 45, 35, 47, 64, 45, 201, 45, 202, 45, 204, 45, 45,
+        45, 35, 47, 64, 45, 201, 45, 202, 45, 45, 45, 205, 45, 35, 47, 64,
+        45, 201, 45, 202, 45, 45, 206, 45, 45, 35, 47, 64, 207, 201, 45, 202,
+        45, 45, 45, 45, 45, 35, 47, 64, 45, 201, 45, 202, 45, 45, 45, 45,
+        32, 0, 47, 32, 32, 48, 32, 208, 32, 32, 32, 32, 2, 0, 3, 36,
+        2, 4, 2, 5, 2, 2, 2, 2, 0, 0, 0, 39, 0, 0, 0, 0,
+        0, 0, 0, 0, 2, 0, 3, 36, 2, 4, 11, 5, 2, 2, 2, 2,
+        2, 0, 3, 36, 2, 4, 2, 5, 2, 12, 2, 2, 2, 0, 3, 36,
+        2, 4, 2, 5, 2, 2, 2, 20, 2, 0, 3, 36, 2, 4, 2, 5,
+        2, 2, 21, 2, 2, 0, 3, 36, 31, 4, 2, 5, 2, 2, 2, 2,
+        2, 0, 3, 36, 2, 4, 2, 5, 32, 2, 2, 2, 2, 0, 3, 36,
+        2, 4, 2, 46, 2, 2, 2, 2, 32, 0, 47, 64, 32, 48, 32, 49,
+        32, 32, 32, 32, 209, 35, 54, 36, 209, 210, 209, 211, 209, 209, 209, 209,
+        209, 35, 54, 36, 209, 210, 212, 211, 209, 209, 209, 209, 209, 35, 54, 36,
+        209, 210, 209, 211, 209, 213, 209, 209, 209, 35, 54, 36, 209, 210, 209, 211,
+        209, 209, 209, 214, 209, 35, 54, 36, 209, 210, 209, 211, 209, 209, 215, 209,
+        209, 35, 54, 36, 216, 210, 209, 211, 209, 209, 209, 209, 209, 35, 54, 36,
+        209, 210, 209, 211, 217, 209, 209, 209, 36, 0, 54, 36, 36, 55, 36, 218,
+        36, 36, 36, 36, 2, 0, 3, 36, 2, 4, 2, 5, 67, 12, 2, 2,
+        32, 0, 47, 64, 32, 48, 71, 49, 32, 32, 32, 32, 32, 0, 47, 64,
+        32, 48, 32, 49, 32, 72, 32, 32, 67, 0, 97, 130, 67, 98, 67, 99,
+        67, 67, 67, 67, 32, 0, 47, 64, 32, 48, 32, 49, 32, 32, 32, 105,
+        32, 0, 47, 64, 32, 48, 32, 49, 32, 32, 106, 32, 67, 0, 97, 130,
+        67, 98, 143, 99, 67, 67, 67, 67, 67, 0, 97, 130, 67, 98, 67, 99,
+        67, 144, 67, 67, 32, 0, 47, 64, 152, 48, 32, 49, 32, 32, 32, 32,
+        32, 0, 47, 64, 32, 48, 32, 49, 32, 32, 32, 32, 219, 8, 181, 130,
+        219, 220, 219, 221, 219, 219, 219, 219, 130, 0, 181, 130, 130, 182, 222, 183,
+        130, 130, 130, 130, 130, 0, 181, 130, 130, 182, 130, 183, 130, 223, 130, 130,
+        67, 0, 97, 130, 67, 98, 67, 99, 67, 67, 67, 199, 67, 0, 97, 130,
+        67, 98, 67, 99, 67, 67, 200, 67, 224, 24, 92, 64, 224, 225, 224, 226,
+        224, 224, 224, 224, 224, 24, 92, 64, 224, 225, 227, 226, 224, 224, 224, 224,
+        224, 24, 92, 64, 224, 225, 224, 226, 224, 228, 224, 224, 224, 24, 92, 64,
+        224, 225, 224, 226, 224, 224, 224, 229, 224, 24, 92, 64, 224, 225, 224, 226,
+        224, 224, 230, 224, 64, 0, 92, 64, 231, 93, 64, 94, 64, 64, 64, 64,
+        64, 0, 92, 64, 64, 93, 64, 94, 64, 64, 64, 64, 32, 0, 47, 64,
+        32, 48, 32, 208, 32, 32, 32, 32, 232, 24, 97, 67, 232, 233, 232, 234,
+        232, 232, 232, 232, 232, 24, 97, 67, 232, 233, 235, 234, 232, 232, 232, 232,
+        232, 24, 97, 67, 232, 233, 232, 234, 232, 236, 232, 232, 232, 24, 97, 67,
+        232, 233, 232, 234, 232, 232, 232, 237, 232, 24, 97, 67, 232, 233, 232, 234,
+        232, 232, 238, 232, 67, 0, 97, 67, 239, 98, 67, 99, 67, 67, 67, 67,
+        67, 0, 97, 67, 67, 98, 67, 99, 240, 67, 67, 67, 62, 51, 47, 64,
+        62, 65, 241, 66, 62, 62, 62, 62, 62, 51, 47, 64, 62, 65, 62, 66,
+        62, 242, 62, 62, 62, 51, 47, 64, 62, 65, 62, 66, 62, 62, 62, 243,
+        62, 51, 47, 64, 62, 65, 62, 66, 62, 62, 244, 62, 62, 51, 47, 64,
+        245, 65, 62, 66, 62, 62, 62, 62, 62, 51, 47, 64, 62, 65, 62, 66,
+        62, 62, 62, 62, 62, 51, 47, 64, 62, 65, 62, 246, 62, 62, 62, 62,
+        32, 0, 47, 32, 32, 48, 32, 49, 240, 72, 32, 32, 247, 51, 54, 36,
+        247, 248, 247, 249, 247, 247, 247, 247, 247, 51, 54, 36, 247, 248, 250, 249,
+        247, 247, 247, 247, 247, 51, 54, 36, 247, 248, 247, 249, 247, 251, 247, 247,
+        247, 51, 54, 36, 247, 248, 247, 249, 247, 247, 247, 252, 247, 51, 54, 36,
+        247, 248, 247, 249, 247, 247, 253, 247, 247, 51, 54, 36, 254, 248, 247, 249,
+        247, 247, 247, 247, 247, 51, 54, 36, 247, 248, 247, 249, 255, 247, 247, 247,
+        247, 51, 54, 36, 247, 248, 247, 256, 247, 247, 247, 247, 255, 51, 92, 64,
+        255, 257, 255, 258, 255, 255, 255, 255, 36, 0, 54, 36, 36, 55, 36, 56,
+        130, 83, 36, 36, 259, 15, 181, 130, 259, 260, 259, 261, 259, 259, 259, 259,
+        259, 15, 181, 130, 259, 260, 262, 261, 259, 259, 259, 259, 259, 15, 181, 130,
+        259, 260, 259, 261, 259, 263, 259, 259, 130, 0, 181, 130, 130, 182, 130, 183,
+        130, 130, 130, 264, 130, 0, 181, 130, 130, 182, 130, 183, 130, 130, 265, 130,
+        217, 35, 92, 64, 217, 266, 217, 267, 217, 217, 217, 217, 217, 35, 92, 64,
+        217, 266, 268, 267, 217, 217, 217, 217, 217, 35, 92, 64, 217, 266, 217, 267,
+        217, 269, 217, 217, 217, 35, 92, 64, 217, 266, 217, 267, 217, 217, 217, 270,
+        217, 35, 92, 64, 217, 266, 217, 267, 217, 217, 271, 217, 217, 35, 92, 64,
+        272, 266, 217, 267, 217, 217, 217, 217, 217, 35, 92, 64, 217, 266, 217, 267,
+        217, 217, 217, 217, 64, 0, 92, 64, 64, 93, 64, 273, 64, 64, 64, 64,
+        274, 35, 97, 130, 274, 275, 274, 276, 274, 274, 274, 274, 274, 35, 97, 130,
+        274, 275, 277, 276, 274, 274, 274, 274, 274, 35, 97, 130, 274, 275, 274, 276,
+        274, 278, 274, 274, 274, 35, 97, 130, 274, 275, 274, 276, 274, 274, 274, 279,
+        274, 35, 97, 130, 274, 275, 274, 276, 274, 274, 280, 274, 274, 35, 97, 130,
+        281, 275, 274, 276, 274, 274, 274, 274, 274, 35, 97, 130, 274, 275, 274, 276,
+        282, 274, 274, 274, 67, 0, 97, 67, 67, 98, 67, 283, 67, 67, 67, 67,
+        240, 0, 284, 240, 240, 285, 240, 286, 240, 240, 240, 240, 87, 74, 47, 64,
+        87, 89, 87, 90, 87, 87, 87, 287, 87, 74, 47, 64, 87, 89, 87, 90,
+        87, 87, 288, 87, 87, 74, 47, 64, 289, 89, 87, 90, 87, 87, 87, 87,
+        87, 74, 47, 64, 87, 89, 87, 90, 87, 87, 87, 87, 87, 74, 47, 64,
+        87, 89, 87, 290, 87, 87, 87, 87, 87, 74, 47, 64, 87, 89, 87, 90,
+        291, 96, 87, 87, 292, 74, 54, 36, 292, 293, 292, 294, 292, 292, 292, 292,
+        292, 74, 54, 36, 292, 293, 295, 294, 292, 292, 292, 292, 292, 74, 54, 36,
+        292, 293, 292, 294, 292, 296, 292, 292, 292, 74, 54, 36, 292, 293, 292, 294,
+        292, 292, 292, 297, 292, 74, 54, 36, 292, 293, 292, 294, 292, 292, 298, 292,
+        292, 74, 54, 36, 299, 293, 292, 294, 292, 292, 292, 292, 292, 74, 54, 36,
+        292, 293, 292, 294, 300, 292, 292, 292, 292, 74, 54, 36, 292, 293, 292, 301,
+        292, 292, 292, 292, 300, 74, 92, 64, 300, 302, 300, 303, 300, 300, 300, 300,
+        292, 74, 54, 36, 292, 293, 292, 294, 304, 296, 292, 292, 300, 74, 92, 64,
+        300, 302, 305, 303, 300, 300, 300, 300, 300, 74, 92, 64, 300, 302, 300, 303,
+        300, 306, 300, 300, 307, 24, 181, 130, 307, 308, 307, 309, 307, 307, 307, 307,
+        307, 24, 181, 130, 307, 308, 310, 309, 307, 307, 307, 307, 307, 24, 181, 130,
+        307, 308, 307, 309, 307, 311, 307, 307, 307, 24, 181, 130, 307, 308, 307, 309,
+        307, 307, 307, 312, 307, 24, 181, 130, 307, 308, 307, 309, 307, 307, 313, 307,
+        130, 0, 181, 130, 314, 182, 130, 183, 130, 130, 130, 130, 130, 0, 181, 130,
+        130, 182, 130, 183, 315, 130, 130, 130, 255, 51, 92, 64, 255, 257, 316, 258,
+        255, 255, 255, 255, 255, 51, 92, 64, 255, 257, 255, 258, 255, 317, 255, 255,
+        255, 51, 92, 64, 255, 257, 255, 258, 255, 255, 255, 318, 255, 51, 92, 64,
+        255, 257, 255, 258, 255, 255, 319, 255, 255, 51, 92, 64, 320, 257, 255, 258,
+        255, 255, 255, 255, 255, 51, 92, 64, 255, 257, 255, 258, 255, 255, 255, 255,
+        255, 51, 92, 64, 255, 257, 255, 321, 255, 255, 255, 255, 64, 0, 92, 64,
+        64, 93, 64, 94, 315, 137, 64, 64, 322, 51, 97, 130, 322, 323, 322, 324,
+        322, 322, 322, 322, 322, 51, 97, 130, 322, 323, 325, 324, 322, 322, 322, 322,
+        322, 51, 97, 130, 322, 323, 322, 324, 322, 326, 322, 322, 322, 51, 97, 130,
+        322, 323, 322, 324, 322, 322, 322, 327, 322, 51, 97, 130, 322, 323, 322, 324,
+        322, 322, 328, 322, 322, 51, 97, 130, 329, 323, 322, 324, 322, 322, 322, 322,
+        322, 51, 97, 130, 322, 323, 322, 324, 330, 322, 322, 322, 322, 51, 97, 130,
+        322, 323, 322, 331, 322, 322, 322, 322, 330, 51, 284, 315, 330, 332, 330, 333,
+        330, 330, 330, 330, 67, 0, 97, 67, 67, 98, 67, 99, 67, 144, 67, 67,
+        334, 8, 284, 240, 334, 335, 334, 336, 334, 334, 334, 334, 240, 0, 284, 240,
+        240, 285, 337, 286, 240, 240, 240, 240, 240, 0, 284, 240, 240, 285, 240, 286,
+        240, 338, 240, 240, 123, 108, 47, 64, 339, 125, 123, 126, 123, 123, 123, 123,
+        123, 108, 47, 64, 123, 125, 123, 126, 123, 123, 123, 123, 123, 108, 47, 64,
+        123, 125, 123, 340, 123, 123, 123, 123, 123, 108, 47, 64, 123, 125, 123, 126,
+        341, 129, 123, 123, 341, 108, 284, 315, 341, 342, 341, 343, 341, 341, 341, 341,
+        344, 108, 54, 36, 344, 345, 344, 346, 344, 344, 344, 344, 344, 108, 54, 36,
+        344, 345, 347, 346, 344, 344, 344, 344, 344, 108, 54, 36, 344, 345, 344, 346,
+        344, 348, 344, 344, 344, 108, 54, 36, 344, 345, 344, 346, 344, 344, 344, 349,
+        344, 108, 54, 36, 344, 345, 344, 346, 344, 344, 350, 344, 344, 108, 54, 36,
+        351, 345, 344, 346, 344, 344, 344, 344, 344, 108, 54, 36, 344, 345, 344, 346,
+        352, 344, 344, 344, 344, 108, 54, 36, 344, 345, 344, 353, 344, 344, 344, 344,
+        352, 108, 92, 64, 352, 354, 352, 355, 352, 352, 352, 352, 344, 108, 54, 36,
+        344, 345, 344, 346, 356, 348, 344, 344, 352, 108, 92, 64, 352, 354, 357, 355,
+        352, 352, 352, 352, 352, 108, 92, 64, 352, 354, 352, 355, 352, 358, 352, 352,
+        356, 108, 181, 130, 356, 359, 356, 360, 356, 356, 356, 356, 352, 108, 92, 64,
+        352, 354, 352, 355, 352, 352, 352, 361, 352, 108, 92, 64, 352, 354, 352, 355,
+        352, 352, 362, 352, 363, 35, 181, 130, 363, 364, 363, 365, 363, 363, 363, 363,
+        363, 35, 181, 130, 363, 364, 366, 365, 363, 363, 363, 363, 363, 35, 181, 130,
+        363, 364, 363, 365, 363, 367, 363, 363, 363, 35, 181, 130, 363, 364, 363, 365,
+        363, 363, 363, 368, 363, 35, 181, 130, 363, 364, 363, 365, 363, 363, 369, 363,
+        363, 35, 181, 130, 370, 364, 363, 365, 363, 363, 363, 363, 363, 35, 181, 130,
+        363, 364, 363, 365, 371, 363, 363, 363, 130, 0, 181, 130, 130, 182, 130, 372,
+        130, 130, 130, 130, 315, 0, 373, 315, 315, 374, 315, 375, 315, 315, 315, 315,
+        300, 74, 92, 64, 300, 302, 300, 303, 300, 300, 300, 376, 300, 74, 92, 64,
+        300, 302, 300, 303, 300, 300, 377, 300, 300, 74, 92, 64, 378, 302, 300, 303,
+        300, 300, 300, 300, 300, 74, 92, 64, 300, 302, 300, 303, 300, 300, 300, 300,
+        300, 74, 92, 64, 300, 302, 300, 379, 300, 300, 300, 300, 300, 74, 92, 64,
+        300, 302, 300, 303, 380, 306, 300, 300, 91, 74, 97, 130, 91, 381, 91, 382,
+        91, 91, 91, 91, 91, 74, 97, 130, 91, 381, 383, 382, 91, 91, 91, 91,
+        91, 74, 97, 130, 91, 381, 91, 382, 91, 384, 91, 91, 91, 74, 97, 130,
+        91, 381, 91, 382, 91, 91, 91, 385, 91, 74, 97, 130, 91, 381, 91, 382,
+        91, 91, 386, 91, 91, 74, 97, 130, 387, 381, 91, 382, 91, 91, 91, 91,
+        91, 74, 97, 130, 91, 381, 91, 382, 291, 91, 91, 91, 91, 74, 97, 130,
+        91, 381, 91, 388, 91, 91, 91, 91, 291, 74, 284, 315, 291, 389, 291, 390,
+        291, 291, 291, 291, 91, 74, 97, 130, 91, 381, 91, 382, 91, 384, 91, 91,
+        291, 74, 284, 315, 291, 389, 391, 390, 291, 291, 291, 291, 291, 74, 284, 315,
+        291, 389, 291, 390, 291, 392, 291, 291, 393, 15, 284, 240, 393, 394, 393, 395,
+        393, 393, 393, 393, 393, 15, 284, 240, 393, 394, 396, 395, 393, 393, 393, 393,
+        393, 15, 284, 240, 393, 394, 393, 395, 393, 397, 393, 393, 240, 0, 284, 240,
+        240, 285, 240, 286, 240, 240, 240, 398, 240, 0, 284, 240, 240, 285, 240, 286,
+        240, 240, 399, 240, 162, 154, 47, 64, 162, 172, 162, 400, 162, 162, 162, 162,
+        162, 154, 47, 64, 162, 172, 162, 173, 401, 176, 162, 162, 401, 154, 284, 315,
+        401, 402, 401, 403, 401, 401, 401, 401, 401, 154, 284, 315, 401, 402, 404, 403,
+        401, 401, 401, 401, 401, 154, 284, 315, 401, 402, 401, 403, 401, 405, 401, 401,
+        406, 154, 54, 36, 406, 407, 406, 408, 406, 406, 406, 406, 406, 154, 54, 36,
+        406, 407, 409, 408, 406, 406, 406, 406, 406, 154, 54, 36, 406, 407, 406, 408,
+        406, 410, 406, 406, 406, 154, 54, 36, 406, 407, 406, 408, 406, 406, 406, 411,
+        406, 154, 54, 36, 406, 407, 406, 408, 406, 406, 412, 406, 406, 154, 54, 36,
+        413, 407, 406, 408, 406, 406, 406, 406, 406, 154, 54, 36, 406, 407, 406, 408,
+        414, 406, 406, 406, 406, 154, 54, 36, 406, 407, 406, 415, 406, 406, 406, 406,
+        414, 154, 92, 64, 414, 416, 414, 417, 414, 414, 414, 414, 406, 154, 54, 36,
+        406, 407, 406, 408, 418, 410, 406, 406, 414, 154, 92, 64, 414, 416, 419, 417,
+        414, 414, 414, 414, 414, 154, 92, 64, 414, 416, 414, 417, 414, 420, 414, 414,
+        418, 154, 181, 130, 418, 421, 418, 422, 418, 418, 418, 418, 414, 154, 92, 64,
+        414, 416, 414, 417, 414, 414, 414, 423, 414, 154, 92, 64, 414, 416, 414, 417,
+        414, 414, 424, 414, 418, 154, 181, 130, 418, 421, 425, 422, 418, 418, 418, 418,
+        418, 154, 181, 130, 418, 421, 418, 422, 418, 426, 418, 418, 414, 154, 92, 64,
+        427, 416, 414, 417, 414, 414, 414, 414, 414, 154, 92, 64, 414, 416, 414, 417,
+        414, 414, 414, 414, 428, 51, 181, 130, 428, 429, 428, 430, 428, 428, 428, 428,
+        428, 51, 181, 130, 428, 429, 431, 430, 428, 428, 428, 428, 428, 51, 181, 130,
+        428, 429, 428, 430, 428, 432, 428, 428, 428, 51, 181, 130, 428, 429, 428, 430,
+        428, 428, 428, 433, 428, 51, 181, 130, 428, 429, 428, 430, 428, 428, 434, 428,
+        428, 51, 181, 130, 435, 429, 428, 430, 428, 428, 428, 428, 428, 51, 181, 130,
+        428, 429, 428, 430, 436, 428, 428, 428, 428, 51, 181, 130, 428, 429, 428, 437,
+        428, 428, 428, 428, 436, 51, 373, 315, 436, 438, 436, 439, 436, 436, 436, 436,
+        130, 0, 181, 130, 130, 182, 130, 183, 130, 223, 130, 130, 440, 8, 373, 315,
+        440, 441, 440, 442, 440, 440, 440, 440, 315, 0, 373, 315, 315, 374, 443, 375,
+        315, 315, 315, 315, 315, 0, 373, 315, 315, 374, 315, 375, 315, 444, 315, 315,
+        352, 108, 92, 64, 445, 354, 352, 355, 352, 352, 352, 352, 352, 108, 92, 64,
+        352, 354, 352, 355, 352, 352, 352, 352, 352, 108, 92, 64, 352, 354, 352, 446,
+        352, 352, 352, 352, 352, 108, 92, 64, 352, 354, 352, 355, 447, 358, 352, 352,
+        447, 108, 373, 315, 447, 448, 447, 449, 447, 447, 447, 447, 127, 108, 97, 130,
+        127, 131, 450, 132, 127, 127, 127, 127, 127, 108, 97, 130, 127, 131, 127, 132,
+        127, 451, 127, 127, 127, 108, 97, 130, 127, 131, 127, 132, 127, 127, 127, 452,
+        127, 108, 97, 130, 127, 131, 127, 132, 127, 127, 453, 127, 127, 108, 97, 130,
+        454, 131, 127, 132, 127, 127, 127, 127, 127, 108, 97, 130, 127, 131, 127, 132,
+        341, 127, 127, 127, 127, 108, 97, 130, 127, 131, 127, 455, 127, 127, 127, 127,
+        127, 108, 97, 130, 127, 131, 127, 132, 127, 451, 127, 127, 341, 108, 284, 315,
+        341, 342, 456, 343, 341, 341, 341, 341, 341, 108, 284, 315, 341, 342, 341, 343,
+        341, 457, 341, 341, 341, 108, 284, 315, 341, 342, 341, 343, 341, 341, 341, 458,
+        341, 108, 284, 315, 341, 342, 341, 343, 341, 341, 459, 341, 460, 24, 284, 240,
+        460, 461, 460, 462, 460, 460, 460, 460, 460, 24, 284, 240, 460, 461, 463, 462,
+        460, 460, 460, 460, 460, 24, 284, 240, 460, 461, 460, 462, 460, 464, 460, 460,
+        460, 24, 284, 240, 460, 461, 460, 462, 460, 460, 460, 465, 460, 24, 284, 240,
+        460, 461, 460, 462, 460, 460, 466, 460, 240, 0, 284, 240, 467, 285, 240, 286,
+        240, 240, 240, 240, 240, 0, 284, 240, 240, 285, 240, 286, 240, 240, 240, 240,
+        32, 0, 47, 64, 32, 48, 32, 49, 240, 72, 32, 32, 240, 0, 284, 315,
+        240, 285, 240, 286, 240, 240, 240, 240, 240, 0, 284, 315, 240, 285, 337, 286,
+        240, 240, 240, 240, 240, 0, 284, 315, 240, 285, 240, 286, 240, 338, 240, 240,
+        240, 0, 284, 315, 240, 285, 240, 286, 240, 240, 240, 398, 240, 0, 284, 315,
+        240, 285, 240, 286, 240, 240, 399, 240, 36, 0, 54, 36, 36, 55, 36, 56,
+        36, 36, 36, 36, 36, 0, 54, 36, 36, 55, 82, 56, 36, 36, 36, 36,
+        36, 0, 54, 36, 36, 55, 36, 56, 36, 83, 36, 36, 36, 0, 54, 36,
+        36, 55, 36, 56, 36, 36, 36, 120, 36, 0, 54, 36, 36, 55, 36, 56,
+        36, 36, 121, 36, 36, 0, 54, 36, 170, 55, 36, 56, 36, 36, 36, 36,
+        36, 0, 54, 36, 36, 55, 36, 56, 64, 36, 36, 36, 36, 0, 54, 36,
+        36, 55, 36, 218, 36, 36, 36, 36, 64, 0, 92, 64, 64, 93, 64, 94,
+        64, 64, 64, 64, 36, 0, 54, 36, 36, 55, 36, 56, 130, 83, 36, 36,
+        64, 0, 92, 64, 64, 93, 136, 94, 64, 64, 64, 64, 64, 0, 92, 64,
+        64, 93, 64, 94, 64, 137, 64, 64, 130, 0, 181, 130, 130, 182, 130, 183,
+        130, 130, 130, 130, 64, 0, 92, 64, 64, 93, 64, 94, 64, 64, 64, 191,
+        64, 0, 92, 64, 64, 93, 64, 94, 64, 64, 192, 64, 130, 0, 181, 130,
+        130, 182, 222, 183, 130, 130, 130, 130, 130, 0, 181, 130, 130, 182, 130, 183,
+        130, 223, 130, 130, 64, 0, 92, 64, 231, 93, 64, 94, 64, 64, 64, 64,
+        64, 0, 92, 64, 64, 93, 64, 94, 64, 64, 64, 64, 130, 0, 181, 130,
+        130, 182, 130, 183, 130, 130, 130, 264, 130, 0, 181, 130, 130, 182, 130, 183,
+        130, 130, 265, 130, 64, 0, 92, 64, 64, 93, 64, 273, 64, 64, 64, 64,
+        304, 74, 181, 130, 304, 468, 304, 469, 304, 304, 304, 304, 304, 74, 181, 130,
+        304, 468, 470, 469, 304, 304, 304, 304, 304, 74, 181, 130, 304, 468, 304, 469,
+        304, 471, 304, 304, 304, 74, 181, 130, 304, 468, 304, 469, 304, 304, 304, 472,
+        304, 74, 181, 130, 304, 468, 304, 469, 304, 304, 473, 304, 304, 74, 181, 130,
+        474, 468, 304, 469, 304, 304, 304, 304, 304, 74, 181, 130, 304, 468, 304, 469,
+        380, 304, 304, 304, 304, 74, 181, 130, 304, 468, 304, 475, 304, 304, 304, 304,
+        380, 74, 373, 315, 380, 476, 380, 477, 380, 380, 380, 380, 304, 74, 181, 130,
+        304, 468, 304, 469, 304, 471, 304, 304, 380, 74, 373, 315, 380, 476, 478, 477,
+        380, 380, 380, 380, 380, 74, 373, 315, 380, 476, 380, 477, 380, 479, 380, 380,
+        480, 15, 373, 315, 480, 481, 480, 482, 480, 480, 480, 480, 480, 15, 373, 315,
+        480, 481, 483, 482, 480, 480, 480, 480, 480, 15, 373, 315, 480, 481, 480, 482,
+        480, 484, 480, 480, 315, 0, 373, 315, 315, 374, 315, 375, 315, 315, 315, 485,
+        315, 0, 373, 315, 315, 374, 315, 375, 315, 315, 486, 315, 414, 154, 92, 64,
+        414, 416, 414, 487, 414, 414, 414, 414, 414, 154, 92, 64, 414, 416, 414, 417,
+        488, 420, 414, 414, 488, 154, 373, 315, 488, 489, 488, 490, 488, 488, 488, 488,
+        488, 154, 373, 315, 488, 489, 491, 490, 488, 488, 488, 488, 488, 154, 373, 315,
+        488, 489, 488, 490, 488, 492, 488, 488, 174, 154, 97, 130, 174, 177, 174, 178,
+        174, 174, 174, 493, 174, 154, 97, 130, 174, 177, 174, 178, 174, 174, 494, 174,
+        174, 154, 97, 130, 495, 177, 174, 178, 174, 174, 174, 174, 174, 154, 97, 130,
+        174, 177, 174, 178, 401, 174, 174, 174, 174, 154, 97, 130, 174, 177, 174, 496,
+        174, 174, 174, 174, 174, 154, 97, 130, 174, 177, 174, 178, 174, 185, 174, 174,
+        401, 154, 284, 315, 401, 402, 401, 403, 401, 401, 401, 497, 401, 154, 284, 315,
+        401, 402, 401, 403, 401, 401, 498, 401, 401, 154, 284, 315, 499, 402, 401, 403,
+        401, 401, 401, 401, 401, 154, 284, 315, 401, 402, 401, 403, 401, 401, 401, 401,
+        282, 35, 284, 315, 282, 500, 282, 501, 282, 282, 282, 282, 282, 35, 284, 315,
+        282, 500, 502, 501, 282, 282, 282, 282, 282, 35, 284, 315, 282, 500, 282, 501,
+        282, 503, 282, 282, 282, 35, 284, 315, 282, 500, 282, 501, 282, 282, 282, 504,
+        282, 35, 284, 315, 282, 500, 282, 501, 282, 282, 505, 282, 282, 35, 284, 315,
+        506, 500, 282, 501, 282, 282, 282, 282, 282, 35, 284, 315, 282, 500, 282, 501,
+        282, 282, 282, 282, 240, 0, 284, 240, 240, 285, 240, 507, 240, 240, 240, 240,
+        356, 108, 181, 130, 356, 359, 508, 360, 356, 356, 356, 356, 356, 108, 181, 130,
+        356, 359, 356, 360, 356, 509, 356, 356, 356, 108, 181, 130, 356, 359, 356, 360,
+        356, 356, 356, 510, 356, 108, 181, 130, 356, 359, 356, 360, 356, 356, 511, 356,
+        356, 108, 181, 130, 512, 359, 356, 360, 356, 356, 356, 356, 356, 108, 181, 130,
+        356, 359, 356, 360, 447, 356, 356, 356, 356, 108, 181, 130, 356, 359, 356, 513,
+        356, 356, 356, 356, 356, 108, 181, 130, 356, 359, 356, 360, 356, 509, 356, 356,
+        447, 108, 373, 315, 447, 448, 514, 449, 447, 447, 447, 447, 447, 108, 373, 315,
+        447, 448, 447, 449, 447, 515, 447, 447, 447, 108, 373, 315, 447, 448, 447, 449,
+        447, 447, 447, 516, 447, 108, 373, 315, 447, 448, 447, 449, 447, 447, 517, 447,
+        518, 24, 373, 315, 518, 519, 518, 520, 518, 518, 518, 518, 518, 24, 373, 315,
+        518, 519, 521, 520, 518, 518, 518, 518, 518, 24, 373, 315, 518, 519, 518, 520,
+        518, 522, 518, 518, 518, 24, 373, 315, 518, 519, 518, 520, 518, 518, 518, 523,
+        518, 24, 373, 315, 518, 519, 518, 520, 518, 518, 524, 518, 315, 0, 373, 315,
+        525, 374, 315, 375, 315, 315, 315, 315, 315, 0, 373, 315, 315, 374, 315, 375,
+        315, 315, 315, 315, 64, 0, 92, 64, 64, 93, 64, 94, 315, 137, 64, 64,
+        315, 0, 373, 315, 315, 374, 315, 375, 315, 315, 315, 315, 315, 0, 373, 315,
+        315, 374, 443, 375, 315, 315, 315, 315, 315, 0, 373, 315, 315, 374, 315, 375,
+        315, 444, 315, 315, 315, 0, 373, 315, 315, 374, 315, 375, 315, 315, 315, 485,
+        315, 0, 373, 315, 315, 374, 315, 375, 315, 315, 486, 315, 67, 0, 97, 130,
+        239, 98, 67, 99, 67, 67, 67, 67, 67, 0, 97, 130, 67, 98, 67, 99,
+        240, 67, 67, 67, 67, 0, 97, 130, 67, 98, 67, 283, 67, 67, 67, 67,
+        67, 0, 97, 130, 67, 98, 67, 99, 67, 144, 67, 67, 240, 0, 284, 315,
+        467, 285, 240, 286, 240, 240, 240, 240, 240, 0, 284, 315, 240, 285, 240, 286,
+        240, 240, 240, 240, 240, 0, 284, 315, 240, 285, 240, 507, 240, 240, 240, 240,
+        330, 51, 284, 315, 330, 332, 526, 333, 330, 330, 330, 330, 330, 51, 284, 315,
+        330, 332, 330, 333, 330, 527, 330, 330, 330, 51, 284, 315, 330, 332, 330, 333,
+        330, 330, 330, 528, 330, 51, 284, 315, 330, 332, 330, 333, 330, 330, 529, 330,
+        330, 51, 284, 315, 530, 332, 330, 333, 330, 330, 330, 330, 330, 51, 284, 315,
+        330, 332, 330, 333, 330, 330, 330, 330, 330, 51, 284, 315, 330, 332, 330, 531,
+        330, 330, 330, 330, 240, 0, 284, 240, 240, 285, 240, 286, 240, 338, 240, 240,
+        418, 154, 181, 130, 418, 421, 418, 422, 418, 418, 418, 532, 418, 154, 181, 130,
+        418, 421, 418, 422, 418, 418, 533, 418, 418, 154, 181, 130, 534, 421, 418, 422,
+        418, 418, 418, 418, 418, 154, 181, 130, 418, 421, 418, 422, 488, 418, 418, 418,
+        418, 154, 181, 130, 418, 421, 418, 535, 418, 418, 418, 418, 418, 154, 181, 130,
+        418, 421, 418, 422, 418, 426, 418, 418, 488, 154, 373, 315, 488, 489, 488, 490,
+        488, 488, 488, 536, 488, 154, 373, 315, 488, 489, 488, 490, 488, 488, 537, 488,
+        488, 154, 373, 315, 538, 489, 488, 490, 488, 488, 488, 488, 488, 154, 373, 315,
+        488, 489, 488, 490, 488, 488, 488, 488, 371, 35, 373, 315, 371, 539, 371, 540,
+        371, 371, 371, 371, 371, 35, 373, 315, 371, 539, 541, 540, 371, 371, 371, 371,
+        371, 35, 373, 315, 371, 539, 371, 540, 371, 542, 371, 371, 371, 35, 373, 315,
+        371, 539, 371, 540, 371, 371, 371, 543, 371, 35, 373, 315, 371, 539, 371, 540,
+        371, 371, 544, 371, 371, 35, 373, 315, 545, 539, 371, 540, 371, 371, 371, 371,
+        371, 35, 373, 315, 371, 539, 371, 540, 371, 371, 371, 371, 315, 0, 373, 315,
+        315, 374, 315, 546, 315, 315, 315, 315, 291, 74, 284, 315, 291, 389, 291, 390,
+        291, 291, 291, 547, 291, 74, 284, 315, 291, 389, 291, 390, 291, 291, 548, 291,
+        291, 74, 284, 315, 549, 389, 291, 390, 291, 291, 291, 291, 291, 74, 284, 315,
+        291, 389, 291, 390, 291, 291, 291, 291, 291, 74, 284, 315, 291, 389, 291, 550,
+        291, 291, 291, 291, 291, 74, 284, 315, 291, 389, 291, 390, 291, 392, 291, 291,
+        130, 0, 181, 130, 314, 182, 130, 183, 130, 130, 130, 130, 130, 0, 181, 130,
+        130, 182, 130, 183, 315, 130, 130, 130, 130, 0, 181, 130, 130, 182, 130, 372,
+        130, 130, 130, 130, 130, 0, 181, 130, 130, 182, 130, 183, 130, 223, 130, 130,
+        315, 0, 373, 315, 525, 374, 315, 375, 315, 315, 315, 315, 315, 0, 373, 315,
+        315, 374, 315, 375, 315, 315, 315, 315, 315, 0, 373, 315, 315, 374, 315, 546,
+        315, 315, 315, 315, 436, 51, 373, 315, 436, 438, 551, 439, 436, 436, 436, 436,
+        436, 51, 373, 315, 436, 438, 436, 439, 436, 552, 436, 436, 436, 51, 373, 315,
+        436, 438, 436, 439, 436, 436, 436, 553, 436, 51, 373, 315, 436, 438, 436, 439,
+        436, 436, 554, 436, 436, 51, 373, 315, 555, 438, 436, 439, 436, 436, 436, 436,
+        436, 51, 373, 315, 436, 438, 436, 439, 436, 436, 436, 436, 436, 51, 373, 315,
+        436, 438, 436, 556, 436, 436, 436, 436, 315, 0, 373, 315, 315, 374, 315, 375,
+        315, 444, 315, 315, 341, 108, 284, 315, 557, 342, 341, 343, 341, 341, 341, 341,
+        341, 108, 284, 315, 341, 342, 341, 343, 341, 341, 341, 341, 341, 108, 284, 315,
+        341, 342, 341, 558, 341, 341, 341, 341, 341, 108, 284, 315, 341, 342, 341, 343,
+        341, 457, 341, 341, 380, 74, 373, 315, 380, 476, 380, 477, 380, 380, 380, 559,
+        380, 74, 373, 315, 380, 476, 380, 477, 380, 380, 560, 380, 380, 74, 373, 315,
+        561, 476, 380, 477, 380, 380, 380, 380, 380, 74, 373, 315, 380, 476, 380, 477,
+        380, 380, 380, 380, 380, 74, 373, 315, 380, 476, 380, 562, 380, 380, 380, 380,
+        380, 74, 373, 315, 380, 476, 380, 477, 380, 479, 380, 380, 401, 154, 284, 315,
+        401, 402, 401, 563, 401, 401, 401, 401, 401, 154, 284, 315, 401, 402, 401, 403,
+        401, 405, 401, 401, 447, 108, 373, 315, 564, 448, 447, 449, 447, 447, 447, 447,
+        447, 108, 373, 315, 447, 448, 447, 449, 447, 447, 447, 447, 447, 108, 373, 315,
+        447, 448, 447, 565, 447, 447, 447, 447, 447, 108, 373, 315, 447, 448, 447, 449,
+        447, 515, 447, 447, 240, 0, 284, 315, 240, 285, 240, 286, 240, 338, 240, 240,
+        488, 154, 373, 315, 488, 489, 488, 566, 488, 488, 488, 488, 488, 154, 373, 315,
+        488, 489, 488, 490, 488, 492, 488, 488, 315, 0, 373, 315, 315, 374, 315, 375,
+        315, 444, 315, 315,
+    };
+
+    constexpr std::uint32_t rules_n_0_accepts[] = {
+        4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295,
+        4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295,
+        1, 2, 4294967295, 4294967295, 5, 4294967295, 4294967295, 5, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 1, 4294967295, 1,
+        1, 1, 4294967295, 4294967295, 4294967295, 4294967295, 5, 5, 5, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 1, 4294967295,
+        1, 1, 1, 0, 1, 1, 1, 1, 1, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 5,
+        5, 5, 5, 5, 4294967295, 4294967295, 4294967295, 1, 4294967295, 1, 1, 0, 1, 1, 1, 1,
+        1, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295,
+        4294967295, 4294967295, 4294967295, 5, 5, 5, 5, 5, 5, 5, 4294967295, 1, 4294967295, 1, 1, 0,
+        1, 1, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0,
+        0, 1, 1, 1, 1, 1, 1, 1, 1, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295,
+        4294967295, 4294967295, 1, 5, 5, 5, 5, 5, 5, 5, 5, 4294967295, 1, 1, 0, 1,
+        1, 0, 0, 1, 1, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1,
+        1, 1, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1,
+        1, 5, 5, 5, 5, 5, 5, 5, 5, 1, 5, 0, 0, 0, 0, 0,
+        1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 1, 1, 1, 1, 1, 1, 5, 5, 5, 5, 5, 5, 5, 5, 1,
+        5, 1, 1, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1,
+        1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+        1, 1, 1, 0, 5, 5, 5, 5, 5, 5, 5, 5, 1, 5, 1, 1,
+        0, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1,
+        1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 1, 1, 0, 0, 0, 5, 5, 5, 5, 5, 5, 5, 5,
+        1, 5, 1, 1, 0, 1, 1, 0, 0, 1, 1, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        1, 0, 0, 0, 0, 0, 5, 5, 5, 5, 5, 5, 5, 5, 1, 5,
+        1, 1, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0,
+    };
+
+    constexpr symgen::precompiled_automaton rules_n_automata[] = {
+        symgen::precompiled_automaton { rules_n_0_classes, 12, rules_n_0_transitions, rules_n_0_accepts },
+    };
+
+    constexpr std::uint32_t rules_n_fallbacks[] = {
+        3, 4,
+    };
+
+    constexpr symgen::precompiled_rule_set rules_n {
+        std::span { rules_n_patterns }.first(6),
+        rules_n_automata,
+        rules_n_fallbacks
+    };
+
+
+    constexpr std::string_view rules_yo_patterns[] = {
+        ".*vertex_layout.*"sv,
+        ".*(_[0-9]{2,4}|#).*"sv,
+    };
+
+    constexpr std::uint8_t rules_yo_0_classes[] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4,
+        0, 5, 0, 0, 0, 6, 0, 0, 0, 0, 0, 0, 7, 0, 0, 8,
+        0, 0, 9, 0, 10, 11, 12, 0, 13, 14, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    };
+
+    constexpr std::uint32_t rules_yo_0_transitions[] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+        0, 2, 1, 3, 1, 1, 1, 1, 1, 1, 1, 4, 1, 1, 2, 0,
+        2, 2, 5, 2, 2, 2, 2, 2, 2, 2, 6, 2, 2, 1, 0, 2,
+        7, 3, 1, 1, 1, 1, 1, 1, 1, 4, 1, 1, 1, 0, 2, 1,
+        3, 1, 8, 1, 1, 1, 1, 1, 4, 1, 1, 2, 0, 2, 9, 5,
+        2, 2, 2, 2, 2, 2, 2, 6, 2, 2, 2, 0, 2, 2, 5, 2,
+        10, 2, 2, 2, 2, 2, 6, 2, 2, 1, 0, 2, 11, 3, 1, 1,
+        1, 1, 1, 1, 1, 4, 1, 1, 1, 0, 2, 1, 3, 1, 1, 1,
+        1, 12, 1, 1, 4, 1, 1, 2, 0, 2, 11, 5, 2, 2, 2, 2,
+        2, 2, 2, 6, 2, 2, 2, 0, 2, 2, 5, 2, 2, 2, 2, 13,
+        2, 2, 6, 2, 2, 2, 0, 2, 14, 5, 2, 2, 2, 2, 2, 2,
+        2, 6, 2, 2, 1, 0, 2, 1, 3, 1, 1, 1, 1, 1, 15, 1,
+        4, 1, 1, 2, 0, 2, 2, 5, 2, 2, 2, 2, 2, 16, 2, 6,
+        2, 2, 2, 0, 2, 2, 5, 2, 2, 2, 2, 2, 2, 2, 6, 2,
+        2, 1, 0, 2, 1, 3, 1, 17, 1, 1, 1, 1, 1, 4, 1, 1,
+        2, 0, 2, 2, 5, 2, 18, 2, 2, 2, 2, 2, 6, 2, 2, 1,
+        0, 2, 1, 3, 1, 1, 1, 1, 1, 1, 1, 4, 19, 1, 2, 0,
+        2, 2, 5, 2, 2, 2, 2, 2, 2, 2, 6, 20, 2, 1, 0, 2,
+        1, 21, 1, 1, 1, 1, 1, 1, 1, 4, 1, 1, 2, 0, 2, 2,
+        22, 2, 2, 2, 2, 2, 2, 2, 6, 2, 2, 1, 0, 2, 7, 3,
+        1, 1, 23, 1, 1, 1, 1, 4, 1, 1, 2, 0, 2, 9, 5, 2,
+        2, 24, 2, 2, 2, 2, 6, 2, 2, 1, 0, 2, 1, 3, 25, 1,
+        1, 1, 1, 1, 1, 4, 1, 1, 2, 0, 2, 2, 5, 26, 2, 2,
+        2, 2, 2, 2, 6, 2, 2, 1, 0, 2, 1, 3, 1, 1, 1, 1,
+        1, 1, 1, 4, 1, 27, 2, 0, 2, 2, 5, 2, 2, 2, 2, 2,
+        2, 2, 6, 2, 28, 1, 0, 2, 1, 3, 1, 1, 1, 29, 1, 1,
+        1, 4, 1, 1, 2, 0, 2, 2, 5, 2, 2, 2, 30, 2, 2, 2,
+        6, 2, 2, 1, 0, 2, 1, 3, 1, 1, 1, 1, 1, 1, 31, 4,
+        1, 1, 2, 0, 2, 2, 5, 2, 2, 2, 2, 2, 2, 32, 6, 2,
+        2, 1, 0, 2, 1, 3, 1, 1, 1, 1, 1, 33, 1, 4, 1, 1,
+        2, 0, 2, 2, 5, 2, 2, 2, 2, 2, 34, 2, 6, 2, 2, 33,
+        0, 34, 33, 35, 33, 33, 33, 33, 33, 33, 33, 36, 33, 33, 34, 0,
+        34, 34, 37, 34, 34, 34, 34, 34, 34, 34, 38, 34, 34, 33, 0, 34,
+        39, 35, 33, 33, 33, 33, 33, 33, 33, 36, 33, 33, 33, 0, 34, 33,
+        35, 33, 40, 33, 33, 33, 33, 33, 36, 33, 33, 34, 0, 34, 41, 37,
+        34, 34, 34, 34, 34, 34, 34, 38, 34, 34, 34, 0, 34, 34, 37, 34,
+        42, 34, 34, 34, 34, 34, 38, 34, 34, 33, 0, 34, 43, 35, 33, 33,
+        33, 33, 33, 33, 33, 36, 33, 33, 33, 0, 34, 33, 35, 33, 33, 33,
+        33, 44, 33, 33, 36, 33, 33, 34, 0, 34, 43, 37, 34, 34, 34, 34,
+        34, 34, 34, 38, 34, 34, 34, 0, 34, 34, 37, 34, 34, 34, 34, 45,
+        34, 34, 38, 34, 34, 34, 0, 34, 46, 37, 34, 34, 34, 34, 34, 34,
+        34, 38, 34, 34, 33, 0, 34, 33, 35, 33, 33, 33, 33, 33, 47, 33,
+        36, 33, 33, 34, 0, 34, 34, 37, 34, 34, 34, 34, 34, 48, 34, 38,
+        34, 34, 34, 0, 34, 34, 37, 34, 34, 34, 34, 34, 34, 34, 38, 34,
+        34, 33, 0, 34, 33, 35, 33, 49, 33, 33, 33, 33, 33, 36, 33, 33,
+        34, 0, 34, 34, 37, 34, 50, 34, 34, 34, 34, 34, 38, 34, 34, 33,
+        0, 34, 33, 35, 33, 33, 33, 33, 33, 33, 33, 36, 51, 33, 34, 0,
+        34, 34, 37, 34, 34, 34, 34, 34, 34, 34, 38, 52, 34, 33, 0, 34,
+        33, 53, 33, 33, 33, 33, 33, 33, 33, 36, 33, 33, 34, 0, 34, 34,
+        54, 34, 34, 34, 34, 34, 34, 34, 38, 34, 34, 33, 0, 34, 39, 35,
+        33, 33, 55, 33, 33, 33, 33, 36, 33, 33, 34, 0, 34, 41, 37, 34,
+        34, 56, 34, 34, 34, 34, 38, 34, 34, 33, 0, 34, 33, 35, 57, 33,
+        33, 33, 33, 33, 33, 36, 33, 33, 34, 0, 34, 34, 37, 58, 34, 34,
+        34, 34, 34, 34, 38, 34, 34, 33, 0, 34, 33, 35, 33, 33, 33, 33,
+        33, 33, 33, 36, 33, 59, 34, 0, 34, 34, 37, 34, 34, 34, 34, 34,
+        34, 34, 38, 34, 60, 33, 0, 34, 33, 35, 33, 33, 33, 61, 33, 33,
+        33, 36, 33, 33, 34, 0, 34, 34, 37, 34, 34, 34, 62, 34, 34, 34,
+        38, 34, 34, 33, 0, 34, 33, 35, 33, 33, 33, 33, 33, 33, 63, 36,
+        33, 33, 34, 0, 34, 34, 37, 34, 34, 34, 34, 34, 34, 64, 38, 34,
+        34, 33, 0, 34, 33, 35, 33, 33, 33, 33, 33, 33, 33, 36, 33, 33,
+        34, 0, 34, 34, 37, 34, 34, 34, 34, 34, 34, 34, 38, 34, 34,
+    };
+
+    constexpr std::uint32_t rules_yo_0_accepts[] = {
+        4294967295, 4294967295, 1, 4294967295, 4294967295, 1, 1, 4294967295, 4294967295, 1, 1, 1, 4294967295, 1, 1, 4294967295,
+        1, 4294967295, 1, 4294967295, 1, 4294967295, 1, 4294967295, 1, 4294967295, 1, 4294967295, 1, 4294967295, 1, 4294967295,
+        1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0,
+    };
+
+    constexpr symgen::precompiled_automaton rules_yo_automata[] = {
+        symgen::precompiled_automaton { rules_yo_0_classes, 15, rules_yo_0_transitions, rules_yo_0_accepts },
+    };
+
+    constexpr symgen::precompiled_rule_set rules_yo {
+        std::span { rules_yo_patterns }.first(2),
+        rules_yo_automata,
+        { }
+    };
+
+
+    constexpr std::string_view rules_no_patterns[] = {
+        ".*_.{5}"sv,
+        ".*:.{5}"sv,
+        ".*[a-d].[e-h]..[0-3].*"sv,
+    };
+
+    constexpr std::uint8_t rules_no_0_classes[] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    };
+
+    constexpr std::uint32_t rules_no_0_transitions[] = {
+        0, 0, 0, 1, 0, 2, 3, 0, 4, 5, 0, 6, 7, 0, 8, 9,
+        0, 10, 11, 0, 12, 13, 0, 14, 15, 0, 16, 17, 0, 18, 19, 0,
+        20, 21, 0, 22, 23, 0, 24, 25, 0, 26, 27, 0, 28, 29, 0, 30,
+        31, 0, 32, 33, 0, 34, 35, 0, 36, 37, 0, 38, 39, 0, 40, 41,
+        0, 42, 43, 0, 44, 45, 0, 46, 47, 0, 48, 49, 0, 50, 51, 0,
+        52, 53, 0, 54, 55, 0, 56, 57, 0, 58, 59, 0, 60, 61, 0, 62,
+        63, 0, 64, 1, 0, 2, 3, 0, 4, 5, 0, 6, 7, 0, 8, 9,
+        0, 10, 11, 0, 12, 13, 0, 14, 15, 0, 16, 17, 0, 18, 19, 0,
+        20, 21, 0, 22, 23, 0, 24, 25, 0, 26, 27, 0, 28, 29, 0, 30,
+        31, 0, 32, 33, 0, 34, 35, 0, 36, 37, 0, 38, 39, 0, 40, 41,
+        0, 42, 43, 0, 44, 45, 0, 46, 47, 0, 48, 49, 0, 50, 51, 0,
+        52, 53, 0, 54, 55, 0, 56, 57, 0, 58, 59, 0, 60, 61, 0, 62,
+        63, 0, 64,
+    };
+
+    constexpr std::uint32_t rules_no_0_accepts[] = {
+        4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295,
+        4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295,
+        4294967295, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0,
+    };
+
+    constexpr std::uint8_t rules_no_1_classes[] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        2, 2, 2, 2, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 4, 4, 4, 4, 5, 5, 5, 5, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    };
+
+    constexpr std::uint32_t rules_no_1_transitions[] = {
+        0, 0, 0, 0, 0, 0, 1, 0, 1, 2, 3, 1, 4, 0, 4, 5,
+        6, 4, 7, 0, 7, 8, 9, 7, 10, 0, 10, 11, 12, 10, 13, 0,
+        13, 14, 15, 13, 16, 0, 16, 17, 18, 16, 1, 0, 1, 2, 3, 19,
+        4, 0, 4, 5, 6, 20, 7, 0, 7, 8, 9, 21, 22, 0, 22, 23,
+        24, 22, 25, 0, 25, 26, 27, 25, 28, 0, 28, 29, 30, 28, 31, 0,
+        31, 32, 33, 31, 34, 0, 34, 35, 36, 34, 37, 0, 37, 38, 39, 37,
+        22, 0, 22, 23, 24, 40, 25, 0, 25, 26, 27, 41, 28, 0, 28, 29,
+        30, 42, 43, 0, 43, 44, 45, 43, 46, 0, 46, 47, 48, 46, 43, 0,
+        43, 44, 45, 49, 50, 0, 50, 51, 52, 50, 53, 0, 53, 54, 55, 53,
+        56, 0, 56, 57, 58, 56, 59, 0, 59, 60, 61, 59, 62, 0, 62, 63,
+        64, 62, 65, 0, 65, 66, 67, 65, 50, 0, 50, 51, 52, 68, 53, 0,
+        53, 54, 55, 69, 56, 0, 56, 57, 58, 70, 71, 0, 71, 72, 73, 71,
+        74, 0, 74, 75, 76, 74, 77, 0, 77, 78, 79, 77, 80, 0, 80, 81,
+        82, 80, 83, 0, 83, 84, 85, 83, 86, 0, 86, 87, 88, 86, 71, 0,
+        71, 72, 73, 89, 74, 0, 74, 75, 76, 90, 77, 0, 77, 78, 79, 91,
+        92, 0, 92, 93, 94, 92, 95, 0, 95, 96, 97, 95, 92, 0, 92, 93,
+        94, 98, 99, 0, 99, 100, 101, 99, 102, 0, 102, 103, 104, 102, 105, 0,
+        105, 106, 107, 105, 108, 0, 108, 109, 110, 108, 111, 0, 111, 112, 113, 111,
+        114, 0, 114, 115, 116, 114, 117, 0, 117, 118, 119, 117, 120, 0, 120, 121,
+        122, 120, 123, 0, 123, 124, 125, 123, 126, 0, 126, 127, 128, 126, 129, 0,
+        129, 130, 131, 129, 132, 0, 132, 133, 134, 132, 135, 0, 135, 136, 137, 135,
+        120, 0, 120, 121, 122, 138, 123, 0, 123, 124, 125, 139, 126, 0, 126, 127,
+        128, 140, 141, 0, 141, 142, 143, 141, 144, 0, 144, 145, 146, 144, 147, 0,
+        147, 148, 149, 147, 150, 0, 150, 151, 152, 150, 153, 0, 153, 154, 155, 153,
+        156, 0, 156, 157, 158, 156, 141, 0, 141, 142, 143, 159, 144, 0, 144, 145,
+        146, 160, 147, 0, 147, 148, 149, 161, 162, 0, 162, 163, 164, 162, 165, 0,
+        165, 166, 167, 165, 162, 0, 162, 163, 164, 168, 169, 0, 169, 170, 171, 169,
+        172, 0, 172, 173, 174, 172, 175, 0, 175, 176, 177, 175, 178, 0, 178, 179,
+        180, 178, 181, 0, 181, 182, 183, 181, 184, 0, 184, 185, 186, 184, 169, 0,
+        169, 170, 171, 187, 172, 0, 172, 173, 174, 188, 175, 0, 175, 176, 177, 189,
+        190, 0, 190, 191, 192, 190, 193, 0, 193, 194, 195, 193, 196, 0, 196, 197,
+        198, 196, 199, 0, 199, 200, 201, 199, 202, 0, 202, 203, 204, 202, 205, 0,
+        205, 206, 207, 205, 190, 0, 190, 191, 192, 208, 193, 0, 193, 194, 195, 209,
+        196, 0, 196, 197, 198, 210, 211, 0, 211, 212, 213, 211, 214, 0, 214, 215,
+        216, 214, 211, 0, 211, 212, 213, 217, 218, 0, 218, 219, 220, 218, 221, 0,
+        221, 222, 223, 221, 224, 0, 224, 225, 226, 224, 227, 0, 227, 228, 229, 227,
+        230, 0, 230, 231, 232, 230, 233, 0, 233, 234, 235, 233, 236, 0, 236, 237,
+        238, 236, 1, 0, 239, 2, 3, 1, 4, 0, 240, 5, 6, 4, 7, 0,
+        241, 8, 9, 7, 10, 0, 242, 11, 12, 10, 13, 0, 243, 14, 15, 13,
+        16, 0, 244, 17, 18, 16, 1, 0, 239, 2, 3, 19, 4, 0, 240, 5,
+        6, 20, 7, 0, 241, 8, 9, 21, 50, 0, 245, 51, 52, 50, 53, 0,
+        246, 54, 55, 53, 56, 0, 247, 57, 58, 56, 59, 0, 248, 60, 61, 59,
+        62, 0, 249, 63, 64, 62, 65, 0, 250, 66, 67, 65, 50, 0, 245, 51,
+        52, 68, 53, 0, 246, 54, 55, 69, 56, 0, 247, 57, 58, 70, 99, 0,
+        251, 100, 101, 99, 102, 0, 252, 103, 104, 102, 105, 0, 253, 106, 107, 105,
+        1, 0, 1, 2, 3, 1, 4, 0, 4, 5, 6, 4, 7, 0, 7, 8,
+        9, 7, 10, 0, 10, 11, 12, 10, 13, 0, 13, 14, 15, 13, 16, 0,
+        16, 17, 18, 16, 1, 0, 1, 2, 3, 19, 4, 0, 4, 5, 6, 20,
+        7, 0, 7, 8, 9, 21, 22, 0, 22, 23, 24, 22, 25, 0, 25, 26,
+        27, 25, 28, 0, 28, 29, 30, 28, 31, 0, 31, 32, 33, 31, 34, 0,
+        34, 35, 36, 34, 37, 0, 37, 38, 39, 37, 22, 0, 22, 23, 24, 40,
+        25, 0, 25, 26, 27, 41, 28, 0, 28, 29, 30, 42, 43, 0, 43, 44,
+        45, 43, 46, 0, 46, 47, 48, 46, 43, 0, 43, 44, 45, 49, 50, 0,
+        50, 51, 52, 50, 53, 0, 53, 54, 55, 53, 56, 0, 56, 57, 58, 56,
+        59, 0, 59, 60, 61, 59, 62, 0, 62, 63, 64, 62, 65, 0, 65, 66,
+        67, 65, 50, 0, 50, 51, 52, 68, 53, 0, 53, 54, 55, 69, 56, 0,
+        56, 57, 58, 70, 71, 0, 71, 72, 73, 71, 74, 0, 74, 75, 76, 74,
+        77, 0, 77, 78, 79, 77, 80, 0, 80, 81, 82, 80, 83, 0, 83, 84,
+        85, 83, 86, 0, 86, 87, 88, 86, 71, 0, 71, 72, 73, 89, 74, 0,
+        74, 75, 76, 90, 77, 0, 77, 78, 79, 91, 92, 0, 92, 93, 94, 92,
+        95, 0, 95, 96, 97, 95, 92, 0, 92, 93, 94, 98, 99, 0, 99, 100,
+        101, 99, 102, 0, 102, 103, 104, 102, 105, 0, 105, 106, 107, 105, 108, 0,
+        108, 109, 110, 108, 111, 0, 111, 112, 113, 111, 114, 0, 114, 115, 116, 114,
+        117, 0, 117, 118, 119, 117, 120, 0, 120, 121, 122, 120, 123, 0, 123, 124,
+        125, 123, 126, 0, 126, 127, 128, 126, 129, 0, 129, 130, 131, 129, 132, 0,
+        132, 133, 134, 132, 135, 0, 135, 136, 137, 135, 120, 0, 120, 121, 122, 138,
+        123, 0, 123, 124, 125, 139, 126, 0, 126, 127, 128, 140, 141, 0, 141, 142,
+        143, 141, 144, 0, 144, 145, 146, 144, 147, 0, 147, 148, 149, 147, 150, 0,
+        150, 151, 152, 150, 153, 0, 153, 154, 155, 153, 156, 0, 156, 157, 158, 156,
+        141, 0, 141, 142, 143, 159, 144, 0, 144, 145, 146, 160, 147, 0, 147, 148,
+        149, 161, 162, 0, 162, 163, 164, 162, 165, 0, 165, 166, 167, 165, 162, 0,
+        162, 163, 164, 168, 169, 0, 169, 170, 171, 169, 172, 0, 172, 173, 174, 172,
+        175, 0, 175, 176, 177, 175, 178, 0, 178, 179, 180, 178, 181, 0, 181, 182,
+        183, 181, 184, 0, 184, 185, 186, 184, 169, 0, 169, 170, 171, 187, 172, 0,
+        172, 173, 174, 188, 175, 0, 175, 176, 177, 189, 190, 0, 190, 191, 192, 190,
+        193, 0, 193, 194, 195, 193, 196, 0, 196, 197, 198, 196, 199, 0, 199, 200,
+        201, 199, 202, 0, 202, 203, 204, 202, 205, 0, 205, 206, 207, 205, 190, 0,
+        190, 191, 192, 208, 193, 0, 193, 194, 195, 209, 196, 0, 196, 197, 198, 210,
+        211, 0, 211, 212, 213, 211, 214, 0, 214, 215, 216, 214, 211, 0, 211, 212,
+        213, 217, 218, 0, 218, 219, 220, 218, 221, 0, 221, 222, 223, 221, 224, 0,
+        224, 225, 226, 224, 227, 0, 227, 228, 229, 227, 230, 0, 230, 231, 232, 230,
+        233, 0, 233, 234, 235, 233, 236, 0, 236, 237, 238, 236, 1, 0, 239, 2,
+        3, 1, 4, 0, 240, 5, 6, 4, 7, 0, 241, 8, 9, 7, 10, 0,
+        242, 11, 12, 10, 13, 0, 243, 14, 15, 13, 16, 0, 244, 17, 18, 16,
+        1, 0, 239, 2, 3, 19, 4, 0, 240, 5, 6, 20, 7, 0, 241, 8,
+        9, 21, 50, 0, 245, 51, 52, 50, 53, 0, 246, 54, 55, 53, 56, 0,
+        247, 57, 58, 56, 59, 0, 248, 60, 61, 59, 62, 0, 249, 63, 64, 62,
+        65, 0, 250, 66, 67, 65, 50, 0, 245, 51, 52, 68, 53, 0, 246, 54,
+        55, 69, 56, 0, 247, 57, 58, 70, 99, 0, 251, 100, 101, 99, 102, 0,
+        252, 103, 104, 102, 105, 0, 253, 106, 107, 105, 239, 0, 239, 254, 255, 239,
+        242, 0, 242, 256, 257, 242, 239, 0, 239, 254, 255, 258, 259, 0, 259, 260,
+        261, 259, 262, 0, 262, 263, 264, 262, 259, 0, 259, 260, 261, 265, 266, 0,
+        266, 267, 268, 266, 269, 0, 269, 270, 271, 269, 266, 0, 266, 267, 268, 272,
+        273, 0, 273, 274, 275, 273, 276, 0, 276, 277, 278, 276, 273, 0, 273, 274,
+        275, 279, 239, 0, 239, 254, 255, 239, 242, 0, 242, 256, 257, 242, 239, 0,
+        239, 254, 255, 258, 240, 0, 240, 280, 281, 240, 241, 0, 241, 282, 283, 241,
+        284, 0, 284, 285, 286, 284, 287, 0, 287, 288, 289, 287, 290, 0, 290, 291,
+        292, 290, 245, 0, 245, 293, 294, 245, 246, 0, 246, 295, 296, 246, 247, 0,
+        247, 297, 298, 247, 299, 0, 299, 300, 301, 299, 302, 0, 302, 303, 304, 302,
+        305, 0, 305, 306, 307, 305, 308, 0, 308, 309, 310, 308, 239, 0, 239, 254,
+        255, 239, 240, 0, 240, 280, 281, 240, 241, 0, 241, 282, 283, 241, 259, 0,
+        259, 260, 261, 259, 284, 0, 284, 285, 286, 284, 287, 0, 287, 288, 289, 287,
+        290, 0, 290, 291, 292, 290, 245, 0, 245, 293, 294, 245, 246, 0, 246, 295,
+        296, 246, 247, 0, 247, 297, 298, 247, 299, 0, 299, 300, 301, 299, 302, 0,
+        302, 303, 304, 302, 305, 0, 305, 306, 307, 305, 308, 0, 308, 309, 310, 308,
+        243, 0, 243, 311, 312, 243, 244, 0, 244, 313, 314, 244, 240, 0, 240, 280,
+        281, 315, 241, 0, 241, 282, 283, 316, 248, 0, 248, 317, 318, 248, 249, 0,
+        249, 319, 320, 249, 250, 0, 250, 321, 322, 250, 245, 0, 245, 293, 294, 323,
+        246, 0, 246, 295, 296, 324, 247, 0, 247, 297, 298, 325, 251, 0, 251, 326,
+        327, 251, 252, 0, 252, 328, 329, 252, 253, 0, 253, 330, 331, 253, 332, 0,
+        332, 333, 334, 332, 335, 0, 335, 336, 337, 335, 338, 0, 338, 339, 340, 338,
+        341, 0, 341, 342, 343, 341, 332, 0, 332, 333, 334, 344, 335, 0, 335, 336,
+        337, 345, 346, 0, 346, 347, 348, 346, 349, 0, 349, 350, 351, 349, 352, 0,
+        352, 353, 354, 352, 355, 0, 355, 356, 357, 355, 358, 0, 358, 359, 360, 358,
+        361, 0, 361, 362, 363, 361, 346, 0, 346, 347, 348, 364, 349, 0, 349, 350,
+        351, 365, 352, 0, 352, 353, 354, 366, 367, 0, 367, 368, 369, 367, 370, 0,
+        370, 371, 372, 370, 373, 0, 373, 374, 375, 373, 376, 0, 376, 377, 378, 376,
+        379, 0, 379, 380, 381, 379, 284, 0, 284, 285, 286, 382, 287, 0, 287, 288,
+        289, 383, 384, 0, 384, 385, 386, 384, 290, 0, 290, 291, 292, 387, 388, 0,
+        388, 389, 390, 388, 391, 0, 391, 392, 393, 391, 394, 0, 394, 395, 396, 394,
+        397, 0, 397, 398, 399, 397, 388, 0, 388, 389, 390, 400, 391, 0, 391, 392,
+        393, 401, 402, 0, 402, 403, 404, 402, 405, 0, 405, 406, 407, 405, 402, 0,
+        402, 403, 404, 408, 240, 0, 240, 280, 281, 240, 241, 0, 241, 282, 283, 241,
+        243, 0, 243, 311, 312, 243, 244, 0, 244, 313, 314, 244, 240, 0, 240, 280,
+        281, 315, 241, 0, 241, 282, 283, 316, 242, 0, 242, 256, 257, 242, 243, 0,
+        243, 311, 312, 243, 244, 0, 244, 313, 314, 244, 239, 0, 239, 254, 255, 258,
+        240, 0, 240, 280, 281, 315, 241, 0, 241, 282, 283, 316, 262, 0, 262, 263,
+        264, 262, 376, 0, 376, 377, 378, 376, 379, 0, 379, 380, 381, 379, 259, 0,
+        259, 260, 261, 265, 284, 0, 284, 285, 286, 382, 287, 0, 287, 288, 289, 383,
+        384, 0, 384, 385, 386, 384, 290, 0, 290, 291, 292, 387, 266, 0, 266, 267,
+        268, 266, 332, 0, 332, 333, 334, 332, 335, 0, 335, 336, 337, 335, 269, 0,
+        269, 270, 271, 269, 338, 0, 338, 339, 340, 338, 341, 0, 341, 342, 343, 341,
+        266, 0, 266, 267, 268, 272, 332, 0, 332, 333, 334, 344, 335, 0, 335, 336,
+        337, 345, 273, 0, 273, 274, 275, 273, 388, 0, 388, 389, 390, 388, 391, 0,
+        391, 392, 393, 391, 276, 0, 276, 277, 278, 276, 394, 0, 394, 395, 396, 394,
+        397, 0, 397, 398, 399, 397, 273, 0, 273, 274, 275, 279, 388, 0, 388, 389,
+        390, 400, 391, 0, 391, 392, 393, 401, 402, 0, 402, 403, 404, 402, 405, 0,
+        405, 406, 407, 405, 402, 0, 402, 403, 404, 408, 239, 0, 239, 254, 255, 239,
+        240, 0, 240, 280, 281, 240, 241, 0, 241, 282, 283, 241, 242, 0, 242, 256,
+        257, 242, 243, 0, 243, 311, 312, 243, 244, 0, 244, 313, 314, 244, 239, 0,
+        239, 254, 255, 258, 240, 0, 240, 280, 281, 315, 241, 0, 241, 282, 283, 316,
+        409, 0, 409, 410, 411, 409, 412, 0, 412, 413, 414, 412, 415, 0, 415, 416,
+        417, 415, 299, 0, 299, 300, 301, 418, 302, 0, 302, 303, 304, 419, 305, 0,
+        305, 306, 307, 420, 421, 0, 421, 422, 423, 421, 308, 0, 308, 309, 310, 424,
+        425, 0, 425, 426, 427, 425, 428, 0, 428, 429, 430, 428, 431, 0, 431, 432,
+        433, 431, 434, 0, 434, 435, 436, 434, 248, 0, 248, 317, 318, 248, 249, 0,
+        249, 319, 320, 249, 250, 0, 250, 321, 322, 250, 245, 0, 245, 293, 294, 323,
+        246, 0, 246, 295, 296, 324, 247, 0, 247, 297, 298, 325, 409, 0, 409, 410,
+        411, 409, 412, 0, 412, 413, 414, 412, 415, 0, 415, 416, 417, 415, 299, 0,
+        299, 300, 301, 418, 302, 0, 302, 303, 304, 419, 305, 0, 305, 306, 307, 420,
+        421, 0, 421, 422, 423, 421, 308, 0, 308, 309, 310, 424, 251, 0, 251, 326,
+        327, 251, 252, 0, 252, 328, 329, 252, 253, 0, 253, 330, 331, 253, 425, 0,
+        425, 426, 427, 425, 428, 0, 428, 429, 430, 428, 431, 0, 431, 432, 433, 431,
+        434, 0, 434, 435, 436, 434, 437, 0, 437, 438, 439, 437, 440, 0, 440, 441,
+        442, 440, 443, 0, 443, 444, 445, 443, 446, 0, 446, 447, 448, 446, 449, 0,
+        449, 450, 451, 449, 452, 0, 452, 453, 454, 452, 437, 0, 437, 438, 439, 455,
+        440, 0, 440, 441, 442, 456, 443, 0, 443, 444, 445, 457, 458, 0, 458, 459,
+        460, 458, 461, 0, 461, 462, 463, 461, 458, 0, 458, 459, 460, 464, 465, 0,
+        465, 466, 467, 465, 468, 0, 468, 469, 470, 468, 471, 0, 471, 472, 473, 471,
+        474, 0, 474, 475, 476, 474, 245, 0, 245, 293, 294, 245, 246, 0, 246, 295,
+        296, 246, 247, 0, 247, 297, 298, 247, 248, 0, 248, 317, 318, 248, 249, 0,
+        249, 319, 320, 249, 250, 0, 250, 321, 322, 250, 245, 0, 245, 293, 294, 323,
+        246, 0, 246, 295, 296, 324, 247, 0, 247, 297, 298, 325, 251, 0, 251, 326,
+        327, 251, 252, 0, 252, 328, 329, 252, 253, 0, 253, 330, 331, 253, 346, 0,
+        346, 347, 348, 346, 349, 0, 349, 350, 351, 349, 352, 0, 352, 353, 354, 352,
+        355, 0, 355, 356, 357, 355, 358, 0, 358, 359, 360, 358, 361, 0, 361, 362,
+        363, 361, 346, 0, 346, 347, 348, 364, 349, 0, 349, 350, 351, 365, 352, 0,
+        352, 353, 354, 366, 437, 0, 437, 438, 439, 437, 440, 0, 440, 441, 442, 440,
+        443, 0, 443, 444, 445, 443, 446, 0, 446, 447, 448, 446, 449, 0, 449, 450,
+        451, 449, 452, 0, 452, 453, 454, 452, 437, 0, 437, 438, 439, 455, 440, 0,
+        440, 441, 442, 456, 443, 0, 443, 444, 445, 457, 458, 0, 458, 459, 460, 458,
+        461, 0, 461, 462, 463, 461, 458, 0, 458, 459, 460, 464, 367, 0, 367, 368,
+        369, 367, 370, 0, 370, 371, 372, 370, 373, 0, 373, 374, 375, 373, 465, 0,
+        465, 466, 467, 465, 468, 0, 468, 469, 470, 468, 471, 0, 471, 472, 473, 471,
+        474, 0, 474, 475, 476, 474, 245, 0, 245, 293, 294, 245, 246, 0, 246, 295,
+        296, 246, 247, 0, 247, 297, 298, 247, 248, 0, 248, 317, 318, 248, 249, 0,
+        249, 319, 320, 249, 250, 0, 250, 321, 322, 250, 245, 0, 245, 293, 294, 323,
+        246, 0, 246, 295, 296, 324, 247, 0, 247, 297, 298, 325, 251, 0, 251, 326,
+        327, 251, 252, 0, 252, 328, 329, 252, 253, 0, 253, 330, 331, 253,
+    };
+
+    constexpr std::uint32_t rules_no_1_accepts[] = {
+        4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295,
+        4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295,
+        4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295,
+        4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295,
+        4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295,
+        4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295,
+        4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295,
+        4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 4294967295, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2,
+        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2,
+        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2,
+        2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2,
+        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+        2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    };
+
+    constexpr symgen::precompiled_automaton rules_no_automata[] = {
+        symgen::precompiled_automaton { rules_no_0_classes, 3, rules_no_0_transitions, rules_no_0_accepts },
+        symgen::precompiled_automaton { rules_no_1_classes, 6, rules_no_1_transitions, rules_no_1_accepts },
+    };
+
+    constexpr symgen::precompiled_rule_set rules_no {
+        std::span { rules_no_patterns }.first(3),
+        rules_no_automata,
+        { }
+    };
+
+
+    constexpr symgen::precompiled_rules rules { rules_y, rules_n, rules_yo, rules_no };
+
+    [[maybe_unused]] const bool registered = (symgen::precompiled_rules::registered() = &rules, true);
+}
@@ -1,11 +1,54 @@
 #include <coffi/coffi.hpp>
 
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
 
-extern "C" __declspec(dllexport) int keep_symbol(const char* demangled_name, const void* symbol, const void* reader) {
-    // Discard symbols that have stupid names.
-    for (const auto& name : { "blingbloing", "bingus", "bababooey" }) {
-        if (strstr(demangled_name, name) != nullptr) return 0;
+
+#ifdef _WIN32
+    #define FILTER_EXPORT extern "C" __declspec(dllexport)
+#else
+    #define FILTER_EXPORT extern "C" __attribute__((visibility("default")))
+#endif
+
+
+// Names of symbols to discard. Set up once in filter_init, rather than on every call.
+static std::vector<std::string> stupid_names;
+
+
+static bool has_stupid_name(const char* demangled_name) {
+    for (const auto& name : stupid_names) {
+        if (strstr(demangled_name, name.c_str()) != nullptr) return true;
     }
 
+    return false;
+}
+
+
+// Called once after the filter is loaded. Returning zero aborts SymbolGenerator.
+FILTER_EXPORT int filter_init(void) {
+    stupid_names = { "blingbloing", "bingus", "bababooey" };
     return 1;
+}
+
+
+// Called once before SymbolGenerator exits.
+FILTER_EXPORT void filter_teardown(void) {
+    stupid_names.clear();
+}
+
+
+// Called once per symbol, if keep_symbols_batch is not exported.
+FILTER_EXPORT int keep_symbol(const char* demangled_name, const void* symbol, const void* reader) {
+    // Discard symbols that have stupid names.
+    return has_stupid_name(demangled_name) ? 0 : 1;
+}
+
+
+// Called once per object with all symbols that passed the other filters. Set bit i of keep to keep symbol i.
+FILTER_EXPORT void keep_symbols_batch(const char* const* demangled_names, const void* const* symbols, std::uint32_t count, const void* reader, std::uint8_t* keep) {
+    for (std::uint32_t i = 0; i < count; ++i) {
+        if (!has_stupid_name(demangled_names[i])) keep[i / 8] |= (std::uint8_t) (1u << (i % 8));
+    }
 }
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include <SymbolGenerator/archive_reader.hpp>
+#include <SymbolGenerator/utility.hpp>
+
+#include <charconv>
+#include <cstring>
+
+
+namespace symgen {
+    // Layout of the archive format, see https://learn.microsoft.com/en-us/windows/win32/debug/pe-format#archive-library-file-format.
+    constexpr std::string_view ARCHIVE_SIGNATURE = "!<arch>\n";
+    constexpr std::size_t MEMBER_HEADER_SIZE     = 60;
+    constexpr std::size_t MEMBER_NAME_SIZE       = 16;
+    constexpr std::size_t MEMBER_SIZE_OFFSET     = 48;
+    constexpr std::size_t MEMBER_SIZE_SIZE       = 10;
+    constexpr std::string_view MEMBER_HEADER_END = "`\n";
+
+
+    // Header fields are ASCII text, padded with spaces.
+    static std::string_view read_field(std::span<const std::byte> data, std::size_t offset, std::size_t size) {
+        std::string_view field { (const char*) data.data() + offset, size };
+        return field.substr(0, field.find_last_not_of(' ') + 1);
+    }
+
+
+    // Import objects start with an anonymous object header of version zero.
+    static bool is_import_object(std::span<const std::byte> data) {
+        return data.size() >= 6 &&
+            read_le<std::uint16_t>(data, 0) == 0 &&
+            read_le<std::uint16_t>(data, 2) == 0xFFFF &&
+            read_le<std::uint16_t>(data, 4) == 0;
+    }
+
+
+    archive_reader::archive_reader(const fs::path& path) : file(path), data(file.data()), error(file.get_error()) {
+        if (!error) parse_members();
+    }
+
+
+    void archive_reader::parse_members(void) {
+        if (data.size() < ARCHIVE_SIGNATURE.size() || std::memcmp(data.data(), ARCHIVE_SIGNATURE.data(), ARCHIVE_SIGNATURE.size()) != 0) {
+            error = "file is not an archive";
+            return;
+        }
+
+
+        std::string_view long_names;
+        std::size_t offset = ARCHIVE_SIGNATURE.size();
+
+        while (offset < data.size()) {
+            if (data.size() - offset < MEMBER_HEADER_SIZE) {
+                error = "member header extends past the end of the file";
+                return;
+            }
+
+            if (read_field(data, offset + MEMBER_HEADER_SIZE - MEMBER_HEADER_END.size(), MEMBER_HEADER_END.size()) != MEMBER_HEADER_END) {
+                error = "member header is invalid";
+                return;
+            }
+
+
+            auto size_field = read_field(data, offset + MEMBER_SIZE_OFFSET, MEMBER_SIZE_SIZE);
+            std::size_t size = 0;
+
+            auto [end, parse_error] = std::from_chars(size_field.data(), size_field.data() + size_field.size(), size);
+            if (parse_error != std::errc { } || end != size_field.data() + size_field.size() || size > data.size() - offset - MEMBER_HEADER_SIZE) {
+                error = "member size is invalid";
+                return;
+            }
+
+
+            auto name         = read_field(data, offset, MEMBER_NAME_SIZE);
+            auto contents     = data.subspan(offset + MEMBER_HEADER_SIZE, size);
+            auto contents_str = std::string_view { (const char*) contents.data(), contents.size() };
+
+            // Members are aligned to two bytes.
+            offset += MEMBER_HEADER_SIZE + size + (size & 1);
+
+
+            if (name == "//") {
+                long_names = contents_str;
+                continue;
+            }
+
+            if (name.starts_with('/')) {
+                // Names of the form /n refer to offset n in the long name table. All other names starting with a slash are special members,
+                // like the linker members (which contain a symbol index of the archive) and the ARM64EC symbol table.
+                std::size_t name_offset = 0;
+                auto [name_end, name_error] = std::from_chars(name.data() + 1, name.data() + name.size(), name_offset);
+
+                if (name.size() == 1 || name_error != std::errc { } || name_end != name.data() + name.size()) continue;
+
+                if (name_offset >= long_names.size()) {
+                    error = "member name refers past the end of the long name table";
+                    return;
+                }
+
+                // Long names are terminated by a null character (lib.exe) or by "/\n" (GNU ar).
+                name = long_names.substr(name_offset);
+                name = name.substr(0, name.find_first_of(std::string_view { "\0\n", 2 }));
+            }
+
+            if (name.ends_with('/')) name.remove_suffix(1);
+
+
+            if (is_import_object(contents)) {
+                ++import_member_count;
+                continue;
+            }
+
+            members.push_back(archive_member { .name = name, .index = members.size(), .data = contents });
+        }
+    }
+}
\ No newline at end of file
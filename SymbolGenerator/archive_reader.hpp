@@ -0,0 +1,58 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+#include <SymbolGenerator/mapped_file.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace symgen {
+    // A single object stored in an archive. The data refers directly into the mapped archive.
+    struct archive_member {
+        // Name of the member as stored in the archive. For archives created by lib.exe this is usually the full path of the original object.
+        std::string_view name;
+        // Index of the member among all object members, used to tell apart members with the same name.
+        std::size_t index;
+        std::span<const std::byte> data;
+
+
+        // File name of the member without its directory and extension, for use in log messages and cache paths.
+        [[nodiscard]] std::string_view get_stem(void) const {
+            auto stem = name.substr(name.find_last_of("/\\") + 1);
+            return stem.substr(0, stem.rfind('.'));
+        }
+    };
+
+
+    // Reads a static library (.lib, in the ar archive format) from a memory mapping of the file, and lists the objects it contains.
+    // Linker members, the long name table and import objects (the members of import libraries) are skipped, since they contain no symbols to export.
+    class archive_reader {
+    public:
+        explicit archive_reader(const fs::path& path);
+
+        archive_reader(const archive_reader&) = delete;
+        archive_reader& operator=(const archive_reader&) = delete;
+
+
+        // Returns an error message if the file is not an archive this reader understands, or nullopt otherwise.
+        [[nodiscard]] const std::optional<std::string>& get_error(void) const { return error; }
+
+        [[nodiscard]] const std::vector<archive_member>& get_members(void) const { return members; }
+        [[nodiscard]] std::size_t get_import_member_count(void) const { return import_member_count; }
+    private:
+        mapped_file file;
+        std::span<const std::byte> data;
+        std::optional<std::string> error;
+
+        std::vector<archive_member> members;
+        std::size_t import_member_count = 0;
+
+
+        void parse_members(void);
+    };
+}
\ No newline at end of file
@@ -89,6 +89,15 @@ namespace symgen {
         }
 
 
+        // Returns the value of the argument the way it is printed, regardless of its type.
+        std::optional<std::string> get_argument_text(std::string_view key) const {
+            auto it = arguments.find(key);
+            if (it == arguments.end()) return std::nullopt;
+
+            return std::visit([] (const auto& v) { return stream_to_string(v); }, it->second);
+        }
+
+
         template <typename T> void require_argument(std::string_view key) {
             logger::instance().assert_that(has_argument(key), "Missing required argument ", key);
         }
@@ -116,8 +125,12 @@ namespace symgen {
             if (lower == "true" ) return true;
             if (lower == "false") return false;
 
+            // Only treat the value as a number if all of it is, so e.g. the 1/4 of -shard 1/4 is not parsed as 1.
             try {
-                return argument_t { std::stoll(lower) };
+                std::size_t length = 0;
+                auto number = std::stoll(lower, &length);
+
+                if (length == lower.size()) return argument_t { number };
             } catch (...) {}
 
             return argument_t { std::string { value } };
@@ -0,0 +1,340 @@
+#include <SymbolGenerator/cache_database.hpp>
+#include <SymbolGenerator/argument_parser.hpp>
+#include <SymbolGenerator/utility.hpp>
+#include <SymbolGenerator/logger.hpp>
+
+#include <fstream>
+
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <sys/file.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+
+    #include <cerrno>
+    #include <cstring>
+#endif
+
+
+namespace symgen {
+    constexpr std::size_t FILE_HEADER_SIZE   = 8;
+    constexpr std::size_t RECORD_HEADER_SIZE = 24;
+    constexpr std::uint32_t RECORD_MAGIC     = 0x52434753; // "SGCR"
+
+    // Databases smaller than this are never compacted, since rewriting them would cost more than the space it saves.
+    constexpr std::size_t MIN_COMPACTION_SIZE = 1 << 20;
+
+
+    // Advisory lock on a file, shared between processes.
+    class file_lock {
+    public:
+        file_lock(const fs::path& path, bool exclusive) {
+            #ifdef _WIN32
+                handle = CreateFileW(
+                    path.c_str(),
+                    GENERIC_READ | GENERIC_WRITE,
+                    FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                    nullptr,
+                    OPEN_ALWAYS,
+                    FILE_ATTRIBUTE_NORMAL,
+                    nullptr
+                );
+
+                if (handle == INVALID_HANDLE_VALUE) {
+                    error = stream_to_string("failed to open lock file ", path, ": ", get_last_winapi_error());
+                    return;
+                }
+
+                OVERLAPPED overlapped { };
+                if (!LockFileEx(handle, exclusive ? LOCKFILE_EXCLUSIVE_LOCK : 0, 0, MAXDWORD, MAXDWORD, &overlapped)) {
+                    error = stream_to_string("failed to lock ", path, ": ", get_last_winapi_error());
+                }
+            #else
+                fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+
+                if (fd == -1) {
+                    error = stream_to_string("failed to open lock file ", path, ": ", std::strerror(errno));
+                    return;
+                }
+
+                int result;
+                do { result = ::flock(fd, exclusive ? LOCK_EX : LOCK_SH); } while (result == -1 && errno == EINTR);
+
+                if (result != 0) error = stream_to_string("failed to lock ", path, ": ", std::strerror(errno));
+            #endif
+        }
+
+
+        ~file_lock(void) {
+            // Closing the file releases the lock.
+            #ifdef _WIN32
+                if (handle != INVALID_HANDLE_VALUE) CloseHandle(handle);
+            #else
+                if (fd != -1) ::close(fd);
+            #endif
+        }
+
+
+        file_lock(const file_lock&) = delete;
+        file_lock& operator=(const file_lock&) = delete;
+
+
+        // If the lock could not be acquired, the reason why.
+        [[nodiscard]] const std::optional<std::string>& get_error(void) const { return error; }
+    private:
+        #ifdef _WIN32
+            HANDLE handle;
+        #else
+            int fd;
+        #endif
+
+        std::optional<std::string> error;
+    };
+
+
+    static fs::path get_lock_path(const fs::path& path) {
+        return fs::path { path } += ".lock";
+    }
+
+
+    static void append_record(std::vector<std::byte>& dst, std::string_view key, std::span<const std::byte> contents) {
+        auto append = [&] (const void* src, std::size_t size) {
+            dst.insert(dst.end(), (const std::byte*) src, (const std::byte*) src + size);
+        };
+
+        const std::uint32_t key_size      = (std::uint32_t) key.size();
+        const std::uint64_t contents_size = contents.size();
+        const std::uint64_t checksum      = stable_hash(contents, stable_hash(key));
+
+        append(&RECORD_MAGIC, sizeof(RECORD_MAGIC));
+        append(&key_size, sizeof(key_size));
+        append(&contents_size, sizeof(contents_size));
+        append(&checksum, sizeof(checksum));
+        append(key.data(), key.size());
+        append(contents.data(), contents.size());
+    }
+
+
+    cache_database::cache_database(void) : path(*argument_parser::instance().get_argument<std::string>("cachedb")) {
+        // Caches are optional, so if the database cannot be read, objects are processed as if it were empty.
+        file_lock lock { get_lock_path(path), false };
+        auto error = lock.get_error() ? lock.get_error() : read_journal();
+
+        if (error) {
+            logger::instance().warning("Cache database ", path, " cannot be used and is ignored: ", *error);
+            disabled = true;
+
+            return;
+        }
+
+        logger::instance().verbose("Loaded ", records.size(), " object caches from ", path, ".");
+    }
+
+
+    std::optional<std::span<const std::byte>> cache_database::find(const fs::path& obj_path) const {
+        if (auto it = records.find(get_key(obj_path)); it != records.end()) return it->second.contents;
+        return std::nullopt;
+    }
+
+
+    void cache_database::insert(const fs::path& obj_path, std::vector<std::byte> contents) {
+        if (disabled) return;
+
+        auto key = get_key(obj_path);
+
+        std::lock_guard lock { pending_mtx };
+        pending.insert_or_assign(std::move(key), std::move(contents));
+    }
+
+
+    void cache_database::commit(void) {
+        if (pending.empty()) return;
+
+        // Failing to update the database only means the objects of this run have to be processed again next time.
+        auto error = commit_pending();
+        if (error) logger::instance().warning("Failed to update cache database ", path, ", the caches of this run are discarded: ", *error);
+
+        pending.clear();
+    }
+
+
+    std::optional<std::string> cache_database::commit_pending(void) {
+        file_lock lock { get_lock_path(path), true };
+        if (lock.get_error()) return lock.get_error();
+
+
+        // Other processes may have appended records since the database was read, in which case it has to be read again,
+        // both to not lose their records when compacting and to know where the journal ends.
+        std::error_code ec;
+        auto current_size = fs::exists(path, ec) ? fs::file_size(path, ec) : 0;
+
+        if (current_size != journal.size()) {
+            if (auto error = read_journal(); error) return error;
+        }
+
+
+        std::size_t pending_size = 0;
+        for (const auto& [key, contents] : pending) pending_size += RECORD_HEADER_SIZE + key.size() + contents.size();
+
+        std::size_t live_size = pending_size;
+        for (const auto& [key, record] : records) {
+            if (!pending.contains(key)) live_size += record.size;
+        }
+
+
+        // A journal that does not end in a valid record cannot be appended to, since records after the invalid one would not be found.
+        bool needs_rewrite = valid_size == 0 || valid_size != journal.size();
+        bool is_bloated    = valid_size + pending_size > (std::max)(2 * live_size, MIN_COMPACTION_SIZE);
+
+        return (needs_rewrite || is_bloated) ? compact() : append_records();
+    }
+
+
+    std::optional<std::string> cache_database::read_journal(void) {
+        journal.clear();
+        records.clear();
+        valid_size = 0;
+
+
+        std::error_code ec;
+        if (!fs::exists(path, ec)) return std::nullopt;
+
+        std::ifstream stream { path, std::ios::binary };
+        if (!stream) return "failed to open the database";
+
+        auto size = fs::file_size(path, ec);
+        if (ec) return stream_to_string("failed to get the size of the database: ", ec.message());
+
+        journal.resize(size);
+        stream.read((char*) journal.data(), (std::streamsize) journal.size());
+
+        if (!stream) {
+            journal.clear();
+            return "failed to read the database";
+        }
+
+
+        if (journal.size() < FILE_HEADER_SIZE || read_le<std::uint32_t>(journal, 0) != FORMAT_MAGIC || read_le<std::uint32_t>(journal, 4) != FORMAT_VERSION) {
+            logger::instance().warning("Cache database ", path, " is not a valid cache database or uses an older format, and will be replaced.");
+            return std::nullopt;
+        }
+
+        index_journal();
+
+        if (valid_size != journal.size()) {
+            logger::instance().verbose("Cache database ", path, " ends in an incomplete record, which will be discarded.");
+        }
+
+        return std::nullopt;
+    }
+
+
+    void cache_database::index_journal(void) {
+        records.clear();
+        std::size_t offset = FILE_HEADER_SIZE;
+
+        while (journal.size() - offset >= RECORD_HEADER_SIZE) {
+            auto magic         = read_le<std::uint32_t>(journal, offset);
+            auto key_size      = read_le<std::uint32_t>(journal, offset + 4);
+            auto contents_size = read_le<std::uint64_t>(journal, offset + 8);
+            auto checksum      = read_le<std::uint64_t>(journal, offset + 16);
+
+            std::size_t remaining = journal.size() - offset - RECORD_HEADER_SIZE;
+            if (magic != RECORD_MAGIC || key_size > remaining || contents_size > remaining - key_size) break;
+
+
+            std::span<const std::byte> record { journal.data() + offset, RECORD_HEADER_SIZE + key_size + contents_size };
+            std::string_view key { (const char*) record.data() + RECORD_HEADER_SIZE, key_size };
+            auto contents = record.subspan(RECORD_HEADER_SIZE + key_size);
+
+            if (stable_hash(contents, stable_hash(key)) != checksum) break;
+
+
+            records.insert_or_assign(std::string { key }, record_view { contents, record.size() });
+            offset += record.size();
+        }
+
+        valid_size = offset;
+    }
+
+
+    std::optional<std::string> cache_database::append_records(void) {
+        std::vector<std::byte> appended;
+        for (const auto& [key, contents] : pending) append_record(appended, key, contents);
+
+
+        {
+            std::ofstream stream { path, std::ios::binary | std::ios::app };
+            stream.write((const char*) appended.data(), (std::streamsize) appended.size());
+
+            // Records that were only partially appended fail their checksum, and are discarded by the next process to update the database.
+            if (!stream) return "failed to append to the database";
+        }
+
+
+        logger::instance().verbose("Appended ", pending.size(), " object caches to ", path, ".");
+
+        // Keep the in-memory copy of the journal up to date, so the database can still be used after committing.
+        journal.insert(journal.end(), appended.begin(), appended.end());
+        index_journal();
+
+        return std::nullopt;
+    }
+
+
+    std::optional<std::string> cache_database::compact(void) {
+        std::vector<std::byte> compacted;
+        compacted.insert(compacted.end(), (const std::byte*) &FORMAT_MAGIC, (const std::byte*) &FORMAT_MAGIC + sizeof(FORMAT_MAGIC));
+        compacted.insert(compacted.end(), (const std::byte*) &FORMAT_VERSION, (const std::byte*) &FORMAT_VERSION + sizeof(FORMAT_VERSION));
+
+        std::size_t count = 0;
+
+        for (const auto& [key, record] : records) {
+            if (pending.contains(key)) continue;
+
+            append_record(compacted, key, record.contents);
+            ++count;
+        }
+
+        for (const auto& [key, contents] : pending) {
+            append_record(compacted, key, contents);
+            ++count;
+        }
+
+
+        fs::path temp_path = fs::path { path } += ".tmp";
+
+        bool written;
+
+        {
+            std::ofstream stream { temp_path, std::ios::binary | std::ios::trunc };
+            stream.write((const char*) compacted.data(), (std::streamsize) compacted.size());
+
+            written = (bool) stream;
+        }
+
+        std::error_code ec;
+        if (written) fs::rename(temp_path, path, ec);
+
+        if (!written || ec) {
+            auto error = written ? stream_to_string("failed to replace the database: ", ec.message()) : stream_to_string("failed to write to ", temp_path);
+            fs::remove(temp_path, ec);
+
+            return error;
+        }
+
+        logger::instance().verbose("Compacted ", path, " to ", count, " object caches (", journal.size(), " -> ", compacted.size(), " bytes).");
+
+
+        journal = std::move(compacted);
+        index_journal();
+
+        return std::nullopt;
+    }
+
+
+    std::string cache_database::get_key(const fs::path& obj_path) {
+        return fs::absolute(obj_path).lexically_normal().generic_string();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+
+namespace symgen {
+    // Single project-wide cache file, used instead of one .objcache file per object if -cachedb is provided.
+    //
+    // The database is an append-only journal of records, each containing the path of an object and its cache (in the .objcache format).
+    // The last record for a path is the current one. Every record is checksummed, so a record that was only partially written
+    // (e.g. because the process was killed) is ignored, rather than corrupting the database.
+    // Like .objcache files, the database is optional: if it cannot be read, it is ignored, and if it cannot be updated, the new caches are discarded.
+    // Access from multiple processes is synchronized through a lock file next to the database: the database is read under a shared lock,
+    // and new records are appended under an exclusive lock. Once most of the database consists of outdated records, it is compacted
+    // by writing the current records to a new file and replacing the database with it.
+    class cache_database {
+    public:
+        constexpr static std::uint32_t FORMAT_MAGIC   = 0x44434753; // "SGCD"
+        constexpr static std::uint32_t FORMAT_VERSION = 1;
+
+
+        // Opens the database given by the -cachedb argument.
+        static cache_database& instance(void) {
+            static cache_database i;
+            return i;
+        }
+
+
+        // Returns the cache for the given object, if there is one. Safe to call concurrently with insert().
+        [[nodiscard]] std::optional<std::span<const std::byte>> find(const fs::path& obj_path) const;
+
+        // Stores a new cache for the given object. Changes are only written to disk once commit() is called. Safe to call concurrently.
+        void insert(const fs::path& obj_path, std::vector<std::byte> contents);
+
+        // Writes all inserted caches to the database, and compacts it if required.
+        // If the database cannot be updated, a warning is logged and the inserted caches are discarded.
+        // Must not be called concurrently with other methods, as caches returned from find() are invalidated.
+        void commit(void);
+    private:
+        struct record_view {
+            std::span<const std::byte> contents;
+            // Size of the record within the journal, including its header.
+            std::size_t size;
+        };
+
+
+        fs::path path;
+
+        // The database is read into memory entirely, so no handles to it are kept open that would prevent other processes from updating it.
+        std::vector<std::byte> journal;
+        std::size_t valid_size = 0;
+        hash_map<std::string, record_view> records;
+
+        std::mutex pending_mtx;
+        hash_map<std::string, std::vector<std::byte>> pending;
+
+        // Set if the database could not be read, in which case it is not used at all.
+        bool disabled = false;
+
+
+        cache_database(void);
+
+        // These methods return a description of the error if they fail.
+        std::optional<std::string> commit_pending(void);
+        std::optional<std::string> read_journal(void);
+        void index_journal(void);
+        std::optional<std::string> append_records(void);
+        std::optional<std::string> compact(void);
+
+        static std::string get_key(const fs::path& obj_path);
+    };
+}
\ No newline at end of file
@@ -0,0 +1,271 @@
+#include <SymbolGenerator/coff_reader.hpp>
+#include <SymbolGenerator/utility.hpp>
+
+#include <array>
+#include <cstring>
+#include <variant>
+
+
+namespace symgen {
+    // Layout of the different headers and records, see https://learn.microsoft.com/en-us/windows/win32/debug/pe-format.
+    constexpr std::size_t FILE_HEADER_SIZE        = 20;
+    constexpr std::size_t BIGOBJ_FILE_HEADER_SIZE = 56;
+    constexpr std::size_t SECTION_HEADER_SIZE     = 40;
+    constexpr std::size_t SYMBOL_SIZE             = 18;
+    constexpr std::size_t BIGOBJ_SYMBOL_SIZE      = 20;
+
+    // ClassID of ANON_OBJECT_HEADER_BIGOBJ, used to tell /bigobj objects apart from other anonymous objects (import objects, LTCG objects).
+    constexpr std::array<std::uint8_t, 16> BIGOBJ_CLASS_ID {
+        0xC7, 0xA1, 0xBA, 0xD1, 0xEE, 0xBA, 0xA9, 0x4B,
+        0xAF, 0x20, 0xFA, 0xF6, 0x6A, 0xA4, 0xDC, 0xB8
+    };
+
+
+    // Length of a string that is null-terminated, unless it is exactly max_length characters long.
+    static std::size_t bounded_strlen(const char* str, std::size_t max_length) {
+        const void* terminator = std::memchr(str, '\0', max_length);
+        return terminator ? (std::size_t) ((const char*) terminator - str) : max_length;
+    }
+
+
+    coff_reader::coff_reader(const fs::path& path) : file(path), segments { { 0, file.data() } }, file_size(file.data().size()), error(file.get_error()) {
+        if (!error) parse_headers();
+    }
+
+
+    coff_reader::coff_reader(std::span<const std::byte> contents) : segments { { 0, contents } }, file_size(contents.size()) {
+        parse_headers();
+    }
+
+
+    coff_reader::coff_reader(std::vector<segment> segments, std::size_t file_size) : segments(std::move(segments)), file_size(file_size) {
+        parse_headers();
+    }
+
+
+    // Fields of the file header that describe where the tables are stored.
+    struct file_header {
+        bool bigobj;
+        std::uint16_t machine;
+        std::uint32_t section_count;
+        std::uint32_t symbol_count;
+        std::size_t section_table_offset;
+        std::size_t symbol_table_offset;
+        std::size_t symbol_size;
+    };
+
+
+    // Reads the header at the start of the given data, or returns an error message if it is not a header this reader understands.
+    static std::variant<file_header, std::string> read_file_header(std::span<const std::byte> data) {
+        if (data.size() < FILE_HEADER_SIZE) return "file is too small to be an object file";
+
+
+        auto sig1 = read_le<std::uint16_t>(data, 0);
+        auto sig2 = read_le<std::uint16_t>(data, 2);
+
+        if (sig1 == 0 && sig2 == 0xFFFF) {
+            // Anonymous object header. Only /bigobj objects contain a symbol table, other anonymous objects (e.g. /GL objects) are not COFF files.
+            bool is_bigobj_header =
+                data.size() >= BIGOBJ_FILE_HEADER_SIZE &&
+                read_le<std::uint16_t>(data, 4) >= 2 &&
+                std::memcmp(data.data() + 12, BIGOBJ_CLASS_ID.data(), BIGOBJ_CLASS_ID.size()) == 0;
+
+            if (!is_bigobj_header) return "file is an anonymous object (e.g. compiled with /GL) and has no COFF symbol table";
+
+            return file_header {
+                .bigobj               = true,
+                .machine              = read_le<std::uint16_t>(data, 6),
+                .section_count        = read_le<std::uint32_t>(data, 44),
+                .symbol_count         = read_le<std::uint32_t>(data, 52),
+                .section_table_offset = BIGOBJ_FILE_HEADER_SIZE,
+                .symbol_table_offset  = read_le<std::uint32_t>(data, 48),
+                .symbol_size          = BIGOBJ_SYMBOL_SIZE
+            };
+        } else {
+            return file_header {
+                .bigobj               = false,
+                .machine              = sig1,
+                .section_count        = read_le<std::uint16_t>(data, 2),
+                .symbol_count         = read_le<std::uint32_t>(data, 12),
+                .section_table_offset = FILE_HEADER_SIZE + read_le<std::uint16_t>(data, 16),
+                .symbol_table_offset  = read_le<std::uint32_t>(data, 8),
+                .symbol_size          = SYMBOL_SIZE
+            };
+        }
+    }
+
+
+    std::vector<coff_reader::byte_range> coff_reader::get_table_ranges(std::span<const std::byte> header, std::size_t file_size) {
+        auto fields = read_file_header(header);
+        if (!std::holds_alternative<file_header>(fields)) return { };
+
+        const auto& fh = std::get<file_header>(fields);
+        std::vector<byte_range> result;
+
+
+        // Tables that extend past the end of the file are rejected by the reader before it accesses them, so they are not needed either.
+        const std::size_t section_table_size = (std::size_t) fh.section_count * SECTION_HEADER_SIZE;
+        if (fh.section_table_offset + section_table_size > file_size) return result;
+
+        result.push_back({ fh.section_table_offset, section_table_size });
+
+
+        // The string table directly follows the symbol table, and is usually the last thing in the file, so both are read up to the end of the file.
+        if (fh.symbol_count > 0 && fh.symbol_table_offset + (std::size_t) fh.symbol_count * fh.symbol_size <= file_size) {
+            result.push_back({ fh.symbol_table_offset, file_size - fh.symbol_table_offset });
+        }
+
+        return result;
+    }
+
+
+    std::optional<std::span<const std::byte>> coff_reader::get_range(std::size_t offset, std::size_t size) const {
+        for (const auto& segment : segments) {
+            if (offset >= segment.offset && offset - segment.offset <= segment.data.size() && size <= segment.data.size() - (offset - segment.offset)) {
+                return segment.data.subspan(offset - segment.offset, size);
+            }
+        }
+
+        return std::nullopt;
+    }
+
+
+    void coff_reader::parse_headers(void) {
+        auto fields = read_file_header(segments.empty() ? std::span<const std::byte> { } : segments[0].data);
+
+        if (auto* message = std::get_if<std::string>(&fields); message) {
+            error = std::move(*message);
+            return;
+        }
+
+
+        const auto& fh = std::get<file_header>(fields);
+
+        bigobj        = fh.bigobj;
+        machine       = fh.machine;
+        section_count = fh.section_count;
+        symbol_count  = fh.symbol_count;
+        symbol_size   = fh.symbol_size;
+
+        const std::size_t section_table_offset = fh.section_table_offset;
+        const std::size_t symbol_table_offset  = fh.symbol_table_offset;
+
+        header_data = segments[0].data.first(bigobj ? BIGOBJ_FILE_HEADER_SIZE : FILE_HEADER_SIZE);
+
+
+        // Validate every table lies within the file, so reading from them later doesn't require bounds checks.
+        if (section_table_offset + (std::size_t) section_count * SECTION_HEADER_SIZE > file_size) {
+            error = "section table extends past the end of the file";
+            return;
+        }
+
+        if (auto range = get_range(section_table_offset, (std::size_t) section_count * SECTION_HEADER_SIZE); range) {
+            section_headers = *range;
+        } else {
+            error = "section table was not read";
+            return;
+        }
+
+
+        if (symbol_count == 0) return;
+
+        if (symbol_table_offset + (std::size_t) symbol_count * symbol_size > file_size) {
+            error = "symbol table extends past the end of the file";
+            return;
+        }
+
+        if (auto range = get_range(symbol_table_offset, (std::size_t) symbol_count * symbol_size); range) {
+            symbol_table = *range;
+        } else {
+            error = "symbol table was not read";
+            return;
+        }
+
+
+        // The string table directly follows the symbol table. Its first four bytes contain its size, including the size field itself.
+        std::size_t string_table_offset = symbol_table_offset + symbol_table.size();
+
+        if (string_table_offset + sizeof(std::uint32_t) <= file_size) {
+            auto size_field = get_range(string_table_offset, sizeof(std::uint32_t));
+
+            if (!size_field) {
+                error = "string table was not read";
+                return;
+            }
+
+            std::size_t string_table_size = read_le<std::uint32_t>(*size_field, 0);
+
+            if (string_table_offset + string_table_size > file_size) {
+                error = "string table extends past the end of the file";
+                return;
+            }
+
+            if (auto range = get_range(string_table_offset, string_table_size); range) {
+                string_table = *range;
+            } else {
+                error = "string table was not read";
+                return;
+            }
+        }
+    }
+
+
+    std::uint64_t coff_reader::hash_tables(void) const {
+        std::uint64_t result = stable_hash(header_data);
+
+        for (auto table : { section_headers, symbol_table, string_table }) result = stable_hash(table, result);
+        return result;
+    }
+
+
+    std::uint32_t coff_reader::get_section_flags(std::int32_t section_number) const {
+        // Section numbers are one-based, zero and negative numbers have special meanings (undefined, absolute, debug).
+        if (section_number <= 0 || (std::uint32_t) section_number > section_count) return 0;
+
+        return read_le<std::uint32_t>(section_headers, (std::size_t) (section_number - 1) * SECTION_HEADER_SIZE + 36);
+    }
+
+
+    coff_symbol coff_reader::read_symbol(std::uint32_t record, std::uint32_t index) const {
+        auto entry = symbol_table.subspan((std::size_t) record * symbol_size, symbol_size);
+        coff_symbol result;
+
+
+        // Names of up to eight characters are stored inline (and are not null-terminated if they are exactly eight characters long),
+        // longer names are stored as an offset into the string table, prefixed by four zero bytes.
+        if (read_le<std::uint32_t>(entry, 0) == 0) {
+            std::size_t offset = read_le<std::uint32_t>(entry, 4);
+
+            if (offset < string_table.size()) {
+                const char* begin = (const char*) string_table.data() + offset;
+                result.name = std::string_view { begin, bounded_strlen(begin, string_table.size() - offset) };
+            }
+        } else {
+            const char* begin = (const char*) entry.data();
+            result.name = std::string_view { begin, bounded_strlen(begin, 8) };
+        }
+
+
+        result.value = read_le<std::uint32_t>(entry, 8);
+
+        if (bigobj) {
+            result.section_number = read_le<std::int32_t>(entry, 12);
+            result.type           = read_le<std::uint16_t>(entry, 16);
+            result.storage_class  = read_le<std::uint8_t>(entry, 18);
+            result.aux_count      = read_le<std::uint8_t>(entry, 19);
+        } else {
+            result.section_number = read_le<std::int16_t>(entry, 12);
+            result.type           = read_le<std::uint16_t>(entry, 14);
+            result.storage_class  = read_le<std::uint8_t>(entry, 16);
+            result.aux_count      = read_le<std::uint8_t>(entry, 17);
+        }
+
+        result.index = index;
+        return result;
+    }
+
+
+    std::uint8_t coff_reader::read_aux_count(std::uint32_t record) const {
+        return read_le<std::uint8_t>(symbol_table, (std::size_t) record * symbol_size + symbol_size - 1);
+    }
+}
\ No newline at end of file
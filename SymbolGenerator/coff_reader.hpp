@@ -0,0 +1,151 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+#include <SymbolGenerator/mapped_file.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace symgen {
+    // Names are chosen to not collide with the IMAGE_* macros from Windows.h.
+    constexpr std::int32_t SYMBOL_SECTION_UNDEFINED = 0;
+    constexpr std::int32_t SYMBOL_SECTION_ABSOLUTE  = -1;
+    constexpr std::int32_t SYMBOL_SECTION_DEBUG     = -2;
+
+    constexpr std::uint16_t SYMBOL_TYPE_NULL      = 0x0000;
+    constexpr std::uint16_t SYMBOL_DTYPE_FUNCTION = 0x0002;
+
+
+    // A single (non-auxiliary) entry of the symbol table of an object file.
+    // The name refers directly into the mapped object file, so the symbol cannot outlive the reader it came from.
+    struct coff_symbol {
+        std::string_view name;
+        std::uint32_t value;
+        std::int32_t section_number;
+        std::uint16_t type;
+        std::uint8_t storage_class;
+        std::uint8_t aux_count;
+
+        // Index of this symbol among all non-auxiliary symbols in the symbol table.
+        std::uint32_t index;
+    };
+
+
+    // Reads the symbol table of a COFF object file (both regular and /bigobj objects) directly from a memory mapping of the file.
+    // Only the file header, section headers, symbol table and string table are ever accessed, so the raw data of sections is never read from disk,
+    // and objects that are read ahead by a read_queue only have to keep those parts in memory.
+    class coff_reader {
+    public:
+        class symbol_iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = coff_symbol;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = const coff_symbol*;
+            using reference         = coff_symbol;
+
+            symbol_iterator(void) = default;
+            symbol_iterator(const coff_reader* reader, std::uint32_t record, std::uint32_t index) : reader(reader), record(record), index(index) {}
+
+            coff_symbol operator*(void) const { return reader->read_symbol(record, index); }
+
+            symbol_iterator& operator++(void) {
+                // Never step past the end, even if the auxiliary symbol count of the last symbol is corrupt.
+                // (std::min is parenthesized to prevent expansion of the min macro from Windows.h.)
+                record  = (std::min)(record + 1 + reader->read_aux_count(record), reader->symbol_count);
+                index  += 1;
+
+                return *this;
+            }
+
+            symbol_iterator operator++(int) { auto copy = *this; ++(*this); return copy; }
+
+            bool operator==(const symbol_iterator& other) const { return record == other.record; }
+        private:
+            const coff_reader* reader = nullptr;
+            std::uint32_t record = 0, index = 0;
+        };
+
+
+        // Part of an object file, in bytes from the start of the file.
+        struct byte_range {
+            std::size_t offset;
+            std::size_t size;
+        };
+
+
+        // Part of an object file that is in memory, for objects of which only some parts were read.
+        struct segment {
+            std::size_t offset;
+            std::span<const std::byte> data;
+        };
+
+
+        explicit coff_reader(const fs::path& path);
+        // Reads an object that is already in memory, e.g. a member of an archive. The contents must outlive the reader.
+        explicit coff_reader(std::span<const std::byte> contents);
+        // Reads an object of which only some parts are in memory, e.g. one that was prefetched by a read_queue. The segments must outlive the reader.
+        // The first segment must start at the start of the file, and every table must lie within a single segment (see get_table_ranges).
+        coff_reader(std::vector<segment> segments, std::size_t file_size);
+
+
+        // Returns an error message if the file is not an object file this reader understands, or nullopt otherwise.
+        [[nodiscard]] const std::optional<std::string>& get_error(void) const { return error; }
+
+        [[nodiscard]] std::uint16_t get_machine(void) const { return machine; }
+        [[nodiscard]] bool is_bigobj(void) const { return bigobj; }
+        // Size of the object file, including any parts that are not in memory.
+        [[nodiscard]] std::size_t get_file_size(void) const { return file_size; }
+        // Number of entries in the symbol table, including auxiliary entries.
+        [[nodiscard]] std::uint32_t get_symbol_table_size(void) const { return symbol_count; }
+
+        // Returns the characteristics of the section with the given (one-based) section number, or zero if there is no such section.
+        [[nodiscard]] std::uint32_t get_section_flags(std::int32_t section_number) const;
+
+        // Hash of the file header, section table, symbol table and string table, i.e. of everything the reader accesses.
+        // Computing it does not read the raw data of any section.
+        [[nodiscard]] std::uint64_t hash_tables(void) const;
+
+        [[nodiscard]] symbol_iterator begin(void) const { return { this, 0, 0 }; }
+        [[nodiscard]] symbol_iterator end(void) const { return { this, symbol_count, 0 }; }
+
+
+        // Returns the parts of an object file of the given size that a reader accesses besides its header, given the first bytes of the file
+        // (the first few KiB, or all of it if it is smaller). These are the section table, and the symbol table followed by the string table.
+        // Returns nothing if the file is not an object file this reader understands, in which case the reader only looks at the header.
+        [[nodiscard]] static std::vector<byte_range> get_table_ranges(std::span<const std::byte> header, std::size_t file_size);
+    private:
+        mapped_file file;
+        std::vector<segment> segments;
+        std::size_t file_size = 0;
+        std::optional<std::string> error;
+
+        std::uint16_t machine = 0;
+        bool bigobj = false;
+
+        std::span<const std::byte> header_data;
+        std::span<const std::byte> section_headers;
+        std::uint32_t section_count = 0;
+
+        std::span<const std::byte> symbol_table;
+        std::uint32_t symbol_count = 0;
+        std::size_t symbol_size = 0;
+
+        std::span<const std::byte> string_table;
+
+
+        void parse_headers(void);
+        // Returns the given part of the file, or nothing if it is not in memory.
+        std::optional<std::span<const std::byte>> get_range(std::size_t offset, std::size_t size) const;
+        coff_symbol read_symbol(std::uint32_t record, std::uint32_t index) const;
+        std::uint8_t read_aux_count(std::uint32_t record) const;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+#include <SymbolGenerator/utility.hpp>
+
+#include <array>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+
+
+namespace symgen {
+    // Hash map that can be accessed concurrently from many threads.
+    // The map is split into a fixed number of shards, each protected by its own lock, so threads only contend if they access the same shard.
+    // Values are returned by copy, since references into a shard could be invalidated as soon as its lock is released.
+    template <typename K, typename V, std::size_t Shards = 64, typename Hash = default_hash<K>, typename Eq = default_eq<K>>
+    class concurrent_hash_map {
+    public:
+        // Lookup supports any type the hasher and comparator accept, e.g. std::string_view for std::string keys.
+        template <typename Q> [[nodiscard]] std::optional<V> find(const Q& key) const {
+            auto hash = Hash { }(key);
+            const auto& s = get_shard(hash);
+
+            std::shared_lock lock { s.mtx };
+
+            if (auto it = s.map.find(key); it != s.map.end()) return it->second;
+            return std::nullopt;
+        }
+
+
+        // Inserts the value if the key is not present yet. Returns the value that is in the map afterwards.
+        template <typename Q, typename... Args> V try_emplace(const Q& key, Args&&... args) {
+            auto hash = Hash { }(key);
+            auto& s = get_shard(hash);
+
+            std::unique_lock lock { s.mtx };
+
+            if (auto it = s.map.find(key); it != s.map.end()) return it->second;
+            return s.map.try_emplace(K { key }, std::forward<Args>(args)...).first->second;
+        }
+
+
+        // Reserves space for the given number of elements in total, spread evenly over all shards.
+        void reserve(std::size_t count) {
+            for (auto& s : shards) {
+                std::unique_lock lock { s.mtx };
+                s.map.reserve(count / Shards + 1);
+            }
+        }
+
+
+        // Not safe to call concurrently with other methods.
+        void clear(void) {
+            for (auto& s : shards) s.map.clear();
+        }
+
+
+        [[nodiscard]] std::size_t size(void) const {
+            std::size_t result = 0;
+
+            for (const auto& s : shards) {
+                std::shared_lock lock { s.mtx };
+                result += s.map.size();
+            }
+
+            return result;
+        }
+    private:
+        struct shard {
+            mutable std::shared_mutex mtx;
+            hash_map<K, V, Hash, Eq> map;
+        };
+
+        std::array<shard, Shards> shards;
+
+
+        const shard& get_shard(std::size_t hash) const { return shards[get_shard_index<Shards>(hash)]; }
+        shard& get_shard(std::size_t hash) { return shards[get_shard_index<Shards>(hash)]; }
+    };
+}
\ No newline at end of file
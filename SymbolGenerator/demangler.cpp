@@ -0,0 +1,1093 @@
+#include <SymbolGenerator/demangler.hpp>
+#include <SymbolGenerator/defs.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+
+// Demangler for the MSVC C++ name mangling scheme.
+// The grammar follows the one used by LLVM's MicrosoftDemangle (https://github.com/llvm/llvm-project/blob/main/llvm/lib/Demangle/MicrosoftDemangle.cpp),
+// but output is formatted the way DbgHelp's undname formats it (e.g. "class std::vector<int,class std::allocator<int> >"),
+// since users write their filters against that format.
+namespace symgen {
+    namespace {
+        // Thrown when the mangled name is malformed or uses an unsupported construct. Never escapes demangle_msvc_name.
+        struct demangle_error {};
+
+
+        // Names and function parameter types that can be referred to by a single digit later in the mangled name.
+        struct backref_table {
+            std::array<std::string, 10> names;
+            std::size_t name_count = 0;
+
+            std::array<std::string, 10> types;
+            std::size_t type_count = 0;
+        };
+
+
+        // Rendered type. Function types keep their parts separate, since pointers to them are rendered inside the function type.
+        struct rendered_type {
+            std::string text;
+
+            bool is_function = false;
+            std::string return_type {}, calling_convention {}, parameters {}, this_qualifiers {};
+
+            // Arrays keep their element type, since pointers to them are rendered between the element type and the dimensions.
+            bool is_array = false;
+            std::string element_type {}, dimensions {};
+
+            // Pointers and references. Pointers to functions and arrays are nested, i.e. a declared name goes inside the type rather than after it.
+            bool is_pointer = false, is_nested_pointer = false;
+        };
+
+
+        // Special names that are written as a ? followed by a code, except for constructors, destructors, conversion operators,
+        // and the names that are followed by another symbol or type (dynamic initializers and RTTI data structures).
+        struct op { std::string_view code, name; };
+
+        constexpr std::array operators {
+            op { "2",  "operator new"     }, op { "3",  "operator delete"  }, op { "4",  "operator="        },
+            op { "5",  "operator>>"       }, op { "6",  "operator<<"       }, op { "7",  "operator!"        },
+            op { "8",  "operator=="       }, op { "9",  "operator!="       }, op { "A",  "operator[]"       },
+            op { "C",  "operator->"       }, op { "D",  "operator*"        }, op { "E",  "operator++"       },
+            op { "F",  "operator--"       }, op { "G",  "operator-"        }, op { "H",  "operator+"        },
+            op { "I",  "operator&"        }, op { "J",  "operator->*"      }, op { "K",  "operator/"        },
+            op { "L",  "operator%"        }, op { "M",  "operator<"        }, op { "N",  "operator<="       },
+            op { "O",  "operator>"        }, op { "P",  "operator>="       }, op { "Q",  "operator,"        },
+            op { "R",  "operator()"       }, op { "S",  "operator~"        }, op { "T",  "operator^"        },
+            op { "U",  "operator|"        }, op { "V",  "operator&&"       }, op { "W",  "operator||"       },
+            op { "X",  "operator*="       }, op { "Y",  "operator+="       }, op { "Z",  "operator-="       },
+            op { "_0", "operator/="       }, op { "_1", "operator%="       }, op { "_2", "operator>>="      },
+            op { "_3", "operator<<="      }, op { "_4", "operator&="       }, op { "_5", "operator|="       },
+            op { "_6", "operator^="       }, op { "_U", "operator new[]"   }, op { "_V", "operator delete[]" },
+            op { "__L", "operator co_await" }, op { "__M", "operator<=>"    },
+
+            op { "_7", "`vftable'" },
+            op { "_8", "`vbtable'" },
+            op { "_9", "`vcall'" },
+            op { "_A", "`typeof'" },
+            op { "_B", "`local static guard'" },
+            op { "_D", "`vbase destructor'" },
+            op { "_E", "`vector deleting destructor'" },
+            op { "_F", "`default constructor closure'" },
+            op { "_G", "`scalar deleting destructor'" },
+            op { "_H", "`vector constructor iterator'" },
+            op { "_I", "`vector destructor iterator'" },
+            op { "_J", "`vector vbase constructor iterator'" },
+            op { "_K", "`virtual displacement map'" },
+            op { "_L", "`eh vector constructor iterator'" },
+            op { "_M", "`eh vector destructor iterator'" },
+            op { "_N", "`eh vector vbase constructor iterator'" },
+            op { "_O", "`copy constructor closure'" },
+            op { "_S", "`local vftable'" },
+            op { "_T", "`local vftable constructor closure'" },
+            op { "_X", "`placement delete closure'" },
+            op { "_Y", "`placement delete[] closure'" },
+            op { "__A", "`managed vector constructor iterator'" },
+            op { "__B", "`managed vector destructor iterator'" },
+            op { "__C", "`eh vector copy constructor iterator'" },
+            op { "__D", "`eh vector vbase copy constructor iterator'" },
+            op { "__G", "`vector copy constructor iterator'" },
+            op { "__H", "`vector vbase copy constructor iterator'" },
+            op { "__I", "`managed vector copy constructor iterator'" },
+            op { "__J", "`local static thread guard'" }
+        };
+
+
+        // Returns the special name at the start of the input, if any.
+        const op* find_operator(std::string_view input) {
+            // Longest codes are checked first, so e.g. __L is not mistaken for _L.
+            for (std::size_t length : { 3, 2, 1 }) {
+                for (const auto& candidate : operators) {
+                    if (candidate.code.size() == length && input.starts_with(candidate.code)) return &candidate;
+                }
+            }
+
+            return nullptr;
+        }
+
+
+        class msvc_demangler {
+        public:
+            explicit msvc_demangler(std::string_view input) : input(input) {}
+
+
+            // Demangles a full symbol, returning only its qualified name.
+            // If consume_encoding is set, the type encoding of the symbol is consumed as well,
+            // which is required when the symbol is nested inside another name.
+            std::string symbol(bool consume_encoding) {
+                recursion_guard guard { *this };
+                expect('?');
+
+                // Names that are too long are replaced by a hash, these can't be demangled.
+                if (starts_with("?@")) throw demangle_error { };
+
+                // String literals: the rest of the name is an encoding of the string contents.
+                if (starts_with("?_C@_")) {
+                    input = { };
+                    return "`string'";
+                }
+
+
+                special_name special;
+                std::string qualified = qualified_name(special);
+
+
+                if (consume_encoding || special.kind == special_name::CONVERSION) {
+                    std::string return_type = encoding();
+
+                    if (special.kind == special_name::CONVERSION) {
+                        if (return_type.empty()) throw demangle_error { };
+                        qualified += " " + return_type;
+                    }
+                }
+
+                return qualified;
+            }
+
+        private:
+            std::string_view input;
+            backref_table backrefs;
+
+
+            // Names can nest arbitrarily deep, so recursion is limited to prevent malformed names from overflowing the stack.
+            std::size_t depth = 0;
+
+            struct recursion_guard {
+                msvc_demangler& self;
+
+                explicit recursion_guard(msvc_demangler& self) : self(self) {
+                    if (++self.depth > 256) throw demangle_error { };
+                }
+
+                ~recursion_guard(void) { --self.depth; }
+            };
+
+
+            struct special_name {
+                enum { NONE, CONSTRUCTOR, DESTRUCTOR, CONVERSION, TYPE_DESCRIPTOR } kind = NONE;
+                std::string type;
+            };
+
+
+            // Fully qualified name of a symbol, after the leading ? has been consumed.
+            std::string qualified_name(special_name& special) {
+                std::string name = first_name(special);
+
+                std::vector<std::string> scopes = scope_list();
+                std::string qualified;
+
+                // RTTI type descriptors name a type rather than a scope.
+                if (special.kind == special_name::TYPE_DESCRIPTOR) {
+                    qualified = special.type + " " + name;
+                } else {
+                    for (const auto& scope : scopes | views::reverse) {
+                        qualified += scope;
+                        qualified += "::";
+                    }
+
+                    if (special.kind == special_name::CONSTRUCTOR || special.kind == special_name::DESTRUCTOR) {
+                        if (scopes.empty()) throw demangle_error { };
+
+                        name = (special.kind == special_name::DESTRUCTOR ? "~" : "") + scopes.front() + name;
+                    }
+
+                    qualified += name;
+                }
+
+                return qualified;
+            }
+
+
+            // Demangles a symbol that a template argument refers to. Unlike the symbol itself, these are rendered as a full declaration,
+            // e.g. $1?x@A@@2HA -> public: static int A::x, the way undname prints them even when only the name is requested.
+            std::string declaration(void) {
+                recursion_guard guard { *this };
+                expect('?');
+
+                if (starts_with("?@") || starts_with("?_C@_")) throw demangle_error { };
+
+
+                special_name special;
+                std::string name = qualified_name(special);
+
+                if (input.empty()) throw demangle_error { };
+                char c = next();
+
+
+                // Variables.
+                if (c >= '0' && c <= '4') {
+                    constexpr std::array storage_classes { "private: static "sv, "protected: static "sv, "public: static "sv, ""sv, ""sv };
+
+                    auto variable = type();
+                    if (variable.is_function || variable.is_nested_pointer) throw demangle_error { };
+
+                    while (consume('E') || consume('I') || consume('F'));
+                    std::string qualifiers = cv_qualifiers();
+
+                    // The qualifiers of pointers are part of their type already.
+                    if (variable.is_pointer) qualifiers.clear();
+
+                    return std::string { storage_classes[(std::size_t) (c - '0')] } + variable.text + qualifiers + " " + name;
+                }
+
+
+                // Virtual function and base tables, optionally followed by the base class the table is for.
+                if (c == '6' || c == '7') {
+                    std::string qualifiers = cv_qualifiers();
+                    std::string result = (qualifiers.empty() ? "" : qualifiers.substr(1) + " ") + name;
+
+                    while (!consume('@')) result += "{for `" + type_name() + "'}";
+                    return result;
+                }
+
+
+                if (c == '8' || c == '9') return name;
+
+
+                // Functions. Thunks and functions with a virtual this-adjustment are not supported.
+                if (c < 'A' || c > 'Z') throw demangle_error { };
+
+                constexpr std::array access_specifiers { "private: "sv, "protected: "sv, "public: "sv };
+
+                std::string prefix;
+                bool has_this = true;
+
+                if (c == 'Y' || c == 'Z') {
+                    has_this = false;
+                } else {
+                    const std::size_t kind = (std::size_t) (c - 'A') % 8 / 2;
+                    if (kind == 3) throw demangle_error { };
+
+                    prefix = access_specifiers[(std::size_t) (c - 'A') / 8];
+
+                    if (kind == 1) {
+                        prefix += "static ";
+                        has_this = false;
+                    }
+
+                    if (kind == 2) prefix += "virtual ";
+                }
+
+
+                auto function = function_type(has_this);
+
+                if (special.kind == special_name::CONVERSION) {
+                    name += " " + function.return_type;
+                } else if (!function.return_type.empty()) {
+                    prefix += function.return_type + " ";
+                }
+
+                return prefix + function.calling_convention + " " + name + "(" + function.parameters + ")" + function.this_qualifiers;
+            }
+
+
+            // --- Input helpers ---------------------------------------------------------------------------------------
+
+
+            bool starts_with(std::string_view prefix) const { return input.starts_with(prefix); }
+            bool starts_with_digit(void) const { return !input.empty() && input.front() >= '0' && input.front() <= '9'; }
+
+            bool consume(std::string_view prefix) {
+                if (!input.starts_with(prefix)) return false;
+
+                input.remove_prefix(prefix.size());
+                return true;
+            }
+
+            bool consume(char c) {
+                if (!input.starts_with(c)) return false;
+
+                input.remove_prefix(1);
+                return true;
+            }
+
+            void expect(char c) {
+                if (!consume(c)) throw demangle_error { };
+            }
+
+            char next(void) {
+                if (input.empty()) throw demangle_error { };
+
+                char c = input.front();
+                input.remove_prefix(1);
+                return c;
+            }
+
+
+            // Numbers are encoded either as a single digit (representing the digit plus one),
+            // or as a sequence of hexadecimal digits using the letters A-P, terminated by an @. A leading ? negates the number.
+            std::int64_t number(void) {
+                bool negative = consume('?');
+
+                if (starts_with_digit()) {
+                    std::int64_t result = next() - '0' + 1;
+                    return negative ? -result : result;
+                }
+
+
+                std::uint64_t result = 0;
+
+                while (!consume('@')) {
+                    char c = next();
+                    if (c < 'A' || c > 'P') throw demangle_error { };
+
+                    result = (result << 4) | (std::uint64_t) (c - 'A');
+                }
+
+                return negative ? -(std::int64_t) result : (std::int64_t) result;
+            }
+
+
+            // --- Backreferences --------------------------------------------------------------------------------------
+
+
+            void memorize_name(const std::string& name) {
+                // Only the first ten names can be referred to.
+                if (backrefs.name_count < backrefs.names.size()) {
+                    for (std::size_t i = 0; i < backrefs.name_count; ++i) {
+                        if (backrefs.names[i] == name) return;
+                    }
+
+                    backrefs.names[backrefs.name_count++] = name;
+                }
+            }
+
+            std::string name_backref(void) {
+                std::size_t index = (std::size_t) (next() - '0');
+                if (index >= backrefs.name_count) throw demangle_error { };
+
+                return backrefs.names[index];
+            }
+
+
+            // --- Names -----------------------------------------------------------------------------------------------
+
+
+            // Simple identifier, terminated by an @.
+            std::string simple_name(bool memorize) {
+                auto end = input.find('@');
+                if (end == 0 || end == std::string_view::npos) throw demangle_error { };
+
+                std::string result { input.substr(0, end) };
+                input.remove_prefix(end + 1);
+
+                if (memorize) memorize_name(result);
+                return result;
+            }
+
+
+            // The unqualified name of the symbol itself. This can be a special name like an operator or constructor.
+            std::string first_name(special_name& special) {
+                if (starts_with("?$")) return template_name(false, &special);
+                if (consume('?')) return operator_name(special);
+                if (starts_with_digit()) return name_backref();
+
+                return simple_name(true);
+            }
+
+
+            // Name of a template instantiation, e.g. ?$vector@HV?$allocator@H@std@@@ -> vector<int,class std::allocator<int> >.
+            std::string template_name(bool memorize, special_name* special = nullptr) {
+                recursion_guard guard { *this };
+
+                expect('?');
+                expect('$');
+
+                // Template arguments have their own set of backreferences.
+                backref_table outer = std::move(backrefs);
+                backrefs = backref_table { };
+
+
+                std::string name;
+
+                if (consume('?')) {
+                    special_name template_special;
+                    name = operator_name(template_special);
+
+                    // Constructor and destructor templates need the class name, which is not known at this point.
+                    if (template_special.kind != special_name::NONE) {
+                        if (!special) throw demangle_error { };
+                        *special = template_special;
+                    }
+                } else {
+                    name = simple_name(true);
+                }
+
+
+                std::vector<std::string> arguments = template_arguments();
+                backrefs = std::move(outer);
+
+
+                std::string result = std::move(name);
+                result += '<';
+
+                for (std::size_t i = 0; i < arguments.size(); ++i) {
+                    if (i > 0) result += ',';
+                    result += arguments[i];
+                }
+
+                // undname separates consecutive closing brackets with a space.
+                if (result.ends_with('>')) result += ' ';
+                result += '>';
+
+
+                if (memorize) memorize_name(result);
+                return result;
+            }
+
+
+            std::vector<std::string> template_arguments(void) {
+                std::vector<std::string> result;
+
+                while (!consume('@')) {
+                    // Empty parameter packs and pack separators.
+                    if (consume("$$V") || consume("$$Z") || consume("$S")) continue;
+
+                    if (consume("$0")) {
+                        result.push_back(std::to_string(number()));
+                        continue;
+                    }
+
+                    // Pointers and references to symbols, including pointers to members of classes with a single base.
+                    if (consume("$1")) {
+                        result.push_back("&" + declaration());
+                        continue;
+                    }
+
+                    if (consume("$E")) {
+                        result.push_back(declaration());
+                        continue;
+                    }
+
+
+                    // Pointers to members of classes with multiple or virtual bases, which consist of a symbol (for member functions) and offsets.
+                    bool is_member_pointer = false;
+
+                    for (auto [code, has_symbol, offset_count] : std::array {
+                        std::tuple { "$F"sv, false, 2 }, std::tuple { "$G"sv, false, 3 },
+                        std::tuple { "$H"sv, true,  1 }, std::tuple { "$I"sv, true,  2 }, std::tuple { "$J"sv, true, 3 }
+                    }) {
+                        if (!consume(code)) continue;
+
+                        std::string member_pointer = "{";
+                        if (has_symbol) member_pointer += declaration();
+
+                        for (int i = 0; i < offset_count; ++i) {
+                            if (i > 0 || has_symbol) member_pointer += ',';
+                            member_pointer += std::to_string(number());
+                        }
+
+                        result.push_back(member_pointer + "}");
+                        is_member_pointer = true;
+                        break;
+                    }
+
+                    if (is_member_pointer) continue;
+
+
+                    // Other non-type template arguments (floating point values, class types, auto parameters, etc.) are not supported.
+                    if (starts_with("$") && !starts_with("$$")) throw demangle_error { };
+                    if (starts_with("?")) throw demangle_error { };
+
+                    result.push_back(type().text);
+                }
+
+                return result;
+            }
+
+
+            // Sequence of enclosing scopes, from innermost to outermost, terminated by an @.
+            std::vector<std::string> scope_list(void) {
+                std::vector<std::string> result;
+
+                while (!consume('@')) {
+                    if (input.empty()) throw demangle_error { };
+                    result.push_back(scope_name());
+                }
+
+                return result;
+            }
+
+
+            std::string scope_name(void) {
+                if (starts_with_digit()) return name_backref();
+                if (starts_with("?$")) return template_name(true);
+
+                if (consume("?A")) {
+                    // Anonymous namespace, e.g. ?A0x1234abcd@.
+                    auto end = input.find('@');
+                    if (end == std::string_view::npos) throw demangle_error { };
+                    input.remove_prefix(end + 1);
+
+                    std::string result = "`anonymous namespace'";
+                    memorize_name(result);
+                    return result;
+                }
+
+                if (consume('?')) {
+                    // Locally scoped name, e.g. ?1??foo@@YAXXZ for the second scope within the function foo.
+                    std::int64_t scope_number = number();
+                    expect('?');
+
+                    std::string parent = symbol(true);
+                    return "`" + parent + "'::`" + std::to_string(scope_number) + "'";
+                }
+
+                return simple_name(true);
+            }
+
+
+            // Qualified name of a type, e.g. Foo@ns@@ -> ns::Foo.
+            std::string type_name(void) {
+                std::string name;
+
+                if (starts_with_digit()) name = name_backref();
+                else if (starts_with("?$")) name = template_name(true);
+                else name = simple_name(true);
+
+
+                std::string result;
+
+                for (const auto& scope : scope_list() | views::reverse) {
+                    result += scope;
+                    result += "::";
+                }
+
+                return result + name;
+            }
+
+
+            // Special names, after the leading ? has been consumed.
+            std::string operator_name(special_name& special) {
+                if (consume('0')) { special.kind = special_name::CONSTRUCTOR; return ""; }
+                if (consume('1')) { special.kind = special_name::DESTRUCTOR;  return ""; }
+                if (consume('B')) { special.kind = special_name::CONVERSION;  return "operator"; }
+
+
+                // Dynamic initializers and atexit destructors for static variables.
+                for (auto [code, description] : std::array {
+                    std::pair { "__E"sv, "`dynamic initializer for '"sv },
+                    std::pair { "__F"sv, "`dynamic atexit destructor for '"sv }
+                }) {
+                    if (!consume(code)) continue;
+
+                    std::string target;
+
+                    if (starts_with("?")) {
+                        target = symbol(true);
+                        expect('@');
+                    } else {
+                        target = simple_name(true);
+                    }
+
+                    return std::string { description } + target + "''";
+                }
+
+
+                // RTTI data structures.
+                if (consume("_R0")) {
+                    special.kind = special_name::TYPE_DESCRIPTOR;
+                    special.type = type().text;
+
+                    return "`RTTI Type Descriptor'";
+                }
+
+                if (consume("_R1")) {
+                    std::string offsets;
+
+                    for (std::size_t i = 0; i < 4; ++i) {
+                        if (i > 0) offsets += ',';
+                        offsets += std::to_string(number());
+                    }
+
+                    return "`RTTI Base Class Descriptor at (" + offsets + ")'";
+                }
+
+                if (consume("_R2")) return "`RTTI Base Class Array'";
+                if (consume("_R3")) return "`RTTI Class Hierarchy Descriptor'";
+                if (consume("_R4")) return "`RTTI Complete Object Locator'";
+
+
+                if (const auto* code = find_operator(input); code) {
+                    input.remove_prefix(code->code.size());
+                    return std::string { code->name };
+                }
+
+                throw demangle_error { };
+            }
+
+
+            // --- Encodings -------------------------------------------------------------------------------------------
+
+
+            // Consumes the type encoding following the name of a symbol. Returns the return type for functions, or an empty string otherwise.
+            std::string encoding(void) {
+                if (input.empty()) throw demangle_error { };
+                char c = input.front();
+
+
+                // Variables.
+                if (c >= '0' && c <= '4') {
+                    next();
+                    type();
+
+                    while (consume('E') || consume('I') || consume('F'));
+                    cv_qualifiers();
+
+                    return "";
+                }
+
+
+                // Virtual function and base tables, optionally followed by the base class the table is for.
+                if (c == '6' || c == '7') {
+                    next();
+                    cv_qualifiers();
+
+                    while (!consume('@')) type_name();
+                    return "";
+                }
+
+
+                // RTTI data and C-linkage names.
+                if (c == '8' || c == '9') {
+                    next();
+                    return "";
+                }
+
+
+                return function_encoding();
+            }
+
+
+            std::string function_encoding(void) {
+                bool has_this = true;
+                std::size_t this_adjustments = 0;
+
+                if (consume('$')) {
+                    // Virtual functions with a virtual this-adjustment (vtordisp).
+                    char c = next();
+                    if (c < '0' || c > '5') throw demangle_error { };
+
+                    this_adjustments = 2;
+                } else {
+                    char c = next();
+
+                    if (c < 'A' || c > 'Z') throw demangle_error { };
+
+                    switch (c) {
+                        case 'C': case 'D': case 'K': case 'L': case 'S': case 'T': case 'Y': case 'Z':
+                            has_this = false;
+                            break;
+                        case 'G': case 'H': case 'O': case 'P': case 'W': case 'X':
+                            this_adjustments = 1;
+                            break;
+                        default:
+                            break;
+                    }
+                }
+
+                for (std::size_t i = 0; i < this_adjustments; ++i) number();
+
+
+                auto function = function_type(has_this);
+                return function.return_type;
+            }
+
+
+            // Function type, starting at the qualifiers of this (if any).
+            rendered_type function_type(bool has_this) {
+                rendered_type result;
+
+                if (has_this) {
+                    std::string extended_qualifiers = this_pointer_qualifiers();
+
+                    // Reference qualifiers.
+                    if      (consume('G')) extended_qualifiers += " &";
+                    else if (consume('H')) extended_qualifiers += " &&";
+
+                    // undname writes the qualifiers of this directly after the parameter list, e.g. (void)const __ptr64.
+                    std::string qualifiers = cv_qualifiers();
+                    result.this_qualifiers = (qualifiers.empty() ? "" : qualifiers.substr(1)) + extended_qualifiers;
+                }
+
+
+                result.is_function        = true;
+                result.calling_convention = calling_convention();
+
+                // Constructors and destructors have no return type.
+                if (!consume('@')) result.return_type = type().text;
+
+                result.parameters = parameter_list();
+
+
+                // Throw specification.
+                if (!consume('Z') && !consume("_E")) throw demangle_error { };
+
+                result.text = result.return_type + " " + result.calling_convention + "(" + result.parameters + ")";
+                return result;
+            }
+
+
+            std::string calling_convention(void) {
+                switch (next()) {
+                    case 'A': case 'B': return "__cdecl";
+                    case 'C': case 'D': return "__pascal";
+                    case 'E': case 'F': return "__thiscall";
+                    case 'G': case 'H': return "__stdcall";
+                    case 'I': case 'J': return "__fastcall";
+                    case 'M': case 'N': return "__clrcall";
+                    case 'O': case 'P': return "__eabi";
+                    case 'Q':           return "__vectorcall";
+                    default: throw demangle_error { };
+                }
+            }
+
+
+            std::string parameter_list(void) {
+                if (consume('X')) return "void";
+
+
+                std::string result;
+
+                while (true) {
+                    if (consume('@')) break;
+
+                    if (consume('Z')) {
+                        result += (result.empty() ? "..." : ",...");
+                        break;
+                    }
+
+                    if (!result.empty()) result += ',';
+
+
+                    if (starts_with_digit()) {
+                        std::size_t index = (std::size_t) (next() - '0');
+                        if (index >= backrefs.type_count) throw demangle_error { };
+
+                        result += backrefs.types[index];
+                        continue;
+                    }
+
+
+                    // Only types with a mangled name longer than one character are memorized.
+                    std::size_t length_before = input.size();
+                    std::string parameter = type().text;
+
+                    if (length_before - input.size() > 1 && backrefs.type_count < backrefs.types.size()) {
+                        backrefs.types[backrefs.type_count++] = parameter;
+                    }
+
+                    result += parameter;
+                }
+
+                return result;
+            }
+
+
+            // --- Types -----------------------------------------------------------------------------------------------
+
+
+            // Consumes a cv-qualifier for a non-member and returns it as a suffix (e.g. " const").
+            std::string cv_qualifiers(void) {
+                switch (next()) {
+                    case 'A': return "";
+                    case 'B': return " const";
+                    case 'C': return " volatile";
+                    case 'D': return " const volatile";
+                    default: throw demangle_error { };
+                }
+            }
+
+
+            rendered_type type(void) {
+                recursion_guard guard { *this };
+
+                // Qualified types, used for return types and template arguments.
+                if (consume('?')) {
+                    std::string qualifiers = cv_qualifiers();
+
+                    auto result = type();
+                    if (result.is_function) throw demangle_error { };
+
+                    result.text += qualifiers;
+                    return result;
+                }
+
+                if (consume("$$C")) {
+                    std::string qualifiers = cv_qualifiers();
+
+                    auto result = type();
+                    if (result.is_function) throw demangle_error { };
+
+                    result.text += qualifiers;
+                    return result;
+                }
+
+
+                if (consume("$$A6")) return function_type(false);
+                if (consume("$$B"))  return type();
+                if (consume("$$T")) return { "std::nullptr_t" };
+
+                if (consume("$$Q")) return pointer_type(" &&", "");
+                if (consume("$$R")) return pointer_type(" &&", " volatile");
+
+
+                if (input.empty()) throw demangle_error { };
+
+                switch (next()) {
+                    case 'A': return pointer_type(" &", "");
+                    case 'B': return pointer_type(" &", " volatile");
+                    case 'P': return pointer_type(" *", "");
+                    case 'Q': return pointer_type(" *", " const");
+                    case 'R': return pointer_type(" *", " volatile");
+                    case 'S': return pointer_type(" *", " const volatile");
+
+                    case 'T': return { "union "  + type_name() };
+                    case 'U': return { "struct " + type_name() };
+                    case 'V': return { "class "  + type_name() };
+
+                    case 'W':
+                        // The digit after W encodes the underlying type of the enum, which undname does not print.
+                        if (!starts_with_digit()) throw demangle_error { };
+                        next();
+
+                        return { "enum " + type_name() };
+
+                    case 'C': return { "signed char"    };
+                    case 'D': return { "char"           };
+                    case 'E': return { "unsigned char"  };
+                    case 'F': return { "short"          };
+                    case 'G': return { "unsigned short" };
+                    case 'H': return { "int"            };
+                    case 'I': return { "unsigned int"   };
+                    case 'J': return { "long"           };
+                    case 'K': return { "unsigned long"  };
+                    case 'M': return { "float"          };
+                    case 'N': return { "double"         };
+                    case 'O': return { "long double"    };
+                    case 'X': return { "void"           };
+
+                    case '_':
+                        switch (next()) {
+                            case 'D': return { "__int8"            };
+                            case 'E': return { "unsigned __int8"   };
+                            case 'F': return { "__int16"           };
+                            case 'G': return { "unsigned __int16"  };
+                            case 'H': return { "__int32"           };
+                            case 'I': return { "unsigned __int32"  };
+                            case 'J': return { "__int64"           };
+                            case 'K': return { "unsigned __int64"  };
+                            case 'L': return { "__int128"          };
+                            case 'M': return { "unsigned __int128" };
+                            case 'N': return { "bool"              };
+                            case 'Q': return { "char8_t"           };
+                            case 'S': return { "char16_t"          };
+                            case 'U': return { "char32_t"          };
+                            case 'W': return { "wchar_t"           };
+                            default: throw demangle_error { };
+                        }
+
+                    case 'Y': return array_type();
+
+                    default:
+                        throw demangle_error { };
+                }
+            }
+
+
+            // Array, after the Y has been consumed, e.g. Y01H -> int[2][2].
+            rendered_type array_type(void) {
+                std::int64_t rank = number();
+                if (rank <= 0) throw demangle_error { };
+
+                rendered_type result;
+                result.is_array = true;
+
+                for (std::int64_t i = 0; i < rank; ++i) result.dimensions += "[" + std::to_string(number()) + "]";
+
+
+                auto element = type();
+                if (element.is_function || element.is_array) throw demangle_error { };
+
+                result.element_type = std::move(element.text);
+                result.text         = result.element_type + result.dimensions;
+
+                return result;
+            }
+
+
+            // Qualifiers of a pointer, or of this, that follow the pointer kind.
+            std::string this_pointer_qualifiers(void) {
+                std::string result;
+
+                while (true) {
+                    if      (consume('E')) result += " __ptr64";
+                    else if (consume('I')) result += " __restrict";
+                    else if (consume('F')) result += " __unaligned";
+                    else return result;
+                }
+            }
+
+
+            // Pointer or reference, after the pointer kind has been consumed.
+            rendered_type pointer_type(std::string_view symbol, std::string_view pointer_qualifiers) {
+                rendered_type result;
+                result.is_pointer = true;
+
+                // Pointers to functions.
+                if (consume('6')) {
+                    auto function = function_type(false);
+
+                    result.text = function.return_type + " (" + function.calling_convention + std::string { symbol.substr(1) } + ")(" + function.parameters + ")";
+                    result.is_nested_pointer = true;
+
+                    return result;
+                }
+
+
+                std::string extended_qualifiers = this_pointer_qualifiers();
+
+                // Pointers to member functions, e.g. P8A@@AEXXZ -> void (__thiscall A::*)(void).
+                if (consume('8')) {
+                    std::string class_name = type_name();
+                    auto function = function_type(true);
+
+                    result.text =
+                        function.return_type + " (" + function.calling_convention + " " + class_name + "::" + std::string { symbol.substr(1) } +
+                        std::string { pointer_qualifiers } + extended_qualifiers + ")(" + function.parameters + ")" + function.this_qualifiers;
+                    result.is_nested_pointer = true;
+
+                    return result;
+                }
+
+
+                // Pointers to data members, where Q to T stand for the qualifiers of the member, followed by its class, e.g. PQA@@H -> int A::*.
+                std::string pointee_qualifiers, member_class;
+
+                if (!input.empty() && input.front() >= 'Q' && input.front() <= 'T') {
+                    constexpr std::array member_qualifiers { ""sv, " const"sv, " volatile"sv, " const volatile"sv };
+
+                    pointee_qualifiers = member_qualifiers[(std::size_t) (next() - 'Q')];
+                    member_class       = type_name();
+                } else {
+                    pointee_qualifiers = cv_qualifiers();
+                }
+
+
+                auto pointee = type();
+                if (pointee.is_function) throw demangle_error { };
+
+                if (!member_class.empty()) {
+                    if (pointee.is_array) throw demangle_error { };
+
+                    result.text =
+                        pointee.text + pointee_qualifiers + " " + member_class + "::" + std::string { symbol.substr(1) } +
+                        std::string { pointer_qualifiers } + extended_qualifiers;
+
+                    return result;
+                }
+
+                if (pointee.is_array) {
+                    result.text =
+                        pointee.element_type + pointee_qualifiers + " (" + std::string { symbol.substr(1) } +
+                        std::string { pointer_qualifiers } + extended_qualifiers + ")" + pointee.dimensions;
+                    result.is_nested_pointer = true;
+
+                    return result;
+                }
+
+                result.text = pointee.text + pointee_qualifiers + std::string { symbol } + std::string { pointer_qualifiers } + extended_qualifiers;
+                return result;
+            }
+        };
+    }
+
+
+    std::optional<std::string> demangle_msvc_name(std::string_view mangled) {
+        if (!mangled.starts_with('?')) return std::nullopt;
+
+        try {
+            msvc_demangler demangler { mangled };
+            return demangler.symbol(false);
+        } catch (const demangle_error&) {
+            return std::nullopt;
+        }
+    }
+
+
+    std::optional<std::vector<std::string_view>> get_msvc_scopes(std::string_view mangled) {
+        if (!mangled.starts_with('?')) return std::nullopt;
+
+        std::string_view input = mangled.substr(1);
+        auto is_digit = [&] (void) { return !input.empty() && input.front() >= '0' && input.front() <= '9'; };
+
+
+        // Only simple names are supported, so those are the only names the backreferences can refer to.
+        std::array<std::string_view, 10> names;
+        std::size_t name_count = 0;
+
+        auto simple_name = [&] (void) -> std::string_view {
+            auto end = input.find('@');
+            if (end == 0 || end == std::string_view::npos) return { };
+
+            auto result = input.substr(0, end);
+            input.remove_prefix(end + 1);
+
+            if (name_count < names.size() && std::ranges::find(names.begin(), names.begin() + name_count, result) == names.begin() + name_count) {
+                names[name_count++] = result;
+            }
+
+            return result;
+        };
+
+
+        // The name of the symbol itself is skipped, as long as it is not followed by anything that ends up in the scopes of the demangled name.
+        // Conversion operators are followed by their return type, which can contain scopes of its own, so those have to be demangled.
+        bool is_structor = false;
+
+        if (input.starts_with('?')) {
+            input.remove_prefix(1);
+
+            if (input.starts_with('0') || input.starts_with('1')) {
+                is_structor = true;
+                input.remove_prefix(1);
+            } else if (const auto* code = find_operator(input); code) {
+                input.remove_prefix(code->code.size());
+            } else {
+                return std::nullopt;
+            }
+        } else if (is_digit() || simple_name().empty()) {
+            return std::nullopt;
+        }
+
+
+        std::vector<std::string_view> result;
+
+        while (!input.starts_with('@')) {
+            // Scopes starting with a ? are templates, anonymous namespaces or function-local scopes.
+            if (input.empty() || input.starts_with('?')) return std::nullopt;
+
+            if (is_digit()) {
+                std::size_t index = (std::size_t) (input.front() - '0');
+                if (index >= name_count) return std::nullopt;
+
+                input.remove_prefix(1);
+                result.push_back(names[index]);
+            } else if (auto name = simple_name(); !name.empty()) {
+                result.push_back(name);
+            } else {
+                return std::nullopt;
+            }
+        }
+
+        // Constructors and destructors are named after their class.
+        if (is_structor && result.empty()) return std::nullopt;
+
+        std::ranges::reverse(result);
+        return result;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace symgen {
+    // Demangles an MSVC-mangled symbol name, producing the same output as UnDecorateSymbolName with UNDNAME_NAME_ONLY,
+    // i.e. only the fully qualified name of the symbol, without its type, calling convention or storage class.
+    // The demangler keeps no global state and is safe to invoke concurrently from any number of threads.
+    // Returns nullopt if the name is not a mangled name, or if it uses a construct that is not supported.
+    extern std::optional<std::string> demangle_msvc_name(std::string_view mangled);
+
+
+    // Returns the scopes (namespaces and classes) enclosing an MSVC-mangled symbol, from outermost to innermost, e.g. { "ns1", "ns2" } for ?name@ns2@ns1@@YAXXZ,
+    // read directly from the mangled name without demangling it. The scopes are the same as those of the name returned by demangle_msvc_name.
+    // Only names whose scopes are plain identifiers are supported. Returns nullopt for all other names (e.g. members of class templates,
+    // anonymous namespaces and function-local names), which have to be demangled instead.
+    extern std::optional<std::vector<std::string_view>> get_msvc_scopes(std::string_view mangled);
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include <SymbolGenerator/directory_scanner.hpp>
+#include <SymbolGenerator/logger.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace symgen {
+    directory_scanner::directory_scanner(fs::path root, std::vector<std::string> extensions, std::size_t thread_count) :
+        root(std::move(root)),
+        extensions(std::move(extensions)),
+        thread_count(std::max<std::size_t>(thread_count, 1))
+    {}
+
+
+    void directory_scanner::run(const callback_t& callback) {
+        logger::instance().assert_that(fs::is_directory(root), "Input directory ", root, " does not exist.");
+
+
+        // Directories that still have to be searched. A thread that is searching a directory counts as active,
+        // since it may still add more directories to the stack. The search is done once the stack is empty and no thread is active.
+        std::vector<fs::path> directories { root };
+        std::size_t active = 0;
+        std::mutex mtx;
+        std::condition_variable cv;
+
+        std::atomic_size_t directories_seen = 1, files_seen = 0;
+
+
+        auto scan_one = [&] (const fs::path& directory) {
+            std::error_code ec;
+            fs::directory_iterator it { directory, fs::directory_options::skip_permission_denied, ec };
+
+            if (ec) {
+                logger::instance().warning("Failed to search directory ", directory, ": ", ec.message());
+                return;
+            }
+
+
+            for (; it != fs::directory_iterator { }; it.increment(ec)) {
+                const auto& entry = *it;
+
+                // Like recursive_directory_iterator, don't follow directory symlinks, since they could cause cycles.
+                if (entry.is_directory(ec) && !entry.is_symlink(ec)) {
+                    directories_seen.fetch_add(1, std::memory_order_relaxed);
+
+                    {
+                        std::lock_guard lock { mtx };
+                        directories.push_back(entry.path());
+                    }
+
+                    cv.notify_one();
+                } else if (ranges::contains(extensions, entry.path().extension().string()) && entry.is_regular_file(ec)) {
+                    files_seen.fetch_add(1, std::memory_order_relaxed);
+
+                    auto size = entry.file_size(ec);
+                    callback(entry.path(), ec ? 0 : size);
+                }
+            }
+
+            if (ec) logger::instance().warning("Failed to search directory ", directory, ": ", ec.message());
+        };
+
+
+        auto thread_main = [&] {
+            while (true) {
+                fs::path directory;
+
+                {
+                    std::unique_lock lock { mtx };
+                    cv.wait(lock, [&] { return !directories.empty() || active == 0; });
+
+                    if (directories.empty()) break;
+
+                    directory = std::move(directories.back());
+                    directories.pop_back();
+                    ++active;
+                }
+
+
+                scan_one(directory);
+
+
+                {
+                    std::lock_guard lock { mtx };
+                    --active;
+                }
+
+                // If this was the last active thread and there is no more work, the other threads must be woken up to exit.
+                cv.notify_all();
+            }
+        };
+
+
+        std::vector<std::thread> threads;
+        threads.reserve(thread_count - 1);
+
+        for (std::size_t i = 0; i < thread_count - 1; ++i) threads.emplace_back(thread_main);
+        thread_main();
+
+        for (auto& thread : threads) thread.join();
+
+
+        directory_count = directories_seen;
+        file_count      = files_seen;
+    }
+}
\ No newline at end of file
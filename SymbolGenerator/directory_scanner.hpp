@@ -0,0 +1,37 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace symgen {
+    // Recursively searches a directory for files with one of the given extensions, using multiple threads to walk different subdirectories in parallel.
+    // Every file is passed to the callback as soon as it is found, together with its size, so processing can start while the search is ongoing.
+    // The callback may be invoked concurrently from multiple threads.
+    class directory_scanner {
+    public:
+        using callback_t = std::function<void(fs::path, std::uintmax_t)>;
+
+
+        directory_scanner(fs::path root, std::vector<std::string> extensions, std::size_t thread_count);
+
+        // Walks the directory tree and blocks until all files have been passed to the callback.
+        void run(const callback_t& callback);
+
+
+        [[nodiscard]] std::size_t get_directory_count(void) const { return directory_count; }
+        [[nodiscard]] std::size_t get_file_count(void) const { return file_count; }
+    private:
+        fs::path root;
+        std::vector<std::string> extensions;
+        std::size_t thread_count;
+
+        std::size_t directory_count = 0;
+        std::size_t file_count = 0;
+    };
+}
\ No newline at end of file
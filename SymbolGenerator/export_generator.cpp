@@ -0,0 +1,446 @@
+#include <SymbolGenerator/export_generator.hpp>
+#include <SymbolGenerator/argument_parser.hpp>
+#include <SymbolGenerator/work_stealing_pool.hpp>
+#include <SymbolGenerator/directory_scanner.hpp>
+#include <SymbolGenerator/symbol_registry.hpp>
+#include <SymbolGenerator/cache_database.hpp>
+#include <SymbolGenerator/ordinal_map.hpp>
+#include <SymbolGenerator/archive_reader.hpp>
+#include <SymbolGenerator/coff_reader.hpp>
+#include <SymbolGenerator/import_library.hpp>
+#include <SymbolGenerator/read_queue.hpp>
+#include <SymbolGenerator/utility.hpp>
+#include <SymbolGenerator/logger.hpp>
+#include <SymbolGenerator/statistics.hpp>
+#include <SymbolGenerator/string_pool.hpp>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+
+namespace symgen {
+    export_generator::export_generator(fs::path input_directory, std::size_t max_concurrency, std::optional<shard_spec> shard) :
+        input_directory(std::move(input_directory)),
+        max_concurrency(max_concurrency),
+        shard(shard)
+    {}
+
+
+    export_generator::update_statistics export_generator::update(void) {
+        auto& log       = logger::instance();
+        auto& collector = statistics::instance();
+
+        update_statistics stats;
+        std::mutex mtx;
+
+        // Stages that run once per update rather than once per object, for -stats. Guarded by the same lock as the objects.
+        unit_statistics global_stats;
+
+        ++generation;
+
+
+        // Objects are processed while the input directory is still being searched. The number of objects waiting to be processed is bounded,
+        // so on a slow filesystem the search doesn't run arbitrarily far ahead of the workers.
+        // Within that window, the largest objects are started first, so a single huge object does not end up being processed while all other threads are idle.
+        constexpr std::size_t max_pending_objects = 1024;
+
+        // With -prefetch, the tables of loose objects are read in the background while earlier objects are being processed.
+        // The queue is created before the pool, so it outlives any task that still waits for it.
+        std::optional<read_queue> reads;
+
+        if (argument_parser::instance().has_argument("prefetch")) {
+            constexpr long long default_prefetch_depth = 32;
+            reads.emplace((std::size_t) (std::max)(argument_parser::instance().get_argument<long long>("prefetch").value_or(default_prefetch_depth), 1ll));
+
+            log.verbose("Prefetching up to ", reads->get_depth(), " objects using ", reads->get_backend_name(), ".");
+        }
+
+        work_stealing_pool pool { max_concurrency, max_pending_objects };
+
+        // Replaces the results of an object or archive. Must be called without the lock held.
+        // Only replacing the state of the object requires the lock, the export set is updated by every worker in parallel.
+        auto store = [&] (const std::string& key, std::uintmax_t size, fs::file_time_type modification_time, std::vector<included_symbol> symbols) {
+            stage_time merge_time;
+            auto timer = collector.time(merge_time);
+
+            exports.add(symbols);
+            std::vector<included_symbol> previous;
+
+            {
+                std::lock_guard lock { mtx };
+
+                auto& state = objects[key];
+                previous = std::move(state.symbols);
+                state = object_state { size, modification_time, std::move(symbols), generation };
+
+                ++stats.processed_count;
+            }
+
+            exports.remove(previous);
+            timer.stop();
+
+            if (collector.is_enabled()) {
+                std::lock_guard lock { mtx };
+                global_stats[stage::MERGE] += merge_time;
+            }
+        };
+
+
+        std::vector<std::string> extensions { ".obj" };
+        if (argument_parser::instance().has_argument("archives")) extensions.emplace_back(".lib");
+
+        directory_scanner scanner { input_directory, std::move(extensions), max_concurrency };
+        auto scan_timer = collector.time(global_stats, stage::DIRECTORY_SCAN);
+
+        scanner.run([&] (fs::path path, std::uintmax_t size) {
+            if (shard && !shard->contains(path.lexically_relative(input_directory))) return;
+
+            auto key = path.string();
+
+            std::error_code ec;
+            auto modification_time = fs::last_write_time(path, ec);
+
+
+            {
+                std::lock_guard lock { mtx };
+                ++stats.object_count;
+
+                if (auto it = objects.find(key); it != objects.end() && !ec) {
+                    auto& state = it->second;
+
+                    if (state.size == size && state.modification_time == modification_time) {
+                        state.last_seen = generation;
+                        return;
+                    }
+                }
+            }
+
+
+            if (path.extension() != ".lib") {
+                auto prefetched = reads ? reads->prefetch(path) : nullptr;
+
+                pool.push([&, path = std::move(path), key = std::move(key), size, modification_time, prefetched = std::move(prefetched)] () mutable {
+                    translation_unit_processor processor;
+                    processor.process(path, std::move(prefetched));
+
+                    // Merge results as soon as the object is done, rather than waiting for other objects.
+                    store(key, size, modification_time, processor.get_included_symbols());
+                }, reads ? 0 : size); // Prefetched objects are processed in the order they are read, rather than largest first.
+
+                return;
+            }
+
+
+            // Every member of an archive is processed as its own task, so large archives are spread over all workers.
+            // The archive stays mapped until its last member is done, and the results of its members are only stored once all of them are done.
+            auto archive = std::make_shared<archive_reader>(path);
+
+            if (archive->get_error()) {
+                log.warning("Skipping ", path, ": ", *archive->get_error());
+                store(key, size, modification_time, { });
+
+                return;
+            }
+
+            log.verbose(
+                "Archive ", path, " contains ", archive->get_members().size(), " objects ",
+                "and ", archive->get_import_member_count(), " import objects."
+            );
+
+            if (archive->get_members().empty()) {
+                store(key, size, modification_time, { });
+
+                return;
+            }
+
+
+            struct archive_results {
+                std::mutex mtx;
+                std::vector<included_symbol> symbols;
+                std::size_t remaining_members;
+            };
+
+            auto results = std::make_shared<archive_results>();
+            results->remaining_members = archive->get_members().size();
+
+            for (const auto& member : archive->get_members()) {
+                pool.push([&, path, key, archive, results, size, modification_time] () {
+                    translation_unit_processor processor;
+                    processor.process(path, member);
+
+                    std::unique_lock lock { results->mtx };
+
+                    const auto& included = processor.get_included_symbols();
+                    results->symbols.insert(results->symbols.end(), included.begin(), included.end());
+
+                    if (--results->remaining_members == 0) {
+                        lock.unlock();
+                        store(key, size, modification_time, std::move(results->symbols));
+                    }
+                }, member.data.size());
+            }
+        });
+
+        // Objects are already being processed while the directory is scanned, so this overlaps with the other stages.
+        scan_timer.stop();
+        log.verbose("Found ", scanner.get_file_count(), " objects in ", scanner.get_directory_count(), " directories.");
+
+        pool.finish();
+
+
+        auto merge_timer = collector.time(global_stats, stage::MERGE);
+
+        for (auto it = objects.begin(); it != objects.end();) {
+            if (it->second.last_seen == generation) {
+                ++it;
+                continue;
+            }
+
+            exports.remove(it->second.symbols);
+            objects.erase(it++);
+
+            ++stats.removed_count;
+        }
+
+        merge_timer.stop();
+
+
+        log.verbose(
+            "Classified ", symbol_registry::instance().size(), " unique symbol names, ",
+            "using ", string_pool::instance().get_memory_usage() / 1024, " KiB for ", string_pool::instance().size(), " interned names."
+        );
+
+        if (argument_parser::instance().has_argument("cachedb")) {
+            auto timer = collector.time(global_stats, stage::CACHE_WRITE);
+            cache_database::instance().commit();
+        }
+
+
+        if (collector.is_enabled()) {
+            global_stats[counter::DUPLICATE_EXPORTS] = exports.get_shared_count();
+            collector.add(global_stats);
+        }
+
+
+        const auto worker_stats = pool.get_statistics();
+
+        for (const auto& [i, worker] : worker_stats | views::enumerate) {
+            log.verbose(
+                "Worker ", i, " processed ", worker.tasks_executed, " objects (", worker.tasks_stolen, " stolen), ",
+                "busy for ", std::chrono::duration_cast<std::chrono::milliseconds>(worker.busy_time), ", ",
+                "idle for ", std::chrono::duration_cast<std::chrono::milliseconds>(worker.idle_time), "."
+            );
+        }
+
+
+        return stats;
+    }
+
+
+    bool export_generator::release_unused_names(void) {
+        auto& pool = string_pool::instance();
+
+        // Every exported name is in the pool, so the pool is at least as large as the export set.
+        const std::size_t live_count = exports.size();
+        if (pool.size() - live_count <= live_count) return false;
+
+
+        // Both are keyed by the handles that are about to be invalidated.
+        symbol_registry::instance().clear();
+        exports.clear();
+
+        pool.rebuild([&] (auto&& update) {
+            for (auto& [key, state] : objects) {
+                for (auto& symbol : state.symbols) update(symbol.mangled_name);
+            }
+        });
+
+        for (const auto& [key, state] : objects) exports.add(state.symbols);
+
+
+        logger::instance().verbose("Released unused symbol names, ", pool.size(), " names remain, using ", pool.get_memory_usage() / 1024, " KiB.");
+        return true;
+    }
+
+
+    std::optional<std::string> export_generator::write_def_file(
+        const fs::path& path,
+        std::string_view library,
+        bool output_ordinals,
+        const std::optional<fs::path>& import_library,
+        std::uint16_t machine
+    ) const {
+        const auto exported = exports.gather(max_concurrency);
+
+        // Zero is not a valid symbol index.
+        if (exported.size() >= UINT16_MAX) return "Symbol limit exceeded. Try providing additional filters.";
+
+
+        // The export set has no meaningful order, so sort the symbols to make sure the same set of symbols always produces the same file.
+        // This also makes sure new symbols are assigned ordinals in the same order every time.
+        std::vector<std::pair<std::uint16_t, const included_symbol*>> symbols;
+        symbols.reserve(exported.size());
+
+        for (const auto& symbol : exported) symbols.emplace_back(0, &symbol);
+        ranges::sort(symbols, std::less<> { }, [] (const auto& pair) { return pair.second->mangled_name.view(); });
+
+
+        if (output_ordinals) {
+            ordinal_map ordinals { fs::path { path }.replace_extension(".ordinals") };
+
+            for (auto& [ordinal, symbol] : symbols) {
+                auto assigned = ordinals.get_or_assign(symbol->mangled_name.view());
+                if (!assigned) return stream_to_string("No unused ordinals are left in ", ordinals.get_path(), ". Delete it to renumber all symbols.");
+
+                ordinal = *assigned;
+            }
+
+            if (!ordinals.save()) return stream_to_string("Failed to write ", ordinals.get_path());
+            ranges::sort(symbols, std::less<> { }, [] (const auto& pair) { return pair.first; });
+        }
+
+
+        std::string contents = stream_to_string("LIBRARY ", library, "\n", "EXPORTS\n");
+
+        for (const auto& [ordinal, symbol] : symbols) {
+            contents += "  ";
+            contents += symbol->mangled_name.view();
+
+            if (symbol->is_data_symbol) contents += " DATA";
+            if (output_ordinals) contents += stream_to_string(" @", ordinal, " NONAME");
+
+            contents += "\n";
+        }
+
+
+        switch (write_file_if_changed(path, contents)) {
+            case write_result::FAILED:
+                return stream_to_string("Failed to write ", path);
+            case write_result::UNCHANGED:
+                logger::instance().verbose(path, " is up to date and was not rewritten.");
+                break;
+            case write_result::WRITTEN:
+                break;
+        }
+
+
+        if (!import_library) return std::nullopt;
+
+        if (machine == 0) machine = merged_machine;
+
+        if (machine == 0) {
+            auto detected = detect_machine();
+            if (!detected) return "Cannot determine the machine type of the import library, since no objects could be read. Use -machine to provide it.";
+
+            machine = *detected;
+        }
+
+        // Without -ordinal, lib.exe numbers the exports in the order they appear in the .def file.
+        std::vector<def_export> def_exports;
+        def_exports.reserve(symbols.size());
+
+        for (const auto& [i, entry] : symbols | views::enumerate) {
+            const auto& [ordinal, symbol] = entry;
+            def_exports.push_back({ symbol->mangled_name.view(), symbol->is_data_symbol, output_ordinals ? ordinal : (std::uint16_t) (i + 1), !output_ordinals });
+        }
+
+        return write_import_library(*import_library, library, machine, def_exports);
+    }
+
+
+    std::optional<std::string> export_generator::merge_shard_files(std::span<const fs::path> paths) {
+        auto& collector = statistics::instance();
+
+        unit_statistics global_stats;
+        auto merge_timer = collector.time(global_stats, stage::MERGE);
+
+        const auto settings_hash = shard_file::hash_settings();
+        std::vector<bool> found;
+
+
+        for (const auto& path : paths) {
+            shard_file file { path };
+            if (file.get_error()) return stream_to_string("Failed to read shard file ", path, ": ", *file.get_error());
+
+
+            // Every shard has to be present exactly once, otherwise the .def file would silently miss the symbols of a shard, or count them twice.
+            const auto& shard = file.get_shard();
+
+            // Checked before the count is used, so a damaged count cannot cause a huge allocation.
+            if (shard.count != paths.size()) {
+                return stream_to_string("Shard file ", path, " is one of ", shard.count, " shards, but ", paths.size(), " shard files were provided.");
+            }
+
+            if (found.empty()) found.resize(shard.count, false);
+
+            if (shard.count != found.size()) {
+                return stream_to_string("Shard file ", path, " is one of ", shard.count, " shards, but other shard files are one of ", found.size(), " shards.");
+            }
+
+            if (found[shard.index - 1]) return stream_to_string("Shard ", shard.index, "/", shard.count, " is provided more than once.");
+            found[shard.index - 1] = true;
+
+            if (file.get_settings_hash() != settings_hash) {
+                return stream_to_string("Shard file ", path, " was created with different -y, -n, -yo, -no, -fn or -archives arguments.");
+            }
+
+
+            if (file.get_machine() != 0) {
+                if (merged_machine != 0 && merged_machine != file.get_machine()) {
+                    return stream_to_string("Shard file ", path, " was created from objects for a different machine type than the other shard files.");
+                }
+
+                merged_machine = file.get_machine();
+            }
+
+            exports.add(file.get_symbols());
+            logger::instance().verbose("Merged ", file.get_symbols().size(), " symbols from shard ", shard.index, "/", shard.count, ".");
+        }
+
+
+        if (auto missing = ranges::find(found, false); missing != found.end()) {
+            return stream_to_string("Shard ", (missing - found.begin()) + 1, "/", found.size(), " is missing.");
+        }
+
+        merge_timer.stop();
+
+        if (collector.is_enabled()) {
+            global_stats[counter::DUPLICATE_EXPORTS] = exports.get_shared_count();
+            collector.add(global_stats);
+        }
+
+        return std::nullopt;
+    }
+
+
+    std::optional<std::string> export_generator::write_shard_file(const fs::path& path) const {
+        // Objects of a shard may have no machine type of their own (e.g. if there are none), in which case the other shards decide it.
+        auto machine = detect_machine().value_or(0);
+
+        if (!shard_file::write(path, shard.value_or(shard_spec { }), machine, exports.gather(max_concurrency))) return stream_to_string("Failed to write ", path);
+        return std::nullopt;
+    }
+
+
+    std::optional<std::uint16_t> export_generator::detect_machine(void) const {
+        for (const auto& [path, state] : objects) {
+            if (fs::path { path }.extension() == ".lib") {
+                archive_reader archive { path };
+                if (archive.get_error()) continue;
+
+                for (const auto& member : archive.get_members()) {
+                    coff_reader reader { member.data };
+                    if (!reader.get_error() && reader.get_machine() != 0) return reader.get_machine();
+                }
+            } else {
+                coff_reader reader { fs::path { path } };
+                if (!reader.get_error() && reader.get_machine() != 0) return reader.get_machine();
+            }
+        }
+
+        return std::nullopt;
+    }
+}
\ No newline at end of file
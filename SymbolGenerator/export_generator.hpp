@@ -0,0 +1,90 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+#include <SymbolGenerator/translation_unit_processor.hpp>
+#include <SymbolGenerator/export_set.hpp>
+#include <SymbolGenerator/shard_file.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace symgen {
+    // Collects the exported symbols of every object in the input directory and writes them to a .def file.
+    // The results of every object are kept after an update, so later updates only have to process objects that were added or changed since,
+    // which is what allows the -serve mode to regenerate the .def file of a large project in a few milliseconds.
+    class export_generator {
+    public:
+        struct update_statistics {
+            std::size_t object_count    = 0;
+            std::size_t processed_count = 0;
+            std::size_t removed_count   = 0;
+        };
+
+
+        // If a shard is given, only the objects of that shard are processed.
+        export_generator(fs::path input_directory, std::size_t max_concurrency, std::optional<shard_spec> shard = std::nullopt);
+
+
+        // Searches the input directory for objects, and processes every object whose size or modification time changed since the last update.
+        // Objects that no longer exist are removed from the export set.
+        update_statistics update(void);
+
+        // Rebuilds the string pool from the names of the current exports once most of the names in it are no longer exported, e.g. because the symbols
+        // were renamed or removed, or were not exported in the first place. This also forgets how every name was classified, so names that are encountered again
+        // are classified again. Used by the -serve mode, which would otherwise keep the name of every symbol it has ever seen.
+        // Not safe to call during an update, and not supported after merge_shard_files, since the exports are rebuilt from the objects.
+        // Returns whether the pool was rebuilt.
+        bool release_unused_names(void);
+
+        // Adds the exports stored in the given shard files to the export set, instead of processing any objects.
+        // Returns an error if any of the files cannot be read, or if they are not exactly the shards 1/N up to N/N, created with the current settings.
+        [[nodiscard]] std::optional<std::string> merge_shard_files(std::span<const fs::path> paths);
+
+        // Writes the current export set to a .def file for the given library. Returns an error if the file could not be written.
+        // If an import library path is given, the import library lib.exe would create from the .def file is written as well,
+        // for the given machine type, or that of the input objects if it is zero.
+        [[nodiscard]] std::optional<std::string> write_def_file(
+            const fs::path& path,
+            std::string_view library,
+            bool output_ordinals,
+            const std::optional<fs::path>& import_library = std::nullopt,
+            std::uint16_t machine = 0
+        ) const;
+
+        // Writes the current export set to a shard file, to be merged into a .def file later. Returns an error if the file could not be written.
+        [[nodiscard]] std::optional<std::string> write_shard_file(const fs::path& path) const;
+
+
+        [[nodiscard]] const fs::path& get_input_directory(void) const { return input_directory; }
+        [[nodiscard]] std::size_t get_symbol_count(void) const { return exports.size(); }
+    private:
+        struct object_state {
+            std::uintmax_t size;
+            fs::file_time_type modification_time;
+            std::vector<included_symbol> symbols;
+            // Update in which the object was last found in the input directory.
+            std::uint64_t last_seen;
+        };
+
+
+        fs::path input_directory;
+        std::size_t max_concurrency;
+        std::optional<shard_spec> shard;
+        std::uint64_t generation = 0;
+
+        // Machine type of the objects the merged shard files were created from.
+        std::uint16_t merged_machine = 0;
+
+        hash_map<std::string, object_state> objects;
+        export_set exports;
+
+
+        // Returns the machine type of the first object that has one, or nothing if there are no readable objects.
+        [[nodiscard]] std::optional<std::uint16_t> detect_machine(void) const;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include <SymbolGenerator/export_set.hpp>
+#include <SymbolGenerator/utility.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+
+
+namespace symgen {
+    // Orders the symbols by shard, and invokes the given function once for every shard that any of them belong to, with the lock of that shard held.
+    template <typename Fn> void export_set::for_each_shard(std::span<const included_symbol> symbols, Fn&& fn) {
+        std::array<std::size_t, shard_count + 1> offsets { };
+        std::vector<std::uint8_t> indices;
+        indices.reserve(symbols.size());
+
+        for (const auto& symbol : symbols) {
+            indices.push_back((std::uint8_t) get_shard_index<shard_count>(symbol.hash()));
+            ++offsets[indices.back() + 1];
+        }
+
+        for (std::size_t i = 0; i < shard_count; ++i) offsets[i + 1] += offsets[i];
+
+
+        std::vector<const included_symbol*> ordered(symbols.size());
+        auto positions = offsets;
+
+        for (std::size_t i = 0; i < symbols.size(); ++i) ordered[positions[indices[i]]++] = &symbols[i];
+
+
+        for (std::size_t i = 0; i < shard_count; ++i) {
+            if (offsets[i] == offsets[i + 1]) continue;
+
+            std::lock_guard lock { shards[i].mtx };
+            fn(shards[i], std::span { ordered }.subspan(offsets[i], offsets[i + 1] - offsets[i]));
+        }
+    }
+
+
+    void export_set::add(std::span<const included_symbol> symbols) {
+        for_each_shard(symbols, [] (shard& s, std::span<const included_symbol* const> batch) {
+            for (const auto* symbol : batch) ++s.counts[*symbol];
+        });
+    }
+
+
+    void export_set::remove(std::span<const included_symbol> symbols) {
+        for_each_shard(symbols, [] (shard& s, std::span<const included_symbol* const> batch) {
+            for (const auto* symbol : batch) {
+                auto it = s.counts.find(*symbol);
+                if (it == s.counts.end()) continue;
+
+                if (--it->second == 0) s.counts.erase(it);
+            }
+        });
+    }
+
+
+    std::vector<included_symbol> export_set::gather(std::size_t max_concurrency) const {
+        // Collecting a small set is cheaper than starting a thread.
+        constexpr std::size_t min_symbols_per_thread = 64 * 1024;
+
+
+        std::array<std::size_t, shard_count + 1> offsets { };
+        for (std::size_t i = 0; i < shard_count; ++i) offsets[i + 1] = offsets[i] + shards[i].counts.size();
+
+        std::vector<included_symbol> result(offsets.back());
+
+
+        // Every thread copies a contiguous range of shards into its own part of the result.
+        auto copy_shards = [&] (std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) {
+                std::size_t position = offsets[i];
+                for (const auto& [symbol, count] : shards[i].counts) result[position++] = symbol;
+            }
+        };
+
+        std::size_t thread_count = (std::min)({ result.size() / min_symbols_per_thread, max_concurrency, shard_count });
+        thread_count = (std::max)(thread_count, std::size_t { 1 });
+
+        std::vector<std::thread> threads;
+        for (std::size_t t = 1; t < thread_count; ++t) {
+            threads.emplace_back(copy_shards, t * shard_count / thread_count, (t + 1) * shard_count / thread_count);
+        }
+
+        copy_shards(0, shard_count / thread_count);
+        for (auto& thread : threads) thread.join();
+
+
+        return result;
+    }
+
+
+    void export_set::clear(void) {
+        for (auto& s : shards) s.counts = { };
+    }
+
+
+    std::size_t export_set::get_shared_count(void) const {
+        std::size_t result = 0;
+
+        for (const auto& s : shards) {
+            std::lock_guard lock { s.mtx };
+            for (const auto& [symbol, count] : s.counts) result += (count > 1);
+        }
+
+        return result;
+    }
+
+
+    std::size_t export_set::size(void) const {
+        std::size_t result = 0;
+
+        for (const auto& s : shards) {
+            std::lock_guard lock { s.mtx };
+            result += s.counts.size();
+        }
+
+        return result;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+#include <SymbolGenerator/translation_unit_processor.hpp>
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <span>
+#include <vector>
+
+
+namespace symgen {
+    // Set of exported symbols, together with the number of objects that export each of them, so an object can be removed without rebuilding the set.
+    // Workers add the symbols of their objects as soon as they are done. The set is split into shards that each have their own lock,
+    // and every call locks each shard at most once, so workers only contend if they happen to update the same shard at the same time.
+    class export_set {
+    public:
+        // Both are safe to call concurrently.
+        void add(std::span<const included_symbol> symbols);
+        void remove(std::span<const included_symbol> symbols);
+
+
+        // Returns every symbol in the set, in no particular order. Large sets are collected using up to the given number of threads.
+        // Not safe to call concurrently with add() or remove().
+        [[nodiscard]] std::vector<included_symbol> gather(std::size_t max_concurrency) const;
+
+        // Removes every symbol. Not safe to call concurrently with any other method.
+        void clear(void);
+
+        // Number of symbols that are exported by more than one object.
+        [[nodiscard]] std::size_t get_shared_count(void) const;
+        [[nodiscard]] std::size_t size(void) const;
+    private:
+        struct shard {
+            mutable std::mutex mtx;
+            hash_map<included_symbol, std::size_t> counts;
+        };
+
+        constexpr static std::size_t shard_count = 64;
+        std::array<shard, shard_count> shards;
+
+
+        template <typename Fn> void for_each_shard(std::span<const included_symbol> symbols, Fn&& fn);
+    };
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include <SymbolGenerator/filter_plugin.hpp>
+#include <SymbolGenerator/argument_parser.hpp>
+#include <SymbolGenerator/utility.hpp>
+#include <SymbolGenerator/logger.hpp>
+
+#include <algorithm>
+#include <string>
+
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <dlfcn.h>
+#endif
+
+
+namespace symgen {
+    #ifdef _WIN32
+        static void* load_library(const fs::path& path) {
+            return (void*) LoadLibraryW(path.c_str());
+        }
+
+
+        static void free_library(void* library) {
+            FreeLibrary((HMODULE) library);
+        }
+
+
+        static void* load_function(void* library, const char* name) {
+            return (void*) GetProcAddress((HMODULE) library, name);
+        }
+
+
+        static std::string get_library_error(void) {
+            return get_last_winapi_error();
+        }
+    #else
+        static void* load_library(const fs::path& path) {
+            // dlopen only searches the library path for names without a slash, so always pass an absolute path, like LoadLibrary would find it.
+            return dlopen(fs::absolute(path).c_str(), RTLD_NOW | RTLD_LOCAL);
+        }
+
+
+        static void free_library(void* library) {
+            dlclose(library);
+        }
+
+
+        static void* load_function(void* library, const char* name) {
+            return dlsym(library, name);
+        }
+
+
+        static std::string get_library_error(void) {
+            const char* error = dlerror();
+            return error ? error : "Unknown error";
+        }
+    #endif
+
+
+    filter_plugin::filter_plugin(void) {
+        auto path = *argument_parser::instance().get_argument<std::string>("fn");
+
+        library = load_library(path);
+        logger::instance().assert_that(library, "Failed to load filter library ", path, ": ", get_library_error());
+
+
+        keep_symbol        = (keep_symbol_fn)        find_function("keep_symbol");
+        keep_symbols_batch = (keep_symbols_batch_fn) find_function("keep_symbols_batch");
+        teardown           = (teardown_fn)           find_function("filter_teardown");
+
+        logger::instance().assert_that(
+            keep_symbol || keep_symbols_batch,
+            "Filter library ", path, " exports neither keep_symbol nor keep_symbols_batch."
+        );
+
+
+        if (auto init = (init_fn) find_function("filter_init"); init) {
+            logger::instance().assert_that(init() != 0, "Filter library ", path, " failed to initialize.");
+        }
+
+        logger::instance().verbose(
+            "Loaded ", path, " as additional filter function",
+            (keep_symbols_batch ? " (using keep_symbols_batch)." : " (using keep_symbol).")
+        );
+    }
+
+
+    filter_plugin::~filter_plugin(void) {
+        if (teardown) teardown();
+        free_library(library);
+    }
+
+
+    void filter_plugin::filter(std::span<const char* const> names, std::span<const void* const> symbols, const void* reader, std::uint8_t* keep) const {
+        std::fill(keep, keep + (names.size() + 7) / 8, std::uint8_t { 0 });
+
+        if (keep_symbols_batch) {
+            keep_symbols_batch(names.data(), symbols.data(), (std::uint32_t) names.size(), reader, keep);
+            return;
+        }
+
+
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            if (keep_symbol(names[i], symbols[i], reader) != 0) keep[i / 8] |= (std::uint8_t) (1u << (i % 8));
+        }
+    }
+
+
+    void* filter_plugin::find_function(const char* name) const {
+        return load_function(library, name);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+
+namespace symgen {
+    // Shared library provided through -fn, which gets the final say over every symbol that passed all other filters.
+    // The library is loaded once, and must export at least one of the following functions:
+    //
+    //  - int keep_symbol(const char* demangled_name, const void* symbol, const void* reader)
+    //    Called once per symbol. Returns non-zero to keep the symbol.
+    //  - void keep_symbols_batch(const char* const* demangled_names, const void* const* symbols, std::uint32_t count, const void* reader, std::uint8_t* keep)
+    //    Called once per object with all of its candidate symbols. Sets bit i (keep[i / 8] & (1 << (i % 8))) to keep symbol i.
+    //    The bitmap is zeroed before the call. If both functions are exported, this one is used.
+    //
+    // Symbols are COFFI::symbol pointers and the reader is the COFFI::coffi the symbols belong to.
+    // Objects are processed in parallel, so the filter functions may be called concurrently.
+    //
+    // Optionally, the library can export int filter_init(void), which is called once after loading the library and may return zero to abort,
+    // and void filter_teardown(void), which is called once before the program exits.
+    class filter_plugin {
+    public:
+        using keep_symbol_fn        = int(*)(const char*, const void*, const void*);
+        using keep_symbols_batch_fn = void(*)(const char* const*, const void* const*, std::uint32_t, const void*, std::uint8_t*);
+        using init_fn               = int(*)(void);
+        using teardown_fn           = void(*)(void);
+
+
+        // Loads the library given by the -fn argument.
+        static filter_plugin& instance(void) {
+            static filter_plugin i;
+            return i;
+        }
+
+
+        filter_plugin(const filter_plugin&) = delete;
+        filter_plugin& operator=(const filter_plugin&) = delete;
+
+
+        // Invokes the filter for all given symbols of a single object, and sets the bit of every symbol that should be kept.
+        // keep must have room for at least (names.size() + 7) / 8 bytes.
+        void filter(std::span<const char* const> names, std::span<const void* const> symbols, const void* reader, std::uint8_t* keep) const;
+    private:
+        // HMODULE on Windows, the handle returned by dlopen elsewhere.
+        void* library = nullptr;
+
+        keep_symbol_fn keep_symbol = nullptr;
+        keep_symbols_batch_fn keep_symbols_batch = nullptr;
+        teardown_fn teardown = nullptr;
+
+
+        filter_plugin(void);
+        ~filter_plugin(void);
+
+        void* find_function(const char* name) const;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,487 @@
+#include <SymbolGenerator/import_library.hpp>
+#include <SymbolGenerator/coff_utils.hpp>
+#include <SymbolGenerator/utility.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+
+// The formats written here are described in the PE format specification (https://learn.microsoft.com/en-us/windows/win32/debug/pe-format),
+// in the sections on archive (library) files and import library formats.
+namespace symgen {
+    constexpr std::uint32_t SECTION_INITIALIZED_DATA     = 0x00000040;
+    constexpr std::uint32_t SECTION_ALIGN_2_BYTES        = 0x00200000;
+    constexpr std::uint32_t SECTION_ALIGN_4_BYTES        = 0x00300000;
+    constexpr std::uint32_t SECTION_ALIGN_8_BYTES        = 0x00400000;
+    constexpr std::uint32_t SECTION_RELOCATIONS_OVERFLOW = 0x01000000;
+
+    constexpr std::uint16_t FILE_32BIT_MACHINE = 0x0100;
+
+    constexpr std::uint8_t STORAGE_CLASS_EXTERNAL = 2;
+    constexpr std::uint8_t STORAGE_CLASS_STATIC   = 3;
+    constexpr std::uint8_t STORAGE_CLASS_SECTION  = 104;
+
+    // Fields of the header of import objects (IMPORT_OBJECT_HEADER).
+    constexpr std::uint16_t IMPORT_TYPE_CODE = 0;
+    constexpr std::uint16_t IMPORT_TYPE_DATA = 1;
+
+    constexpr std::uint16_t IMPORT_NAME_TYPE_ORDINAL    = 0;
+    constexpr std::uint16_t IMPORT_NAME_TYPE_NAME       = 1;
+    constexpr std::uint16_t IMPORT_NAME_TYPE_UNDECORATE = 3;
+
+
+    std::optional<std::uint16_t> parse_machine_name(std::string_view name) {
+        if (name == "x64" || name == "amd64") return MACHINE_AMD64;
+        if (name == "x86" || name == "i386")  return MACHINE_I386;
+        if (name == "arm64") return MACHINE_ARM64;
+        if (name == "arm")   return MACHINE_ARMNT;
+
+        return std::nullopt;
+    }
+
+
+    static bool is_32bit_machine(std::uint16_t machine) {
+        return machine == MACHINE_I386 || machine == MACHINE_ARMNT;
+    }
+
+
+    // Relocation type of a 32-bit image-relative address (IMAGE_REL_*_ADDR32NB) for the given machine.
+    static std::uint16_t get_rva_relocation_type(std::uint16_t machine) {
+        switch (machine) {
+            case MACHINE_AMD64: return 0x0003;
+            case MACHINE_I386:  return 0x0007;
+            default:            return 0x0002; // ARM and ARM64.
+        }
+    }
+
+
+    class byte_buffer {
+    public:
+        template <typename T> void append(const T& value) {
+            const auto* bytes = (const std::byte*) &value;
+            data.insert(data.end(), bytes, bytes + sizeof(value));
+        }
+
+        void append_big_endian(std::uint32_t value) {
+            for (int shift = 24; shift >= 0; shift -= 8) data.push_back(std::byte (value >> shift));
+        }
+
+        void append_string(std::string_view string, bool null_terminate = true) {
+            const auto* bytes = (const std::byte*) string.data();
+            data.insert(data.end(), bytes, bytes + string.size());
+
+            if (null_terminate) data.push_back(std::byte { 0 });
+        }
+
+        void append_bytes(std::span<const std::byte> bytes) {
+            data.insert(data.end(), bytes.begin(), bytes.end());
+        }
+
+        void align(std::size_t alignment, std::byte fill = std::byte { 0 }) {
+            while (data.size() % alignment) data.push_back(fill);
+        }
+
+        template <typename T> void write_at(std::size_t offset, const T& value) {
+            std::memcpy(data.data() + offset, &value, sizeof(value));
+        }
+
+        [[nodiscard]] std::size_t size(void) const { return data.size(); }
+
+        std::vector<std::byte> data;
+    };
+
+
+    struct object_relocation {
+        std::uint32_t offset;
+        std::uint32_t symbol_index;
+    };
+
+    struct object_section {
+        std::string_view name;
+        std::uint32_t characteristics;
+        std::vector<std::byte> data;
+        std::vector<object_relocation> relocations;
+    };
+
+    struct object_symbol {
+        std::string name;
+        std::uint32_t value;
+        std::int16_t section_number;
+        std::uint8_t storage_class;
+    };
+
+
+    // Creates an object file with the given sections and symbols. All relocations are image-relative addresses.
+    static std::vector<std::byte> make_object(std::uint16_t machine, std::span<const object_section> sections, std::span<const object_symbol> symbols) {
+        constexpr std::size_t FILE_HEADER_SIZE    = 20;
+        constexpr std::size_t SECTION_HEADER_SIZE = 40;
+        constexpr std::size_t RELOCATION_SIZE     = 10;
+
+
+        // Sections with more relocations than fit in the section header store the actual count in an additional first relocation.
+        auto get_relocation_count = [] (const object_section& section) {
+            return section.relocations.size() + (section.relocations.size() >= UINT16_MAX);
+        };
+
+        std::size_t offset = FILE_HEADER_SIZE + sections.size() * SECTION_HEADER_SIZE;
+
+        for (const auto& section : sections) {
+            offset += section.data.size();
+            offset += get_relocation_count(section) * RELOCATION_SIZE;
+        }
+
+
+        byte_buffer result;
+
+        result.append(machine);
+        result.append((std::uint16_t) sections.size());
+        result.append((std::uint32_t) 0); // Timestamp, left empty so the output is the same every time.
+        result.append((std::uint32_t) offset);
+        result.append((std::uint32_t) symbols.size());
+        result.append((std::uint16_t) 0);
+        result.append((std::uint16_t) (is_32bit_machine(machine) ? FILE_32BIT_MACHINE : 0));
+
+
+        offset = FILE_HEADER_SIZE + sections.size() * SECTION_HEADER_SIZE;
+
+        for (const auto& section : sections) {
+            const auto relocation_count = get_relocation_count(section);
+            const bool overflow = relocation_count > section.relocations.size();
+
+            char name[8] = { };
+            std::ranges::copy(section.name.substr(0, sizeof(name)), name);
+
+            result.append(name);
+            result.append((std::uint32_t) 0);
+            result.append((std::uint32_t) 0);
+            result.append((std::uint32_t) section.data.size());
+            result.append((std::uint32_t) (section.data.empty() ? 0 : offset));
+            result.append((std::uint32_t) (relocation_count ? offset + section.data.size() : 0));
+            result.append((std::uint32_t) 0);
+            result.append((std::uint16_t) (std::min)(relocation_count, (std::size_t) UINT16_MAX));
+            result.append((std::uint16_t) 0);
+            result.append(section.characteristics | (overflow ? SECTION_RELOCATIONS_OVERFLOW : 0));
+
+            offset += section.data.size() + relocation_count * RELOCATION_SIZE;
+        }
+
+
+        const auto relocation_type = get_rva_relocation_type(machine);
+
+        for (const auto& section : sections) {
+            result.append_bytes(section.data);
+
+            if (section.relocations.size() >= UINT16_MAX) {
+                result.append((std::uint32_t) get_relocation_count(section));
+                result.append((std::uint32_t) 0);
+                result.append((std::uint16_t) 0);
+            }
+
+            for (const auto& relocation : section.relocations) {
+                result.append(relocation.offset);
+                result.append(relocation.symbol_index);
+                result.append(relocation_type);
+            }
+        }
+
+
+        // Names longer than eight characters are stored in the string table, which starts with its own size.
+        byte_buffer string_table;
+        string_table.append((std::uint32_t) 0);
+
+        for (const auto& symbol : symbols) {
+            if (symbol.name.size() <= 8) {
+                char name[8] = { };
+                std::ranges::copy(symbol.name, name);
+
+                result.append(name);
+            } else {
+                result.append((std::uint32_t) 0);
+                result.append((std::uint32_t) string_table.size());
+
+                string_table.append_string(symbol.name);
+            }
+
+            result.append(symbol.value);
+            result.append(symbol.section_number);
+            result.append((std::uint16_t) 0);
+            result.append(symbol.storage_class);
+            result.append((std::uint8_t) 0);
+        }
+
+        string_table.write_at(0, (std::uint32_t) string_table.size());
+        result.append_bytes(string_table.data);
+
+
+        return std::move(result.data);
+    }
+
+
+    // Object defining the import directory entry of the DLL (__IMPORT_DESCRIPTOR_<name>), which the linker includes if any of its symbols are used.
+    static std::vector<std::byte> make_import_descriptor(std::uint16_t machine, std::string_view dll_name, std::string_view base_name) {
+        constexpr std::uint32_t IMPORT_DIRECTORY_ENTRY_SIZE = 20;
+
+        // The name is not padded, since the section is aligned to two bytes anyway.
+        byte_buffer name;
+        name.append_string(dll_name);
+
+        std::array sections {
+            object_section {
+                ".idata$2", SECTION_ALIGN_4_BYTES | SECTION_INITIALIZED_DATA | SECTION_READ_BIT | SECTION_WRITE_BIT,
+                std::vector<std::byte>(IMPORT_DIRECTORY_ENTRY_SIZE),
+                // The name, import lookup table and import address table fields of the directory entry.
+                { { 12, 2 }, { 0, 3 }, { 16, 4 } }
+            },
+            object_section { ".idata$6", SECTION_ALIGN_2_BYTES | SECTION_INITIALIZED_DATA | SECTION_READ_BIT | SECTION_WRITE_BIT, std::move(name.data), { } }
+        };
+
+        std::array<object_symbol, 7> symbols {
+            object_symbol { stream_to_string("__IMPORT_DESCRIPTOR_", base_name), 0, 1, STORAGE_CLASS_EXTERNAL },
+            object_symbol { ".idata$2", 0, 1, STORAGE_CLASS_SECTION },
+            object_symbol { ".idata$6", 0, 2, STORAGE_CLASS_STATIC },
+            object_symbol { ".idata$4", 0, 0, STORAGE_CLASS_SECTION },
+            object_symbol { ".idata$5", 0, 0, STORAGE_CLASS_SECTION },
+            object_symbol { "__NULL_IMPORT_DESCRIPTOR", 0, 0, STORAGE_CLASS_EXTERNAL },
+            object_symbol { stream_to_string("\x7f", base_name, "_NULL_THUNK_DATA"), 0, 0, STORAGE_CLASS_EXTERNAL }
+        };
+
+        return make_object(machine, sections, symbols);
+    }
+
+
+    // Object defining the empty entry that terminates the import directory.
+    static std::vector<std::byte> make_null_import_descriptor(std::uint16_t machine) {
+        std::array sections {
+            object_section { ".idata$3", SECTION_ALIGN_4_BYTES | SECTION_INITIALIZED_DATA | SECTION_READ_BIT | SECTION_WRITE_BIT, std::vector<std::byte>(20), { } }
+        };
+
+        std::array symbols { object_symbol { "__NULL_IMPORT_DESCRIPTOR", 0, 1, STORAGE_CLASS_EXTERNAL } };
+
+        return make_object(machine, sections, symbols);
+    }
+
+
+    // Object defining the empty entries that terminate the import lookup table and import address table of the DLL.
+    static std::vector<std::byte> make_null_thunk(std::uint16_t machine, std::string_view base_name) {
+        const std::size_t pointer_size = is_32bit_machine(machine) ? 4 : 8;
+        const std::uint32_t flags = (pointer_size == 4 ? SECTION_ALIGN_4_BYTES : SECTION_ALIGN_8_BYTES) | SECTION_INITIALIZED_DATA | SECTION_READ_BIT | SECTION_WRITE_BIT;
+
+        std::array sections {
+            object_section { ".idata$5", flags, std::vector<std::byte>(pointer_size), { } },
+            object_section { ".idata$4", flags, std::vector<std::byte>(pointer_size), { } }
+        };
+
+        std::array symbols { object_symbol { stream_to_string("\x7f", base_name, "_NULL_THUNK_DATA"), 0, 1, STORAGE_CLASS_EXTERNAL } };
+
+        return make_object(machine, sections, symbols);
+    }
+
+
+    // Short import object, from which the linker synthesizes the import thunk and the import table entries of a single export.
+    static std::vector<std::byte> make_import_object(std::uint16_t machine, std::string_view symbol, std::string_view dll_name, std::uint16_t ordinal_or_hint, std::uint16_t type, std::uint16_t name_type) {
+        byte_buffer result;
+
+        result.append((std::uint16_t) 0);      // IMAGE_FILE_MACHINE_UNKNOWN
+        result.append((std::uint16_t) 0xFFFF);
+        result.append((std::uint16_t) 0);      // Version
+        result.append(machine);
+        result.append((std::uint32_t) 0);      // Timestamp
+        result.append((std::uint32_t) (symbol.size() + 1 + dll_name.size() + 1));
+        result.append(ordinal_or_hint);
+        result.append((std::uint16_t) (type | (name_type << 2)));
+
+        result.append_string(symbol);
+        result.append_string(dll_name);
+
+        return std::move(result.data);
+    }
+
+
+    struct archive_entry {
+        std::vector<std::byte> contents;
+        // Symbols the member defines, which are listed in the linker members.
+        std::vector<std::string> symbols;
+    };
+
+
+    static void append_member_header(byte_buffer& result, std::string_view name, std::size_t size, std::string_view mode = "0") {
+        auto field = [&] (std::string_view value, std::size_t width) {
+            result.append_string(value, false);
+            result.data.insert(result.data.end(), width - value.size(), std::byte { ' ' });
+        };
+
+        field(name, 16);
+        field("0", 12); // Timestamp, left empty so the output is the same every time.
+        field("0", 6);
+        field("0", 6);
+        field(mode, 8);
+        field(stream_to_string(size), 10);
+        result.append_string("`\n", false);
+    }
+
+
+    // Creates an archive in the format written by lib.exe, where every member has the same name (that of the DLL).
+    // There can be at most UINT16_MAX entries, since the second linker member refers to them by a 16-bit index.
+    static std::vector<std::byte> make_archive(std::string_view member_name, std::span<const archive_entry> entries) {
+        constexpr std::size_t MEMBER_HEADER_SIZE = 60;
+
+
+        std::vector<std::pair<std::string_view, std::uint16_t>> symbols;
+
+        for (const auto& [i, entry] : entries | views::enumerate) {
+            for (const auto& symbol : entry.symbols) symbols.emplace_back(symbol, (std::uint16_t) (i + 1));
+        }
+
+        std::size_t names_size = 0;
+        for (const auto& [symbol, member] : symbols) names_size += symbol.size() + 1;
+
+
+        // Member names longer than 15 characters (excluding the terminating slash) are stored in the long name table.
+        const bool use_long_name = member_name.size() > 15;
+        const std::string header_name = use_long_name ? "/0" : stream_to_string(member_name, "/");
+
+        auto padded = [] (std::size_t size) { return size + (size & 1); };
+
+        const std::size_t first_linker_size  = 4 + 4 * symbols.size() + names_size;
+        const std::size_t second_linker_size = 4 + 4 * entries.size() + 4 + 2 * symbols.size() + names_size;
+        const std::size_t long_names_size    = use_long_name ? member_name.size() + 1 : 0;
+
+        std::size_t offset = 8 + MEMBER_HEADER_SIZE + padded(first_linker_size) + MEMBER_HEADER_SIZE + padded(second_linker_size);
+        if (use_long_name) offset += MEMBER_HEADER_SIZE + padded(long_names_size);
+
+        std::vector<std::uint32_t> member_offsets;
+
+        for (const auto& entry : entries) {
+            member_offsets.push_back((std::uint32_t) offset);
+            offset += MEMBER_HEADER_SIZE + padded(entry.contents.size());
+        }
+
+
+        byte_buffer result;
+        result.append_string("!<arch>\n", false);
+
+
+        // The first linker member lists symbols in the order of their members, with big-endian offsets.
+        append_member_header(result, "/", first_linker_size);
+        result.append_big_endian((std::uint32_t) symbols.size());
+
+        for (const auto& [symbol, member] : symbols) result.append_big_endian(member_offsets[member - 1]);
+        for (const auto& [symbol, member] : symbols) result.append_string(symbol);
+
+        result.align(2, std::byte { '\n' });
+
+
+        // The second linker member lists symbols in lexical order, with the (one-based) index of their member.
+        std::ranges::stable_sort(symbols, std::less<> { }, [] (const auto& pair) { return pair.first; });
+
+        append_member_header(result, "/", second_linker_size);
+        result.append((std::uint32_t) entries.size());
+
+        for (auto member_offset : member_offsets) result.append(member_offset);
+
+        result.append((std::uint32_t) symbols.size());
+
+        for (const auto& [symbol, member] : symbols) result.append(member);
+        for (const auto& [symbol, member] : symbols) result.append_string(symbol);
+
+        result.align(2, std::byte { '\n' });
+
+
+        if (use_long_name) {
+            append_member_header(result, "//", long_names_size);
+            result.append_string(member_name);
+            result.align(2, std::byte { '\n' });
+        }
+
+
+        for (const auto& entry : entries) {
+            append_member_header(result, header_name, entry.contents.size(), "644");
+            result.append_bytes(entry.contents);
+            result.align(2, std::byte { '\n' });
+        }
+
+
+        return std::move(result.data);
+    }
+
+
+    static std::optional<std::string> write_output(const fs::path& path, std::span<const std::byte> contents) {
+        switch (write_file_if_changed(path, std::string_view { (const char*) contents.data(), contents.size() })) {
+            case write_result::FAILED:
+                return stream_to_string("Failed to write ", path);
+            case write_result::UNCHANGED:
+            case write_result::WRITTEN:
+                return std::nullopt;
+        }
+
+        return std::nullopt;
+    }
+
+
+    std::optional<std::string> write_import_library(const fs::path& path, std::string_view library, std::uint16_t machine, std::span<const def_export> exports) {
+        if (machine != MACHINE_AMD64 && machine != MACHINE_I386 && machine != MACHINE_ARM64 && machine != MACHINE_ARMNT) {
+            return stream_to_string("Cannot write import libraries for machine type 0x", std::hex, machine, ". Use lib.exe with the .def file instead.");
+        }
+
+
+        // Like lib.exe, assume the library is a DLL if the name has no extension.
+        const std::string dll_name  = fs::path { library }.has_extension() ? std::string { library } : stream_to_string(library, ".dll");
+        const std::string base_name = fs::path { dll_name }.stem().string();
+
+
+        std::vector<std::string> symbol_names;
+        std::vector<std::uint16_t> hints(exports.size(), 0);
+
+        // x86 C functions are named without the leading underscore of their symbol in .def files, while C++ names are used as they are.
+        for (const auto& e : exports) {
+            const bool undecorate = machine == MACHINE_I386 && !e.name.starts_with('?');
+            symbol_names.push_back(undecorate ? stream_to_string("_", e.name) : std::string { e.name });
+        }
+
+        // The hint of an import is the index of its name in the name pointer table of the DLL.
+        std::vector<std::size_t> named;
+        for (std::size_t i = 0; i < exports.size(); ++i) if (exports[i].has_name) named.push_back(i);
+
+        std::ranges::sort(named, std::less<> { }, [&] (std::size_t i) { return exports[i].name; });
+        for (const auto& [hint, index] : named | views::enumerate) hints[index] = (std::uint16_t) hint;
+
+
+        std::vector<archive_entry> entries;
+        entries.reserve(exports.size() + 3);
+
+        entries.push_back({ make_import_descriptor(machine, dll_name, base_name), { stream_to_string("__IMPORT_DESCRIPTOR_", base_name) } });
+        entries.push_back({ make_null_import_descriptor(machine), { "__NULL_IMPORT_DESCRIPTOR" } });
+        entries.push_back({ make_null_thunk(machine, base_name), { stream_to_string("\x7f", base_name, "_NULL_THUNK_DATA") } });
+
+        for (const auto& [i, e] : exports | views::enumerate) {
+            const auto& symbol = symbol_names[i];
+
+            std::uint16_t name_type = IMPORT_NAME_TYPE_NAME;
+            if (!e.has_name) name_type = IMPORT_NAME_TYPE_ORDINAL;
+            else if (symbol.size() != e.name.size()) name_type = IMPORT_NAME_TYPE_UNDECORATE;
+
+            auto contents = make_import_object(
+                machine, symbol, dll_name,
+                e.has_name ? hints[i] : e.ordinal,
+                e.is_data ? IMPORT_TYPE_DATA : IMPORT_TYPE_CODE,
+                name_type
+            );
+
+            // Data can only be accessed through the import address table, so it has no thunk.
+            std::vector<std::string> defined { stream_to_string("__imp_", symbol) };
+            if (!e.is_data) defined.push_back(symbol);
+
+            entries.push_back({ std::move(contents), std::move(defined) });
+        }
+
+
+        // Members are referred to by a 16-bit index in the second linker member, and lib.exe rejects archives with more members (LNK1189).
+        if (entries.size() > UINT16_MAX) {
+            return stream_to_string("Cannot write an import library for ", exports.size(), " exports, since it would exceed the limit of ", UINT16_MAX, " archive members.");
+        }
+
+        return write_output(path, make_archive(dll_name, entries));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+
+namespace symgen {
+    // Names are chosen to not collide with the IMAGE_* macros from Windows.h.
+    constexpr std::uint16_t MACHINE_AMD64 = 0x8664;
+    constexpr std::uint16_t MACHINE_ARMNT = 0x01C4;
+    constexpr std::uint16_t MACHINE_ARM64 = 0xAA64;
+
+
+    // A single entry of the EXPORTS section of a .def file.
+    struct def_export {
+        std::string_view name;
+        bool is_data;
+        // Ordinals are assigned in the order of the exports if no ordinals are used.
+        std::uint16_t ordinal;
+        // False for exports marked NONAME, which can only be imported by ordinal.
+        bool has_name;
+    };
+
+
+    // Returns the machine type for the given -machine argument (x64, x86, arm64 or arm), or nothing if it is not supported.
+    [[nodiscard]] extern std::optional<std::uint16_t> parse_machine_name(std::string_view name);
+
+
+    // Writes the import library (.lib) that lib.exe /DEF would create from a .def file with the given exports, without writing the .def file first.
+    // Like the .def file, the library is only rewritten if its contents changed. The export file (.exp) is not written, so the DLL is still linked with the .def file.
+    // The library name is the name of the DLL as it appears in the .def file. Returns an error if the library could not be written.
+    [[nodiscard]] extern std::optional<std::string> write_import_library(
+        const fs::path& path,
+        std::string_view library,
+        std::uint16_t machine,
+        std::span<const def_export> exports
+    );
+}
\ No newline at end of file
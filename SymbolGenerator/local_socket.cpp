@@ -0,0 +1,298 @@
+#include <SymbolGenerator/local_socket.hpp>
+#include <SymbolGenerator/utility.hpp>
+#include <SymbolGenerator/logger.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+    #include <WinSock2.h>
+    #include <afunix.h>
+
+    // Older Windows SDKs do not define the ioctl returning the process ID of the other side of an AF_UNIX socket.
+    #ifndef SIO_AF_UNIX_GETPEERPID
+        #define SIO_AF_UNIX_GETPEERPID _WSAIOR(IOC_VENDOR, 256)
+    #endif
+#else
+    #include <sys/socket.h>
+    #include <sys/stat.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+
+    #include <cerrno>
+#endif
+
+
+namespace symgen {
+    #ifdef _WIN32
+        using native_socket = SOCKET;
+        constexpr int send_flags = 0;
+
+
+        static std::string get_socket_error(void) {
+            return get_last_winapi_error();
+        }
+
+
+        static void close_socket(native_socket socket) {
+            closesocket(socket);
+        }
+
+
+        static void initialize_sockets(void) {
+            static const bool initialized = [] {
+                WSADATA data;
+                return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+            }();
+
+            logger::instance().assert_that(initialized, "Failed to initialize Winsock: ", get_socket_error());
+        }
+    #else
+        using native_socket = int;
+
+        // Writing to a socket that was closed by the other side must fail, rather than raising SIGPIPE.
+        #ifdef MSG_NOSIGNAL
+            constexpr int send_flags = MSG_NOSIGNAL;
+        #else
+            constexpr int send_flags = 0;
+        #endif
+
+
+        static std::string get_socket_error(void) {
+            return std::strerror(errno);
+        }
+
+
+        static void close_socket(native_socket socket) {
+            ::close(socket);
+        }
+
+
+        static void initialize_sockets(void) {}
+    #endif
+
+
+    #ifdef _WIN32
+        // Returns the SID of the user running the given process, or nothing if it cannot be determined.
+        static std::vector<std::byte> get_process_user(DWORD pid) {
+            HANDLE process = ::OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+            if (!process) return {};
+
+            HANDLE token = nullptr;
+            bool opened  = ::OpenProcessToken(process, TOKEN_QUERY, &token);
+            ::CloseHandle(process);
+
+            if (!opened) return {};
+
+
+            DWORD size = 0;
+            ::GetTokenInformation(token, TokenUser, nullptr, 0, &size);
+
+            std::vector<std::byte> info(size);
+            bool success = size > 0 && ::GetTokenInformation(token, TokenUser, info.data(), size, &size);
+            ::CloseHandle(token);
+
+            if (!success) return {};
+
+
+            PSID sid = ((const TOKEN_USER*) info.data())->User.Sid;
+            if (!::IsValidSid(sid)) return {};
+
+            return { (const std::byte*) sid, (const std::byte*) sid + ::GetLengthSid(sid) };
+        }
+    #endif
+
+
+    // Only the user running the server may connect to it, since requests make it write files with its own privileges.
+    // Returns false if the user of the connecting process cannot be determined.
+    static bool is_peer_allowed(native_socket socket) {
+        #if defined(_WIN32)
+            ULONG pid  = 0;
+            DWORD size = 0;
+
+            if (::WSAIoctl(socket, SIO_AF_UNIX_GETPEERPID, nullptr, 0, &pid, sizeof(pid), &size, nullptr, nullptr) != 0) return false;
+
+            static const auto own_user = get_process_user(::GetCurrentProcessId());
+            auto peer_user = get_process_user(pid);
+
+            return !own_user.empty() && peer_user == own_user;
+        #elif defined(__linux__)
+            ucred credentials { };
+            socklen_t size = sizeof(credentials);
+
+            if (::getsockopt(socket, SOL_SOCKET, SO_PEERCRED, &credentials, &size) != 0) return false;
+            return credentials.uid == ::geteuid();
+        #elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__) || defined(__DragonFly__)
+            uid_t uid;
+            gid_t gid;
+
+            if (::getpeereid(socket, &uid, &gid) != 0) return false;
+            return uid == ::geteuid();
+        #else
+            (void) socket;
+            return false;
+        #endif
+    }
+
+
+    static std::optional<sockaddr_un> make_address(const fs::path& path) {
+        sockaddr_un address { };
+        address.sun_family = AF_UNIX;
+
+        auto path_string = path.string();
+        if (path_string.size() >= sizeof(address.sun_path)) return std::nullopt;
+
+        std::memcpy(address.sun_path, path_string.data(), path_string.size());
+        return address;
+    }
+
+
+    local_socket::~local_socket(void) {
+        close();
+    }
+
+
+    local_socket::local_socket(local_socket&& other) noexcept : handle(std::exchange(other.handle, invalid_handle)) {}
+
+
+    local_socket& local_socket::operator=(local_socket&& other) noexcept {
+        if (this != &other) {
+            close();
+            handle = std::exchange(other.handle, invalid_handle);
+        }
+
+        return *this;
+    }
+
+
+    local_socket local_socket::listen(const fs::path& path) {
+        initialize_sockets();
+
+        auto address = make_address(path);
+        logger::instance().assert_that(address.has_value(), "Socket path ", path, " is too long.");
+
+        logger::instance().assert_that(!connect(path), "Another server is already listening on ", path);
+
+        // A server that did not shut down cleanly leaves its socket file behind, which would prevent binding to the path.
+        std::error_code ec;
+        fs::remove(path, ec);
+
+
+        native_socket socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        logger::instance().assert_that((std::intptr_t) socket != invalid_handle, "Failed to create socket: ", get_socket_error());
+
+        local_socket result { (std::intptr_t) socket };
+
+        logger::instance().assert_that(
+            ::bind(socket, (const sockaddr*) &*address, sizeof(*address)) == 0,
+            "Failed to bind socket to ", path, ": ", get_socket_error()
+        );
+
+        // Restrict the socket to its owner before listening on it, so other users can never connect.
+        #ifndef _WIN32
+            logger::instance().assert_that(::chmod(path.c_str(), S_IRUSR | S_IWUSR) == 0, "Failed to set permissions of ", path, ": ", get_socket_error());
+        #endif
+
+        logger::instance().assert_that(::listen(socket, SOMAXCONN) == 0, "Failed to listen on ", path, ": ", get_socket_error());
+
+
+        // Make sure the user of a connecting process can be determined on this system, by connecting to the socket ourselves.
+        // Otherwise, every connection would have to be rejected, or other users could make the server write files for them.
+        auto self = connect(path);
+        std::optional<local_socket> peer;
+
+        if (self) {
+            native_socket accepted = ::accept(socket, nullptr, nullptr);
+            if ((std::intptr_t) accepted != invalid_handle) peer = local_socket { (std::intptr_t) accepted };
+        }
+
+        logger::instance().assert_that(
+            peer && is_peer_allowed((native_socket) peer->handle),
+            "Cannot determine the user of processes connecting to ", path, ", refusing to serve requests."
+        );
+
+        return result;
+    }
+
+
+    std::optional<local_socket> local_socket::connect(const fs::path& path) {
+        initialize_sockets();
+
+        auto address = make_address(path);
+        if (!address) return std::nullopt;
+
+
+        native_socket socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if ((std::intptr_t) socket == invalid_handle) return std::nullopt;
+
+        local_socket result { (std::intptr_t) socket };
+        if (::connect(socket, (const sockaddr*) &*address, sizeof(*address)) != 0) return std::nullopt;
+
+        return result;
+    }
+
+
+    std::optional<local_socket> local_socket::accept(void) const {
+        while (true) {
+            native_socket socket = ::accept((native_socket) handle, nullptr, nullptr);
+            if ((std::intptr_t) socket == invalid_handle) return std::nullopt;
+
+            local_socket result { (std::intptr_t) socket };
+
+            if (!is_peer_allowed(socket)) {
+                logger::instance().warning("Rejected a connection from a process of another user, or one whose user could not be determined.");
+                continue;
+            }
+
+            return result;
+        }
+    }
+
+
+    bool local_socket::send(std::span<const std::byte> data) const {
+        while (!data.empty()) {
+            int chunk  = (int) (std::min)(data.size(), (std::size_t) 1 << 30);
+            auto count = ::send((native_socket) handle, (const char*) data.data(), chunk, send_flags);
+
+            if (count <= 0) {
+                #ifndef _WIN32
+                    if (count == -1 && errno == EINTR) continue;
+                #endif
+
+                return false;
+            }
+
+            data = data.subspan((std::size_t) count);
+        }
+
+        return true;
+    }
+
+
+    bool local_socket::receive(std::span<std::byte> data) const {
+        while (!data.empty()) {
+            int chunk  = (int) (std::min)(data.size(), (std::size_t) 1 << 30);
+            auto count = ::recv((native_socket) handle, (char*) data.data(), chunk, 0);
+
+            if (count <= 0) {
+                #ifndef _WIN32
+                    if (count == -1 && errno == EINTR) continue;
+                #endif
+
+                return false;
+            }
+
+            data = data.subspan((std::size_t) count);
+        }
+
+        return true;
+    }
+
+
+    void local_socket::close(void) {
+        if (handle != invalid_handle) close_socket((native_socket) handle);
+        handle = invalid_handle;
+    }
+}
\ No newline at end of file
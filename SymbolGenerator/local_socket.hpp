@@ -0,0 +1,54 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+
+namespace symgen {
+    // Stream socket bound to a path on the local filesystem (AF_UNIX), used to communicate between the -serve server and its clients.
+    // Windows supports AF_UNIX sockets since Windows 10 (build 17063), so the same implementation is used on every platform.
+    class local_socket {
+    public:
+        local_socket(void) = default;
+        ~local_socket(void);
+
+        local_socket(const local_socket&) = delete;
+        local_socket& operator=(const local_socket&) = delete;
+
+        local_socket(local_socket&& other) noexcept;
+        local_socket& operator=(local_socket&& other) noexcept;
+
+
+        // Creates a socket listening on the given path. Fails if another process is already listening on it.
+        // Outside of Windows, the socket file is only accessible to the current user.
+        // Fails if the user of a connecting process cannot be determined on this system (see accept).
+        [[nodiscard]] static local_socket listen(const fs::path& path);
+
+        // Connects to the socket listening on the given path, if there is one.
+        [[nodiscard]] static std::optional<local_socket> connect(const fs::path& path);
+
+        // Blocks until a client connects to this (listening) socket. Connections from processes of other users are rejected.
+        [[nodiscard]] std::optional<local_socket> accept(void) const;
+
+
+        // Sends or receives exactly the given number of bytes. Returns false if the connection was closed or an error occurred.
+        [[nodiscard]] bool send(std::span<const std::byte> data) const;
+        [[nodiscard]] bool receive(std::span<std::byte> data) const;
+
+
+        [[nodiscard]] bool is_open(void) const { return handle != invalid_handle; }
+    private:
+        // SOCKET on Windows, a file descriptor elsewhere. INVALID_SOCKET converts to -1 as well.
+        constexpr static std::intptr_t invalid_handle = -1;
+        std::intptr_t handle = invalid_handle;
+
+
+        explicit local_socket(std::intptr_t handle) : handle(handle) {}
+
+        void close(void);
+    };
+}
\ No newline at end of file
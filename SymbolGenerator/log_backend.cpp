@@ -0,0 +1,399 @@
+#include <SymbolGenerator/log_backend.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <thread>
+
+
+namespace symgen {
+    constexpr std::size_t ENTRY_HEADER_SIZE = sizeof(std::uint32_t) + sizeof(std::uint64_t);
+    constexpr auto WRITER_INTERVAL = std::chrono::milliseconds { 10 };
+
+
+    // Reads values from an encoded entry or trace file, and fails once it would read past the end of the data.
+    class record_reader {
+    public:
+        explicit record_reader(std::string_view data) : data(data) {}
+
+
+        template <typename T> bool read(T& value) {
+            if (data.size() < sizeof(T)) return false;
+
+            std::memcpy(&value, data.data(), sizeof(T));
+            data.remove_prefix(sizeof(T));
+
+            return true;
+        }
+
+
+        bool read_string(std::string_view& value) {
+            std::uint32_t size = 0;
+            if (!read(size) || data.size() < size) return false;
+
+            value = data.substr(0, size);
+            data.remove_prefix(size);
+
+            return true;
+        }
+
+
+        [[nodiscard]] bool empty(void) const { return data.empty(); }
+        [[nodiscard]] std::string_view remaining(void) const { return data; }
+    private:
+        std::string_view data;
+    };
+
+
+    // Formats the next record of the given reader the same way an std::ostream would have formatted its arguments.
+    // If no text is given, the record is only skipped.
+    static bool format_record(record_reader& reader, std::uint8_t& level, std::string* text) {
+        std::string_view prefix;
+        std::uint16_t argument_count = 0;
+
+        if (!reader.read(level) || !reader.read_string(prefix) || !reader.read(argument_count)) return false;
+        if (text && !prefix.empty()) text->append("[").append(prefix).append("] ");
+
+
+        for (std::uint16_t i = 0; i < argument_count; ++i) {
+            log_argument_type type;
+            if (!reader.read(type)) return false;
+
+            switch (type) {
+                using enum log_argument_type;
+
+                case STRING: {
+                    std::string_view value;
+                    if (!reader.read_string(value)) return false;
+
+                    if (text) *text += value;
+                    break;
+                }
+                case CHAR: {
+                    char value;
+                    if (!reader.read(value)) return false;
+
+                    if (text) *text += value;
+                    break;
+                }
+                case BOOL: {
+                    bool value;
+                    if (!reader.read(value)) return false;
+
+                    if (text) *text += (value ? '1' : '0');
+                    break;
+                }
+                case SIGNED: case UNSIGNED: {
+                    std::int64_t value;
+                    if (!reader.read(value)) return false;
+
+                    if (!text) break;
+
+                    char buffer[32];
+                    auto [end, error] = (type == SIGNED)
+                        ? std::to_chars(std::begin(buffer), std::end(buffer), value)
+                        : std::to_chars(std::begin(buffer), std::end(buffer), (std::uint64_t) value);
+
+                    text->append(buffer, end);
+                    break;
+                }
+                case FLOATING: {
+                    double value;
+                    if (!reader.read(value)) return false;
+
+                    if (!text) break;
+
+                    std::ostringstream stream;
+                    stream << value;
+                    *text += stream.str();
+
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+
+
+        if (text) *text += '\n';
+        return true;
+    }
+
+
+    log_backend& log_backend::instance(void) {
+        // The backend is never destroyed, so messages can still be logged while other static objects are destroyed.
+        // Remaining messages are written by the exit handler instead.
+        static log_backend* i = new log_backend { };
+        return *i;
+    }
+
+
+    log_backend::log_backend(void) {
+        std::thread { [this] { run_writer(); } }.detach();
+        std::atexit([] { log_backend::instance().flush(); });
+    }
+
+
+    void log_backend::submit(std::string_view records) {
+        const std::size_t size = ENTRY_HEADER_SIZE + records.size();
+
+        auto& ring = get_thread_ring();
+
+
+        // Entries that could never fit into the ring buffer are handed to the writer directly.
+        // The timestamp is taken while holding the lock, so the writer cannot have written any later entries yet.
+        if (size > ring_buffer::CAPACITY / 2) [[unlikely]] {
+            std::lock_guard lock { mtx };
+            pending.push_back(pending_entry { get_timestamp(), ring.thread_index, std::string { records } });
+
+            return;
+        }
+
+
+        // Announce the submission before taking the timestamp of the entry, so the writer holds back any entries logged after this point
+        // until the entry is published, even if this thread has to wait for space in its ring buffer first.
+        ring.submitting_since.store(get_timestamp());
+
+        const std::size_t head = ring.head.load(std::memory_order_relaxed);
+
+        while (ring_buffer::CAPACITY - (head - ring.tail.load(std::memory_order_acquire)) < size) {
+            wake.notify_one();
+            std::this_thread::yield();
+        }
+
+
+        auto write = [&, position = head] (const void* source, std::size_t count) mutable {
+            const std::size_t offset = position % ring_buffer::CAPACITY;
+            const std::size_t first  = (std::min)(count, ring_buffer::CAPACITY - offset);
+
+            std::memcpy(ring.data.get() + offset, source, first);
+            std::memcpy(ring.data.get(), (const char*) source + first, count - first);
+
+            position += count;
+        };
+
+        const auto records_size = (std::uint32_t) records.size();
+        const std::uint64_t timestamp = get_timestamp();
+
+        write(&records_size, sizeof(records_size));
+        write(&timestamp, sizeof(timestamp));
+        write(records.data(), records.size());
+
+        ring.head.store(head + size, std::memory_order_release);
+        ring.submitting_since.store(ring_buffer::NOT_SUBMITTING);
+
+
+        // The writer only wakes up periodically, unless a ring buffer is about to run full.
+        if (head + size - ring.tail.load(std::memory_order_relaxed) > ring_buffer::CAPACITY / 2) wake.notify_one();
+    }
+
+
+    void log_backend::flush(void) {
+        std::lock_guard lock { mtx };
+        write_pending(true);
+    }
+
+
+    bool log_backend::set_trace_file(const fs::path& path) {
+        std::lock_guard lock { mtx };
+
+        trace_file = std::ofstream { path, std::ios::binary | std::ios::trunc };
+        trace_file.write((const char*) &TRACE_MAGIC, sizeof(TRACE_MAGIC));
+        trace_file.write((const char*) &TRACE_VERSION, sizeof(TRACE_VERSION));
+
+        return (bool) trace_file;
+    }
+
+
+    std::uint64_t log_backend::get_timestamp(void) const {
+        return (std::uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+
+    log_backend::ring_buffer& log_backend::get_thread_ring(void) {
+        // Marks the ring buffer as abandoned once its thread exits, so the writer can release it once it has been emptied.
+        struct ring_owner {
+            ring_buffer* ring = nullptr;
+
+            ~ring_owner(void) {
+                if (ring) ring->abandoned.store(true, std::memory_order_release);
+                ring = nullptr;
+            }
+        };
+
+        thread_local ring_owner owner;
+
+        if (!owner.ring) [[unlikely]] {
+            std::lock_guard lock { mtx };
+            owner.ring = rings.emplace_back(std::make_unique<ring_buffer>(next_thread_index++)).get();
+        }
+
+        return *owner.ring;
+    }
+
+
+    void log_backend::run_writer(void) {
+        std::unique_lock lock { mtx };
+
+        while (true) {
+            wake.wait_for(lock, WRITER_INTERVAL);
+            write_pending(false);
+        }
+    }
+
+
+    void log_backend::write_pending(bool everything) {
+        // Entries are only written once they are older than the point in time the ring buffers were read, and older than the start of
+        // any submission that was still in progress then. Every entry that has not been published yet is announced before its timestamp is
+        // taken, and published before the announcement is withdrawn, so any entry missed here has a timestamp of at least the cutoff.
+        std::uint64_t cutoff = get_timestamp();
+
+
+        for (auto it = rings.begin(); it != rings.end();) {
+            auto& ring = **it;
+
+            // Check whether the ring is abandoned before reading it, so the entries written before its thread exited are not missed.
+            // Likewise, the submission in progress is checked before the head, so an entry published in between is not missed either.
+            const bool abandoned = ring.abandoned.load(std::memory_order_acquire);
+            cutoff = (std::min)(cutoff, ring.submitting_since.load());
+            const std::size_t head = ring.head.load(std::memory_order_acquire);
+            std::size_t tail = ring.tail.load(std::memory_order_relaxed);
+
+            auto read = [&] (void* destination, std::size_t count) {
+                const std::size_t offset = tail % ring_buffer::CAPACITY;
+                const std::size_t first  = (std::min)(count, ring_buffer::CAPACITY - offset);
+
+                std::memcpy(destination, ring.data.get() + offset, first);
+                std::memcpy((char*) destination + first, ring.data.get(), count - first);
+
+                tail += count;
+            };
+
+            while (tail != head) {
+                std::uint32_t records_size;
+                pending_entry entry { .timestamp = 0, .thread_index = ring.thread_index, .records = { } };
+
+                read(&records_size, sizeof(records_size));
+                read(&entry.timestamp, sizeof(entry.timestamp));
+
+                entry.records.resize(records_size);
+                read(entry.records.data(), records_size);
+
+                pending.push_back(std::move(entry));
+            }
+
+            ring.tail.store(tail, std::memory_order_release);
+
+
+            // Only the writer thread releases rings, since a flush from an exit handler may run after the owning thread has exited,
+            // but before static objects that may still log are destroyed.
+            if (abandoned && !everything) it = rings.erase(it);
+            else ++it;
+        }
+
+
+        std::ranges::stable_sort(pending, std::less<> { }, &pending_entry::timestamp);
+
+        auto last = everything
+            ? pending.end()
+            : std::ranges::lower_bound(pending, cutoff, std::less<> { }, &pending_entry::timestamp);
+
+        if (last == pending.begin()) return;
+
+
+        std::string text;
+        for (auto it = pending.begin(); it != last; ++it) write_entry(*it, text);
+
+        pending.erase(pending.begin(), last);
+
+
+        std::cout.write(text.data(), (std::streamsize) text.size());
+        std::cout.flush();
+
+        if (trace_file.is_open()) trace_file.flush();
+    }
+
+
+    void log_backend::write_entry(const pending_entry& entry, std::string& text) {
+        record_reader reader { entry.records };
+        std::string trace_records;
+
+        while (!reader.empty()) {
+            // Trace records are copied to the trace file as they are, so only their level has to be decoded to tell them apart.
+            if (trace_file.is_open() && (std::uint8_t) reader.remaining().front() == TRACE_LEVEL) {
+                auto record_start = reader.remaining();
+                std::uint8_t level;
+
+                if (!format_record(reader, level, nullptr)) break;
+
+                trace_records.append(record_start.substr(0, record_start.size() - reader.remaining().size()));
+            } else {
+                std::uint8_t level;
+                if (!format_record(reader, level, &text)) break;
+            }
+        }
+
+
+        if (!trace_records.empty()) {
+            std::string header;
+            append_raw(header, (std::uint32_t) trace_records.size());
+            append_raw(header, entry.timestamp);
+            append_raw(header, entry.thread_index);
+
+            trace_file.write(header.data(), (std::streamsize) header.size());
+            trace_file.write(trace_records.data(), (std::streamsize) trace_records.size());
+        }
+    }
+
+
+    std::optional<std::string> log_backend::decode_trace_file(const fs::path& path, std::ostream& stream) {
+        std::ifstream file { path, std::ios::binary };
+        if (!file) return "failed to open file";
+
+        std::string contents { std::istreambuf_iterator<char> { file }, std::istreambuf_iterator<char> { } };
+        record_reader reader { contents };
+
+
+        std::uint32_t magic = 0, version = 0;
+        if (!reader.read(magic) || magic != TRACE_MAGIC) return "file is not a trace file";
+        if (!reader.read(version) || version != TRACE_VERSION) return "trace file uses an unsupported format version";
+
+
+        while (!reader.empty()) {
+            std::uint32_t records_size, thread_index;
+            std::uint64_t timestamp;
+
+            if (!reader.read(records_size) || !reader.read(timestamp) || !reader.read(thread_index) || reader.remaining().size() < records_size) {
+                return "trace file is truncated";
+            }
+
+            record_reader records { reader.remaining().substr(0, records_size) };
+            reader = record_reader { reader.remaining().substr(records_size) };
+
+
+            // Prefix every message with the time since the start of the traced process and the thread that logged it.
+            char header[64];
+            auto header_end = std::to_chars(std::begin(header), std::end(header), (double) timestamp / 1e6, std::chars_format::fixed, 3).ptr;
+            header_end = std::to_chars(std::copy_n("ms T", 4, header_end), std::end(header), thread_index).ptr;
+            *header_end++ = ' ';
+
+            std::string text;
+
+            while (!records.empty()) {
+                std::uint8_t level;
+                text.append(header, header_end);
+
+                if (!format_record(records, level, &text)) return "trace file contains an invalid record";
+            }
+
+            stream << text;
+        }
+
+
+        return std::nullopt;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace symgen {
+    // Type tag stored before every argument of an encoded log record.
+    enum class log_argument_type : std::uint8_t { STRING, CHAR, BOOL, SIGNED, UNSIGNED, FLOATING };
+
+
+    template <typename T> inline void append_raw(std::string& buffer, const T& value) {
+        buffer.append((const char*) &value, sizeof(T));
+    }
+
+
+    // Writes log messages of all threads from a single background thread, so threads that log never wait for the console or for each other.
+    // Every thread submits its messages to its own single-producer single-consumer ring buffer as encoded records, which are only formatted
+    // by the writer thread. The writer orders the messages of all threads by the time they were logged.
+    //
+    // Messages are submitted as entries, each of which contains one or more records:
+    //  - Entry:    u32 size of the records, u64 timestamp, records...
+    //  - Record:   u8 level, u32 prefix size, prefix, u16 argument count, arguments...
+    //  - Argument: u8 log_argument_type, followed by a u32 size and the characters for strings, or the raw value otherwise.
+    //
+    // If a trace file is set, trace records (level zero) are written to it in this encoding instead of to the console.
+    // The trace file starts with TRACE_MAGIC and TRACE_VERSION, followed by entries of the form u32 size of the records, u64 timestamp, u32 thread, records...
+    class log_backend {
+    public:
+        constexpr static std::uint32_t TRACE_MAGIC   = 0x46544753; // "SGTF"
+        constexpr static std::uint32_t TRACE_VERSION = 1;
+
+        constexpr static std::uint8_t TRACE_LEVEL = 0;
+
+
+        static log_backend& instance(void);
+
+        log_backend(const log_backend&) = delete;
+        log_backend& operator=(const log_backend&) = delete;
+
+
+        // Submits the given records as a single entry, so they are written together.
+        void submit(std::string_view records);
+
+        // Writes all submitted messages and waits until they have been written.
+        void flush(void);
+
+        // Writes trace records to the given file from now on. Returns false if the file could not be created.
+        bool set_trace_file(const fs::path& path);
+
+        // Converts a trace file to text. Returns an error message if the file is not a valid trace file.
+        static std::optional<std::string> decode_trace_file(const fs::path& path, std::ostream& stream);
+    private:
+        struct ring_buffer {
+            constexpr static std::size_t CAPACITY = 1 << 20;
+            constexpr static std::uint64_t NOT_SUBMITTING = std::numeric_limits<std::uint64_t>::max();
+
+            std::unique_ptr<char[]> data = std::make_unique_for_overwrite<char[]>(CAPACITY);
+            std::uint32_t thread_index;
+
+            // Both positions only ever increase, the position in the buffer is the position modulo the capacity.
+            // The head is only written by the thread owning the buffer, the tail only by the writer thread.
+            alignas(64) std::atomic<std::size_t> head = 0;
+            // Timestamp taken before the owning thread started to submit an entry it has not published yet, or NOT_SUBMITTING.
+            // The entry's own timestamp is taken later, so the writer does not write any entry from this point in time onwards.
+            std::atomic<std::uint64_t> submitting_since = NOT_SUBMITTING;
+            alignas(64) std::atomic<std::size_t> tail = 0;
+            // Set once the owning thread has exited, after which the buffer is released once it is empty.
+            std::atomic<bool> abandoned = false;
+
+            explicit ring_buffer(std::uint32_t thread_index) : thread_index(thread_index) {}
+        };
+
+        struct pending_entry {
+            std::uint64_t timestamp;
+            std::uint32_t thread_index;
+            std::string records;
+        };
+
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        // Protects everything below, and is held by the writer while it writes messages.
+        std::mutex mtx;
+        std::condition_variable wake;
+
+        std::vector<std::unique_ptr<ring_buffer>> rings;
+        std::uint32_t next_thread_index = 0;
+        // Entries that have been read from the ring buffers, but not written yet.
+        std::vector<pending_entry> pending;
+
+        std::ofstream trace_file;
+
+
+        log_backend(void);
+
+        [[nodiscard]] std::uint64_t get_timestamp(void) const;
+        ring_buffer& get_thread_ring(void);
+
+        void run_writer(void);
+        void write_pending(bool everything);
+        void write_entry(const pending_entry& entry, std::string& text);
+    };
+}
\ No newline at end of file
@@ -1,8 +1,13 @@
 #pragma once
 
-#include <iostream>
-#include <mutex>
-#include <syncstream>
+#include <SymbolGenerator/log_backend.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
 
 
 namespace symgen {
@@ -17,9 +22,32 @@ namespace symgen {
         }
 
 
-        logger fork(std::string new_prefix) {
+        logger(void) = default;
+
+        // Copies only the settings of the logger, never messages that are still buffered in its group.
+        logger(const logger& other) : prefix(other.prefix), level(other.level), grouped(other.grouped) {}
+
+        logger& operator=(const logger& other) {
+            flush();
+
+            prefix  = other.prefix;
+            level   = other.level;
+            grouped = other.grouped;
+
+            return *this;
+        }
+
+        ~logger(void) {
+            flush();
+        }
+
+
+        // Messages of a grouped logger are kept until the logger is flushed or destroyed, and are then written together,
+        // so that e.g. the messages of a single translation unit are not interleaved with those of other threads.
+        logger fork(std::string new_prefix, bool grouped = false) const {
             logger copy = *this;
-            copy.prefix = std::move(new_prefix);
+            copy.prefix  = std::move(new_prefix);
+            copy.grouped = grouped;
             return copy;
         }
 
@@ -27,21 +55,29 @@ namespace symgen {
         void assert_that(bool cond, const auto&... msg) {
             if (!cond) [[unlikely]] {
                 message(ERROR, msg...);
+                flush();
                 std::exit(-1);
             }
         }
 
 
+        // Messages are only encoded here, and formatted by the log_backend on its own thread.
         void message(logger_level level, const auto&... msg) {
             if (level < this->level) return;
 
-            std::osyncstream stream { std::cout };
-            if (!prefix.empty()) stream << "[" << prefix << "] ";
-            (stream << ... << msg) << "\n";
+            thread_local std::string scratch;
+            std::string& buffer = grouped ? group : scratch;
+
+            append_raw(buffer, (std::uint8_t) level);
+            append_string(buffer, prefix);
+            append_raw(buffer, (std::uint16_t) sizeof...(msg));
+            (append_argument(buffer, msg), ...);
+
+            if (grouped) return;
+
 
-            #ifndef NDEBUG
-                stream << std::flush;
-            #endif
+            log_backend::instance().submit(buffer);
+            buffer.clear();
         }
 
         void trace  (const auto&... msg) { message(logger_level::TRACE,   msg...); }
@@ -51,9 +87,57 @@ namespace symgen {
         void error  (const auto&... msg) { message(logger_level::ERROR,   msg...); }
 
 
+        // Writes all messages of the current group.
+        void flush(void) {
+            if (group.empty()) return;
+
+            log_backend::instance().submit(group);
+            group.clear();
+        }
+
+
         void set_level(logger_level level) { this->level = level; }
+        [[nodiscard]] logger_level get_level(void) const { return level; }
     private:
         std::string prefix = "SymbolGenerator";
         logger_level level = NORMAL;
+
+        bool grouped = false;
+        std::string group;
+
+
+        static void append_string(std::string& buffer, std::string_view sv) {
+            append_raw(buffer, (std::uint32_t) sv.size());
+            buffer.append(sv);
+        }
+
+
+        // Strings and numbers are stored as they are. Everything else is formatted right away, since it may not outlive the message.
+        template <typename T> static void append_argument(std::string& buffer, const T& value) {
+            using enum log_argument_type;
+
+            if constexpr (std::is_same_v<T, bool>) {
+                append_raw(buffer, BOOL);
+                append_raw(buffer, value);
+            } else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>) {
+                append_raw(buffer, CHAR);
+                append_raw(buffer, (char) value);
+            } else if constexpr (std::is_integral_v<T>) {
+                append_raw(buffer, std::is_signed_v<T> ? SIGNED : UNSIGNED);
+                append_raw(buffer, (std::int64_t) value);
+            } else if constexpr (std::is_floating_point_v<T>) {
+                append_raw(buffer, FLOATING);
+                append_raw(buffer, (double) value);
+            } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+                append_raw(buffer, STRING);
+                append_string(buffer, value);
+            } else {
+                std::ostringstream stream;
+                stream << value;
+
+                append_raw(buffer, STRING);
+                append_string(buffer, stream.str());
+            }
+        }
     };
 }
\ No newline at end of file
@@ -2,12 +2,18 @@
 #include <SymbolGenerator/translation_unit_processor.hpp>
 #include <SymbolGenerator/utility.hpp>
 #include <SymbolGenerator/logger.hpp>
-
+#include <SymbolGenerator/export_generator.hpp>
+#include <SymbolGenerator/cache_database.hpp>
+#include <SymbolGenerator/server.hpp>
+#include <SymbolGenerator/statistics.hpp>
+#include <SymbolGenerator/import_library.hpp>
+#include <SymbolGenerator/rule_cache.hpp>
+
+#include <iostream>
 #include <vector>
 #include <string>
 #include <thread>
 #include <chrono>
-#include <fstream>
 
 using std::chrono::steady_clock;
 
@@ -37,19 +43,88 @@ int wrapped_main(int argc, char** argv) {
     auto& logger     = symgen::logger::instance();
 
     arg_parser.add_arguments(args);
-    arg_parser.template require_argument<std::string>("lib");
-    arg_parser.template require_argument<std::string>("i");
-    arg_parser.template require_argument<std::string>("o");
+
+
+    // Converting a trace file to text does not require any of the other arguments.
+    if (auto trace_file = arg_parser.template get_argument<std::string>("decodetrace"); trace_file) {
+        if (auto error = symgen::log_backend::decode_trace_file(*trace_file, std::cout); error) {
+            logger.error("Failed to decode ", *trace_file, ": ", *error);
+            return -1;
+        }
+
+        return 0;
+    }
+
+
+    // Generating a matcher only depends on the rules, so it does not require an input directory or output file either.
+    if (auto matcher_path = arg_parser.template get_argument<std::string>("emit-matcher"); matcher_path) {
+        auto source = symgen::rule_cache::instance().generate_matcher_source();
+
+        if (symgen::write_file_if_changed(*matcher_path, source) == symgen::write_result::FAILED) {
+            logger.error("Failed to write ", *matcher_path);
+            return -1;
+        }
+
+        logger.normal("Generated matcher ", *matcher_path, ".");
+        return 0;
+    }
+
+
+    // A server writes the .def files its clients ask for, so it does not need to know about them in advance.
+    const bool is_server = arg_parser.has_argument("serve");
+
+    // With -shard, only a subset of the objects is processed, and their exports are written to a shard file rather than a .def file.
+    // With -merge, no objects are processed at all. Instead, the shard files are combined into the .def file.
+    const bool is_merge = arg_parser.has_argument("merge");
+    std::optional<symgen::shard_spec> shard;
+
+    if (auto shard_text = arg_parser.get_argument_text("shard"); shard_text) {
+        shard = symgen::shard_spec::parse(*shard_text);
+        logger.assert_that(shard.has_value(), "Invalid shard ", *shard_text, ". Shards must be of the form k/N, where k is between 1 and N.");
+    }
+
+    logger.assert_that(!(is_server && (shard || is_merge)), "--serve cannot be combined with --shard or --merge.");
+    logger.assert_that(!(shard && is_merge), "--shard and --merge cannot be combined.");
+
+    if (!is_merge) arg_parser.template require_argument<std::string>("i");
+    if (!is_server) arg_parser.template require_argument<std::string>("o");
+    if (!is_server && !shard) arg_parser.template require_argument<std::string>("lib");
 
 
     if (arg_parser.has_argument("verbose")) logger.set_level(symgen::logger::VERBOSE);
     if (arg_parser.has_argument("trace"))   logger.set_level(symgen::logger::TRACE);
 
-    if (arg_parser.has_argument("fn") && arg_parser.has_argument("cache")) {
+    if (auto trace_file = arg_parser.template get_argument<std::string>("tracefile"); trace_file) {
+        logger.set_level(symgen::logger::TRACE);
+        logger.assert_that(symgen::log_backend::instance().set_trace_file(*trace_file), "Failed to create trace file ", *trace_file);
+    }
+
+
+    // If there is a server, let it do the work. Otherwise, or if the server cannot handle this request, fall through and generate the file locally.
+    if (auto socket = arg_parser.template get_argument<std::string>("server"); socket && !is_server && !shard && !is_merge) {
+        if (auto result = symgen::request_from_server(*socket, args); result) {
+            logger.normal(*result);
+            return 0;
+        }
+    }
+
+
+    // The machine type of the import library is taken from the objects, unless it is provided explicitly.
+    std::uint16_t machine = 0;
+
+    if (auto machine_name = arg_parser.template get_argument<std::string>("machine"); machine_name) {
+        auto parsed = symgen::parse_machine_name(*machine_name);
+        logger.assert_that(parsed.has_value(), "Unsupported machine type ", *machine_name, ". Supported types are x64, x86, arm64 and arm.");
+
+        machine = *parsed;
+    }
+
+
+    if (arg_parser.has_argument("fn") && (arg_parser.has_argument("cache") || arg_parser.has_argument("cachedb") || is_server)) {
         logger.warning(
-            "Using --cache together with --fn: ",
+            "Using --cache or --serve together with --fn: ",
             "this may produce unexpected results if the result of the DLL is not constant between invocations of SymbolGenerator.exe. ",
-            "You should make sure to manually clear cache files (.objcache) if the DLL filter implementation changes."
+            "You should make sure to manually clear cache files (.objcache or the -cachedb database) and restart the server if the DLL filter implementation changes."
         );
     }
 
@@ -67,66 +142,60 @@ int wrapped_main(int argc, char** argv) {
     logger.normal("Symbols will be filtered according to the following settings: ", filter_args);
 
 
-    // Parse object files for symbols.
-    symgen::hash_set<symgen::included_symbol> symbols;
+    // Load the cache database up front, rather than from within the first task that needs it.
+    if (arg_parser.has_argument("cachedb")) symgen::cache_database::instance();
 
-    std::size_t max_concurrency = arg_parser.template get_argument<long long>("j").value_or(std::thread::hardware_concurrency());
-    auto object_paths = symgen::find_all_of_type(*arg_parser.template get_argument<std::string>("i"), ".obj");
 
+    std::size_t max_concurrency = arg_parser.template get_argument<long long>("j").value_or(std::thread::hardware_concurrency());
+    symgen::export_generator generator { arg_parser.template get_argument<std::string>("i").value_or(""), max_concurrency, shard };
 
-    while (!object_paths.empty()) {
-        std::size_t count = std::min(max_concurrency, object_paths.size());
-
-        std::vector<std::thread> threads;
-        threads.reserve(count);
-        std::vector<symgen::translation_unit_processor> processors;
-        processors.reserve(count);
-
-
-        for (std::size_t i = 0; i < count; ++i) {
-            auto& processor = processors.emplace_back();
-
-            threads.emplace_back([path = std::move(object_paths[i]), &processor] () {
-                auto name = path.filename().replace_extension().string();
-                auto dir  = symgen::fs::path { path }.remove_filename();
-
-                processor.process(dir, name);
-            });
-        }
+    if (is_server) {
+        symgen::server server { *arg_parser.template get_argument<std::string>("serve"), generator };
+        server.run();
+    }
 
-        object_paths.erase(object_paths.begin(), object_paths.begin() + count);
 
+    // Parse object files for symbols (or load the symbols of every shard) and write them to the def file.
+    if (is_merge) {
+        auto paths = arg_parser.template get_argument<std::string>("merge");
+        logger.assert_that(paths.has_value(), "Missing the shard files to merge.");
 
-        for (auto& thread : threads) thread.join();
+        std::vector<symgen::fs::path> shard_files;
+        for (auto path : symgen::split(*paths, " ")) shard_files.emplace_back(path);
 
-        for (auto& unit : processors) {
-            symbols.insert(
-                std::make_move_iterator(unit.get_included_symbols().begin()),
-                std::make_move_iterator(unit.get_included_symbols().end())
-            );
+        if (auto error = generator.merge_shard_files(shard_files); error) {
+            logger.error(*error);
+            return -1;
         }
+    } else {
+        generator.update();
     }
 
+    symgen::unit_statistics output_stats;
+    auto output_timer = symgen::statistics::instance().time(output_stats, symgen::stage::OUTPUT);
 
-    // Write symbols to def file.
-    const bool output_ordinals = arg_parser.has_argument("ordinal");
-
-    std::ofstream stream { *arg_parser.template get_argument<std::string>("o") };
-    stream << "LIBRARY " << *arg_parser.template get_argument<std::string>("lib") << "\n";
-    stream << "EXPORTS\n";
+    std::optional<std::string> error;
 
-    std::size_t next_index = 1; // Zero is not a valid symbol index.
+    if (shard) {
+        error = generator.write_shard_file(*arg_parser.template get_argument<std::string>("o"));
+    } else {
+        auto import_library = arg_parser.template get_argument<std::string>("implib");
 
+        error = generator.write_def_file(
+            *arg_parser.template get_argument<std::string>("o"),
+            *arg_parser.template get_argument<std::string>("lib"),
+            arg_parser.has_argument("ordinal"),
+            import_library ? std::optional<symgen::fs::path> { *import_library } : std::nullopt,
+            machine
+        );
+    }
 
-    for (const auto& symbol : symbols) {
-        logger.assert_that(next_index < UINT16_MAX, "Symbol limit exceeded. Try providing additional filters.");
-
-        stream << "  " << symbol.mangled_name;
-        if (symbol.is_data_symbol) stream << " DATA";
-        if (output_ordinals) stream << " @" << next_index << " NONAME";
-        stream << "\n";
+    output_timer.stop();
+    symgen::statistics::instance().add(output_stats);
 
-        ++next_index;
+    if (error) {
+        logger.error(*error);
+        return -1;
     }
 
 
@@ -134,10 +203,21 @@ int wrapped_main(int argc, char** argv) {
     steady_clock::time_point stop = steady_clock::now();
     logger.verbose("Processing took ", std::chrono::duration_cast<std::chrono::milliseconds>(stop - start));
 
-    logger.normal(
-        "Generated ", *arg_parser.template get_argument<std::string>("o"),
-        " with ", (next_index - 1), " symbols."
-    );
+    if (auto stats_path = arg_parser.template get_argument<std::string>("stats"); stats_path) {
+        if (!symgen::statistics::instance().write(*stats_path, stop - start)) logger.warning("Failed to write statistics to ", *stats_path);
+    }
+
+    if (shard) {
+        logger.normal(
+            "Generated shard ", shard->index, "/", shard->count, " in ", *arg_parser.template get_argument<std::string>("o"),
+            " with ", generator.get_symbol_count(), " symbols."
+        );
+    } else {
+        logger.normal(
+            "Generated ", *arg_parser.template get_argument<std::string>("o"),
+            " with ", generator.get_symbol_count(), " symbols."
+        );
+    }
 
 
     return 0;
@@ -0,0 +1,129 @@
+#include <SymbolGenerator/mapped_file.hpp>
+#include <SymbolGenerator/utility.hpp>
+
+#include <utility>
+
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+
+    #include <cerrno>
+    #include <cstring>
+#endif
+
+
+namespace symgen {
+    #ifdef _WIN32
+        mapped_file::mapped_file(const fs::path& path) {
+            HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+            if (file == INVALID_HANDLE_VALUE) {
+                error = stream_to_string("failed to open file: ", get_last_winapi_error());
+                return;
+            }
+
+            LARGE_INTEGER file_size;
+
+            if (!GetFileSizeEx(file, &file_size)) {
+                error = stream_to_string("failed to get file size: ", get_last_winapi_error());
+                CloseHandle(file);
+                return;
+            }
+
+            // Empty files cannot be mapped.
+            if (file_size.QuadPart == 0) {
+                CloseHandle(file);
+                return;
+            }
+
+
+            HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            void* view     = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+            if (!view) error = stream_to_string("failed to map file: ", get_last_winapi_error());
+
+            // The view keeps the mapping alive, so the handles are no longer needed.
+            if (mapping) CloseHandle(mapping);
+            CloseHandle(file);
+
+            if (!view) return;
+
+            begin  = (const std::byte*) view;
+            length = (std::size_t) file_size.QuadPart;
+        }
+
+
+        void mapped_file::unmap(void) {
+            if (begin) UnmapViewOfFile(begin);
+        }
+    #else
+        mapped_file::mapped_file(const fs::path& path) {
+            int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+            if (fd == -1) {
+                error = stream_to_string("failed to open file: ", std::strerror(errno));
+                return;
+            }
+
+            struct stat info;
+
+            if (::fstat(fd, &info) != 0) {
+                error = stream_to_string("failed to get file size: ", std::strerror(errno));
+                ::close(fd);
+                return;
+            }
+
+            // Empty files cannot be mapped.
+            if (info.st_size == 0) {
+                ::close(fd);
+                return;
+            }
+
+
+            void* view = ::mmap(nullptr, (std::size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view == MAP_FAILED) error = stream_to_string("failed to map file: ", std::strerror(errno));
+
+            // The mapping keeps the file alive, so the descriptor is no longer needed.
+            ::close(fd);
+
+            if (view == MAP_FAILED) return;
+
+            begin  = (const std::byte*) view;
+            length = (std::size_t) info.st_size;
+        }
+
+
+        void mapped_file::unmap(void) {
+            if (begin) ::munmap((void*) begin, length);
+        }
+    #endif
+
+
+    mapped_file::~mapped_file(void) {
+        unmap();
+    }
+
+
+    mapped_file::mapped_file(mapped_file&& other) noexcept :
+        begin(std::exchange(other.begin, nullptr)),
+        length(std::exchange(other.length, 0)),
+        error(std::exchange(other.error, std::nullopt))
+    {}
+
+
+    mapped_file& mapped_file::operator=(mapped_file&& other) noexcept {
+        if (this != &other) {
+            unmap();
+
+            begin  = std::exchange(other.begin, nullptr);
+            length = std::exchange(other.length, 0);
+            error  = std::exchange(other.error, std::nullopt);
+        }
+
+        return *this;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+
+
+namespace symgen {
+    // Read-only memory mapping of an entire file.
+    // Pages are only read from disk once they are accessed, so parts of the file that are never looked at cost nothing.
+    // If the file cannot be opened or mapped (e.g. because it was deleted or is locked), the mapping is empty and get_error describes why.
+    class mapped_file {
+    public:
+        mapped_file(void) = default;
+        explicit mapped_file(const fs::path& path);
+        ~mapped_file(void);
+
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+
+        mapped_file(mapped_file&& other) noexcept;
+        mapped_file& operator=(mapped_file&& other) noexcept;
+
+
+        [[nodiscard]] std::span<const std::byte> data(void) const { return { begin, length }; }
+        [[nodiscard]] std::size_t size(void) const { return length; }
+
+        // Returns an error message if the file could not be mapped, or nullopt otherwise.
+        [[nodiscard]] const std::optional<std::string>& get_error(void) const { return error; }
+    private:
+        const std::byte* begin = nullptr;
+        std::size_t length = 0;
+        std::optional<std::string> error;
+
+        void unmap(void);
+    };
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include <SymbolGenerator/namespace_cache.hpp>
+#include <SymbolGenerator/rule_cache.hpp>
+
+#include <mutex>
+
+
+namespace symgen {
+    namespace_status namespace_cache::classify(std::span<const std::string_view> path) {
+        node* current = &root;
+
+        for (const auto& component : path) {
+            // Exclusion is final, so there is no need to store the subnamespaces of an excluded namespace.
+            if (current->status.verdict == namespace_verdict::EXCLUDED) break;
+            current = &get_child(*current, component);
+        }
+
+        return current->status;
+    }
+
+
+    namespace_cache::node& namespace_cache::get_child(node& parent, std::string_view component) {
+        {
+            std::shared_lock lock { parent.mtx };
+            if (auto it = parent.children.find(component); it != parent.children.end()) return *it->second;
+        }
+
+
+        // Evaluate the rules before taking the exclusive lock, so other threads can keep reading this node in the meantime.
+        // If another thread inserts the same child first, its result is kept, which is identical to ours.
+        auto child    = std::make_unique<node>();
+        child->status = evaluate(parent.status, component);
+
+        std::unique_lock lock { parent.mtx };
+        if (auto it = parent.children.find(component); it != parent.children.end()) return *it->second;
+
+        return *parent.children.emplace(std::string { component }, std::move(child)).first->second;
+    }
+
+
+    namespace_status namespace_cache::evaluate(const namespace_status& parent, std::string_view component) {
+        const auto& args_y = rule_cache::instance().get_includes();
+        const auto& args_n = rule_cache::instance().get_excludes();
+
+        namespace_status status = parent;
+
+
+        if (status.verdict == namespace_verdict::NOT_INCLUDED) {
+            if (auto rule = args_y.match(component); rule) status = { namespace_verdict::INCLUDED, *rule };
+        }
+
+        if (status.verdict == namespace_verdict::NOT_INCLUDED || status.verdict == namespace_verdict::INCLUDED) {
+            if (auto rule = args_n.match(component); rule) status = { namespace_verdict::EXCLUDED, *rule };
+        }
+
+        return status;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <span>
+
+
+namespace symgen {
+    enum class namespace_verdict : std::uint8_t {
+        NOT_INCLUDED, INCLUDED, EXCLUDED
+    };
+
+
+    struct namespace_status {
+        namespace_verdict verdict = namespace_verdict::NOT_INCLUDED;
+        // Index of the -y rule that included the namespace, or of the -n rule that excluded it.
+        std::size_t rule_index = 0;
+    };
+
+
+    // Remembers the include status of every namespace path that has been seen, shared between all translation units.
+    // Paths are stored as a prefix trie, so classifying a symbol only requires matching the rules against namespaces that have never been seen before,
+    // and every other namespace is resolved by a single lookup per path component.
+    class namespace_cache {
+    public:
+        static namespace_cache& instance(void) {
+            static namespace_cache i;
+            return i;
+        }
+
+
+        // Returns the include status of the given namespace path, e.g. { "A", "B" } for the symbol A::B::f. Safe to call concurrently.
+        [[nodiscard]] namespace_status classify(std::span<const std::string_view> path);
+
+        // Forgets all namespaces, e.g. to measure the cost of matching them against the rules for the first time. Not safe to call while objects are processed.
+        void clear(void) { root.children.clear(); }
+    private:
+        struct node {
+            namespace_status status;
+
+            std::shared_mutex mtx;
+            hash_map<std::string, std::unique_ptr<node>> children;
+        };
+
+        node root;
+
+
+        namespace_cache(void) = default;
+
+        node& get_child(node& parent, std::string_view component);
+        static namespace_status evaluate(const namespace_status& parent, std::string_view component);
+    };
+}
\ No newline at end of file
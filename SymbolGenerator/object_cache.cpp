@@ -0,0 +1,304 @@
+#include <SymbolGenerator/object_cache.hpp>
+#include <SymbolGenerator/utility.hpp>
+#include <SymbolGenerator/logger.hpp>
+
+#include <bit>
+#include <cstring>
+#include <fstream>
+
+
+namespace symgen {
+    constexpr std::size_t HEADER_SIZE = 80;
+    constexpr std::size_t IDENTITY_OFFSET = 56;
+    constexpr std::size_t ENTRY_SIZE  = 16;
+
+
+    object_cache::object_cache(const fs::path& path) : file(path), data(file.data()), error(file.get_error()) {
+        if (!error) parse_headers();
+    }
+
+
+    object_cache::object_cache(std::span<const std::byte> contents) : data(contents) {
+        parse_headers();
+    }
+
+
+    void object_cache::parse_headers(void) {
+        if (data.size() < HEADER_SIZE || read_le<std::uint32_t>(data, 0) != FORMAT_MAGIC) {
+            error = "file is not a binary cache file (it may have been created by an older version)";
+            return;
+        }
+
+        if (auto version = read_le<std::uint32_t>(data, 4); version != FORMAT_VERSION) {
+            error = stream_to_string("cache file uses format version ", version, ", expected version ", FORMAT_VERSION);
+            return;
+        }
+
+
+        settings_hash = read_le<std::uint64_t>(data, 8);
+        entry_count   = read_le<std::uint32_t>(data, 16);
+        bucket_count  = read_le<std::uint32_t>(data, 20);
+
+        identity.size              = read_le<std::uint64_t>(data, IDENTITY_OFFSET);
+        identity.modification_time = read_le<std::int64_t>(data, IDENTITY_OFFSET + 8);
+        identity.content_hash      = read_le<std::uint64_t>(data, IDENTITY_OFFSET + 16);
+
+        if (!std::has_single_bit(bucket_count) || bucket_count <= entry_count) {
+            error = "cache file has an invalid hash table";
+            return;
+        }
+
+
+        // Validate every section lies within the file, so lookups only have to check entries point within the name section.
+        auto get_section = [&] (std::size_t header_offset, std::size_t size) -> std::optional<std::span<const std::byte>> {
+            std::size_t offset = read_le<std::uint32_t>(data, header_offset);
+            if (offset > data.size() || size > data.size() - offset) return std::nullopt;
+
+            return data.subspan(offset, size);
+        };
+
+        auto settings_section = get_section(24, read_le<std::uint32_t>(data, 28));
+        auto bucket_section   = get_section(32, (std::size_t) bucket_count * sizeof(std::uint32_t));
+        auto entry_section    = get_section(36, (std::size_t) entry_count * ENTRY_SIZE);
+        auto state_section    = get_section(40, entry_count);
+        auto name_section     = get_section(44, read_le<std::uint32_t>(data, 48));
+
+        if (!settings_section || !bucket_section || !entry_section || !state_section || !name_section) {
+            error = "cache file is truncated";
+            return;
+        }
+
+        settings = *settings_section;
+        buckets  = *bucket_section;
+        entries  = *entry_section;
+        states   = *state_section;
+        names    = *name_section;
+    }
+
+
+    std::optional<symbol_state> object_cache::find(std::string_view name) const {
+        if (error || bucket_count == 0) return std::nullopt;
+
+        const std::uint64_t hash = stable_hash(name);
+        const std::uint32_t mask = bucket_count - 1;
+
+
+        // There is always at least one empty bucket, but a corrupted file could still contain a cycle, so limit the number of probes.
+        for (std::uint32_t i = 0, bucket = (std::uint32_t) hash & mask; i < bucket_count; ++i, bucket = (bucket + 1) & mask) {
+            auto index = read_le<std::uint32_t>(buckets, (std::size_t) bucket * sizeof(std::uint32_t));
+            if (index == 0 || index > entry_count) return std::nullopt;
+
+            if (read_le<std::uint64_t>(entries, (std::size_t) (index - 1) * ENTRY_SIZE) != hash) continue;
+
+            auto entry_name = get_entry_name(index - 1);
+            if (!entry_name) return std::nullopt;
+
+            if (*entry_name == name) return (symbol_state) read_le<char>(states, index - 1);
+        }
+
+        return std::nullopt;
+    }
+
+
+    std::optional<std::string_view> object_cache::get_entry_name(std::uint32_t index) const {
+        std::size_t entry  = (std::size_t) index * ENTRY_SIZE;
+        std::size_t offset = read_le<std::uint32_t>(entries, entry + 8);
+        std::size_t length = read_le<std::uint32_t>(entries, entry + 12);
+
+        if (offset > names.size() || length > names.size() - offset) return std::nullopt;
+        return std::string_view { (const char*) names.data() + offset, length };
+    }
+
+
+    hash_map<std::string, std::string> object_cache::get_settings(void) const {
+        hash_map<std::string, std::string> result;
+        std::string_view sv { (const char*) settings.data(), settings.size() };
+
+        for (auto line : split(sv, "\n")) {
+            auto pos = line.find('=');
+            if (pos == std::string_view::npos) continue;
+
+            result.emplace(line.substr(0, pos), line.substr(pos + 1));
+        }
+
+        return result;
+    }
+
+
+    std::uint64_t object_cache::hash_settings(const hash_map<std::string, std::string>& settings) {
+        // Combine the hashes of the settings in an order-independent way, matching the way check_settings_compatible compares them.
+        std::uint64_t result = 0;
+
+        for (const auto& [setting, value] : settings) {
+            auto components = split(value, " ");
+            ranges::sort(components);
+
+            std::uint64_t setting_hash = stable_hash(setting);
+            for (auto component : components) setting_hash = stable_hash(component, setting_hash);
+
+            result += setting_hash;
+        }
+
+        return result;
+    }
+
+
+    object_identity object_cache::identify(const fs::path& path, const coff_reader& reader) {
+        // If the object was removed in the meantime, its timestamp is left at zero. The next run then compares the hash of its tables instead.
+        std::error_code ec;
+        auto modification_time = fs::last_write_time(path, ec);
+
+        return object_identity {
+            .size              = reader.get_file_size(),
+            .modification_time = ec ? 0 : (std::int64_t) modification_time.time_since_epoch().count(),
+            .content_hash      = reader.hash_tables()
+        };
+    }
+
+
+    std::vector<std::byte> object_cache::serialize(
+        const object_identity& identity,
+        const hash_map<std::string, std::string>& settings,
+        std::span<const std::pair<std::string_view, symbol_state>> symbols
+    ) {
+        std::string settings_text;
+        for (const auto& [setting, value] : settings) settings_text += stream_to_string(setting, "=", value, "\n");
+
+
+        // Keep the load factor at or below one half, so lookups of missing symbols terminate quickly.
+        std::uint32_t buckets = std::bit_ceil((std::uint32_t) std::max<std::size_t>(symbols.size() * 2, 2));
+
+        std::vector<std::uint32_t> bucket_table(buckets, 0);
+        std::vector<std::byte> entry_table, state_table;
+        std::string name_table;
+        std::uint32_t count = 0;
+
+
+        auto append = [] (std::vector<std::byte>& dst, const auto& value) {
+            const auto* bytes = (const std::byte*) &value;
+            dst.insert(dst.end(), bytes, bytes + sizeof(value));
+        };
+
+        for (const auto& [name, state] : symbols) {
+            const std::uint64_t hash = stable_hash(name);
+            std::uint32_t bucket = (std::uint32_t) hash & (buckets - 1);
+            bool duplicate = false;
+
+            // Objects may contain the same name more than once (e.g. for static symbols), only store its first occurrence.
+            for (; bucket_table[bucket] != 0; bucket = (bucket + 1) & (buckets - 1)) {
+                std::size_t entry = (std::size_t) (bucket_table[bucket] - 1) * ENTRY_SIZE;
+
+                if (read_le<std::uint64_t>(entry_table, entry) == hash) {
+                    auto offset = read_le<std::uint32_t>(entry_table, entry + 8);
+                    auto length = read_le<std::uint32_t>(entry_table, entry + 12);
+
+                    if (std::string_view { name_table }.substr(offset, length) == name) {
+                        duplicate = true;
+                        break;
+                    }
+                }
+            }
+
+            if (duplicate) continue;
+
+
+            bucket_table[bucket] = ++count;
+
+            append(entry_table, hash);
+            append(entry_table, (std::uint32_t) name_table.size());
+            append(entry_table, (std::uint32_t) name.size());
+            append(state_table, (char) state);
+
+            name_table += name;
+        }
+
+
+        const std::uint32_t settings_offset = HEADER_SIZE;
+        const std::uint32_t buckets_offset  = settings_offset + (std::uint32_t) settings_text.size();
+        const std::uint32_t entries_offset  = buckets_offset + buckets * (std::uint32_t) sizeof(std::uint32_t);
+        const std::uint32_t states_offset   = entries_offset + (std::uint32_t) entry_table.size();
+        const std::uint32_t names_offset    = states_offset + (std::uint32_t) state_table.size();
+
+        std::vector<std::byte> result;
+        result.reserve(names_offset + name_table.size());
+
+        append(result, FORMAT_MAGIC);
+        append(result, FORMAT_VERSION);
+        append(result, hash_settings(settings));
+        append(result, count);
+        append(result, buckets);
+        append(result, settings_offset);
+        append(result, (std::uint32_t) settings_text.size());
+        append(result, buckets_offset);
+        append(result, entries_offset);
+        append(result, states_offset);
+        append(result, names_offset);
+        append(result, (std::uint32_t) name_table.size());
+        append(result, (std::uint32_t) 0); // Reserved.
+        append(result, identity.size);
+        append(result, identity.modification_time);
+        append(result, identity.content_hash);
+
+        auto append_bytes = [&] (const void* src, std::size_t size) {
+            result.insert(result.end(), (const std::byte*) src, (const std::byte*) src + size);
+        };
+
+        append_bytes(settings_text.data(), settings_text.size());
+        append_bytes(bucket_table.data(), bucket_table.size() * sizeof(std::uint32_t));
+        append_bytes(entry_table.data(), entry_table.size());
+        append_bytes(state_table.data(), state_table.size());
+        append_bytes(name_table.data(), name_table.size());
+
+        return result;
+    }
+
+
+    void object_cache::write(const fs::path& path, std::span<const std::byte> contents) {
+        // Caches are optional, so failing to write one only means the object has to be processed again next time.
+        fs::path temp_path = get_temporary_path(path);
+        std::error_code ec;
+
+        {
+            std::ofstream stream { temp_path, std::ios::binary | std::ios::trunc };
+            stream.write((const char*) contents.data(), (std::streamsize) contents.size());
+
+            if (!stream) {
+                logger::instance().warning("Failed to write to cache file ", temp_path);
+
+                stream.close();
+                fs::remove(temp_path, ec);
+
+                return;
+            }
+        }
+
+
+        fs::rename(temp_path, path, ec);
+
+        if (ec) {
+            logger::instance().warning("Failed to replace cache file ", path, ": ", ec.message());
+            fs::remove(temp_path, ec);
+        }
+    }
+
+
+    void object_cache::set_object_identity(std::span<std::byte> contents, const object_identity& identity) {
+        if (contents.size() < HEADER_SIZE) return;
+
+        std::memcpy(contents.data() + IDENTITY_OFFSET,      &identity.size,              sizeof(identity.size));
+        std::memcpy(contents.data() + IDENTITY_OFFSET + 8,  &identity.modification_time, sizeof(identity.modification_time));
+        std::memcpy(contents.data() + IDENTITY_OFFSET + 16, &identity.content_hash,      sizeof(identity.content_hash));
+    }
+
+
+    void object_cache::update_object_identity(const fs::path& path, const object_identity& identity) {
+        std::fstream stream { path, std::ios::binary | std::ios::in | std::ios::out };
+        stream.seekp(IDENTITY_OFFSET);
+
+        stream.write((const char*) &identity.size, sizeof(identity.size));
+        stream.write((const char*) &identity.modification_time, sizeof(identity.modification_time));
+        stream.write((const char*) &identity.content_hash, sizeof(identity.content_hash));
+
+        if (!stream) logger::instance().warning("Failed to update cache file ", path);
+    }
+}
\ No newline at end of file
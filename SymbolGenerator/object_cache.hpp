@@ -0,0 +1,115 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+#include <SymbolGenerator/coff_reader.hpp>
+#include <SymbolGenerator/mapped_file.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+namespace symgen {
+    enum class symbol_state : char {
+        FUNCTION = 'F', DATA = 'D', EXCLUDED = 'E'
+    };
+
+
+    // Metadata of the object file a cache was created for, used to skip unchanged objects without parsing them.
+    struct object_identity {
+        std::uint64_t size = 0;
+        std::int64_t modification_time = 0;
+        std::uint64_t content_hash = 0;
+
+        bool operator==(const object_identity&) const = default;
+    };
+
+
+    // Read-only view of a .objcache file, which stores the final state of every symbol of a single object.
+    // The file is memory-mapped and queried in place, so opening a cache does not allocate anything per symbol.
+    // The same format is used for the entries of the project-wide cache_database, in which case the view refers into the database instead.
+    //
+    // Layout (all integers are little-endian):
+    //  - Header: magic, format version, settings hash, entry and bucket counts, the offset of every other section and the object identity.
+    //  - Settings: the settings the cache was created with, as key=value lines, used to explain why a cache is out of date.
+    //  - Buckets: open-addressed hash table of one-based entry indices (zero for an empty bucket). The bucket count is a power of two.
+    //  - Entries: per symbol, the stable_hash of its name and the offset and length of the name.
+    //  - States: one symbol_state byte per entry.
+    //  - Names: all symbol names, without separators.
+    class object_cache {
+    public:
+        constexpr static std::uint32_t FORMAT_MAGIC   = 0x434F4753; // "SGOC"
+        constexpr static std::uint32_t FORMAT_VERSION = 5;
+
+
+        object_cache(void) = default;
+        explicit object_cache(const fs::path& path);
+        // The contents must outlive the cache.
+        explicit object_cache(std::span<const std::byte> contents);
+
+
+        [[nodiscard]] std::optional<symbol_state> find(std::string_view name) const;
+
+
+        // Invokes the given function with the name and state of every symbol in the cache.
+        template <typename F> void for_each_symbol(F&& fn) const {
+            for (std::uint32_t i = 0; i < entry_count; ++i) {
+                auto name = get_entry_name(i);
+                if (name) fn(*name, (symbol_state) states[i]);
+            }
+        }
+
+        // Settings the cache was created with. These are parsed on demand, since they are only needed if the settings hash differs.
+        [[nodiscard]] hash_map<std::string, std::string> get_settings(void) const;
+        [[nodiscard]] std::uint64_t get_settings_hash(void) const { return settings_hash; }
+
+        // Returns an error if the file could not be used as a cache, e.g. because it uses an older format.
+        [[nodiscard]] const std::optional<std::string>& get_error(void) const { return error; }
+        [[nodiscard]] std::size_t size(void) const { return entry_count; }
+        [[nodiscard]] bool is_valid(void) const { return !error && !data.empty(); }
+        [[nodiscard]] const object_identity& get_object_identity(void) const { return identity; }
+        [[nodiscard]] std::span<const std::byte> get_contents(void) const { return data; }
+
+
+        // Hash of the given settings that does not depend on the order of the space-separated values of each setting.
+        [[nodiscard]] static std::uint64_t hash_settings(const hash_map<std::string, std::string>& settings);
+
+        // Serializes a new cache into the format described above.
+        [[nodiscard]] static std::vector<std::byte> serialize(
+            const object_identity& identity,
+            const hash_map<std::string, std::string>& settings,
+            std::span<const std::pair<std::string_view, symbol_state>> symbols
+        );
+
+        // Writes a serialized cache to a file. The file is written to a temporary file first, so a cache file is never left half-written.
+        // Failing to write the cache only results in a warning, since the object is simply processed again the next time.
+        // Any object_cache viewing the same path must be closed first, since a mapped file cannot be replaced on Windows.
+        static void write(const fs::path& path, std::span<const std::byte> contents);
+
+        // Overwrites the object identity of a serialized cache, or of an existing cache file in place, e.g. if the object was touched without its contents changing.
+        static void set_object_identity(std::span<std::byte> contents, const object_identity& identity);
+        static void update_object_identity(const fs::path& path, const object_identity& identity);
+
+        // Identity of the object file read by the given reader. Only the tables of the object are hashed, since they determine the state of every symbol,
+        // so the raw data of its sections is never read. Archive members use the path of the archive, whose timestamp they share.
+        [[nodiscard]] static object_identity identify(const fs::path& path, const coff_reader& reader);
+    private:
+        mapped_file file;
+        std::span<const std::byte> data;
+        std::optional<std::string> error = std::nullopt;
+
+        std::uint64_t settings_hash = 0;
+        std::uint32_t entry_count = 0, bucket_count = 0;
+        object_identity identity;
+
+        std::span<const std::byte> settings, buckets, entries, states, names;
+
+
+        void parse_headers(void);
+        [[nodiscard]] std::optional<std::string_view> get_entry_name(std::uint32_t index) const;
+    };
+}
\ No newline at end of file
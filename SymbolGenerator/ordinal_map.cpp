@@ -0,0 +1,78 @@
+#include <SymbolGenerator/ordinal_map.hpp>
+#include <SymbolGenerator/utility.hpp>
+#include <SymbolGenerator/logger.hpp>
+
+#include <charconv>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+
+namespace symgen {
+    ordinal_map::ordinal_map(fs::path path) : path(std::move(path)) {
+        std::ifstream stream { this->path };
+        if (!stream) return;
+
+        std::string line;
+        std::size_t line_number = 0;
+
+        while (std::getline(stream, line)) {
+            ++line_number;
+            if (line.empty()) continue;
+
+            std::string_view sv { line };
+            auto separator = sv.find(' ');
+
+            std::uint32_t ordinal = 0;
+            auto [end, error] = std::from_chars(sv.data(), sv.data() + (std::min)(separator, sv.size()), ordinal);
+
+            if (separator == std::string_view::npos || error != std::errc { } || end != sv.data() + separator || ordinal == 0 || ordinal > MAX_ORDINAL) {
+                logger::instance().warning("Ignoring invalid line ", line_number, " in ordinal map ", this->path, ".");
+                continue;
+            }
+
+
+            auto [it, inserted] = ordinals.try_emplace(std::string { sv.substr(separator + 1) }, (std::uint16_t) ordinal);
+
+            if (!inserted) {
+                logger::instance().warning("Ignoring duplicate symbol on line ", line_number, " in ordinal map ", this->path, ".");
+                continue;
+            }
+
+            next_ordinal = (std::max)(next_ordinal, ordinal + 1);
+        }
+
+        logger::instance().verbose("Loaded ", ordinals.size(), " ordinals from ", this->path, ".");
+    }
+
+
+    std::optional<std::uint16_t> ordinal_map::get_or_assign(std::string_view name) {
+        if (auto it = ordinals.find(name); it != ordinals.end()) return it->second;
+        if (next_ordinal > MAX_ORDINAL) return std::nullopt;
+
+        modified = true;
+
+        auto ordinal = (std::uint16_t) next_ordinal++;
+        ordinals.emplace(name, ordinal);
+
+        return ordinal;
+    }
+
+
+    bool ordinal_map::save(void) const {
+        if (!modified) return true;
+
+
+        std::vector<std::pair<std::uint16_t, std::string_view>> entries;
+        entries.reserve(ordinals.size());
+
+        for (const auto& [name, ordinal] : ordinals) entries.emplace_back(ordinal, name);
+        ranges::sort(entries);
+
+
+        std::string contents;
+        for (const auto& [ordinal, name] : entries) contents += stream_to_string(ordinal, " ", name, "\n");
+
+        return write_file_if_changed(path, contents) != write_result::FAILED;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+
+namespace symgen {
+    // Ordinals assigned to exported symbols, stored next to the .def file so they stay the same between runs when using -ordinal.
+    // Symbols keep their ordinal once it is assigned, and new symbols get ordinals after all existing ones, so adding or removing a symbol
+    // never renumbers any other symbol. Ordinals of removed symbols are not reused, since binaries linked against an older import library
+    // would otherwise silently call a different function.
+    //
+    // The file contains one "<ordinal> <mangled name>" line per symbol, ordered by ordinal.
+    class ordinal_map {
+    public:
+        // Zero is not a valid ordinal, and the largest ordinal is reserved, matching the symbol limit for .def files.
+        constexpr static std::uint32_t MAX_ORDINAL = UINT16_MAX - 1;
+
+
+        // Loads the map from the given file, if it exists.
+        explicit ordinal_map(fs::path path);
+
+
+        // Returns the ordinal of the given symbol, and assigns it the next unused ordinal if it does not have one yet.
+        // Returns nothing if all ordinals are in use.
+        [[nodiscard]] std::optional<std::uint16_t> get_or_assign(std::string_view name);
+
+        // Writes the map back to its file, if any ordinals were assigned. Returns false if the file could not be written.
+        [[nodiscard]] bool save(void) const;
+
+
+        [[nodiscard]] const fs::path& get_path(void) const { return path; }
+        [[nodiscard]] std::size_t size(void) const { return ordinals.size(); }
+    private:
+        fs::path path;
+        hash_map<std::string, std::uint16_t> ordinals;
+
+        std::uint32_t next_ordinal = 1;
+        bool modified = false;
+    };
+}
\ No newline at end of file
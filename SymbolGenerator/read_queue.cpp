@@ -0,0 +1,713 @@
+#include <SymbolGenerator/read_queue.hpp>
+#include <SymbolGenerator/coff_reader.hpp>
+#include <SymbolGenerator/utility.hpp>
+#include <SymbolGenerator/logger.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+
+    #include <cerrno>
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+    #include <linux/io_uring.h>
+
+    // Objects are opened through IORING_OP_OPENAT and IORING_OP_STATX, which were added in Linux 5.6 together with IORING_FEAT_CUR_PERSONALITY.
+    #ifdef IORING_FEAT_CUR_PERSONALITY
+        #define SYMGEN_IO_URING
+
+        #include <sys/mman.h>
+        #include <sys/syscall.h>
+        #include <sys/uio.h>
+    #endif
+#endif
+
+
+namespace symgen {
+    // Number of bytes read from the start of every object before the locations of its tables are known.
+    // This always includes the file header, and for most objects the section table as well.
+    constexpr std::size_t HEAD_SIZE = 4096;
+
+
+    #ifdef _WIN32
+        using native_file = HANDLE;
+        const native_file INVALID_FILE = INVALID_HANDLE_VALUE;
+
+
+        static std::optional<std::string> open_file(const fs::path& path, native_file& file, std::size_t& size) {
+            file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+            if (file == INVALID_HANDLE_VALUE) return stream_to_string("failed to open file: ", get_last_winapi_error());
+
+            LARGE_INTEGER file_size;
+            if (!GetFileSizeEx(file, &file_size)) return stream_to_string("failed to get file size: ", get_last_winapi_error());
+
+            size = (std::size_t) file_size.QuadPart;
+            return std::nullopt;
+        }
+
+
+        static void close_file(native_file file) {
+            CloseHandle(file);
+        }
+
+
+        static std::optional<std::string> read_file(native_file file, std::size_t offset, std::span<std::byte> destination) {
+            while (!destination.empty()) {
+                OVERLAPPED position { };
+                position.Offset     = (DWORD) (offset & 0xFFFF'FFFF);
+                position.OffsetHigh = (DWORD) (offset >> 32);
+
+                DWORD count = 0;
+                const auto requested = (DWORD) (std::min)(destination.size(), (std::size_t) (1 << 30));
+
+                if (!ReadFile(file, destination.data(), requested, &count, &position)) return stream_to_string("failed to read file: ", get_last_winapi_error());
+                if (count == 0) return "file is smaller than expected, it may have changed while it was read";
+
+                offset += count;
+                destination = destination.subspan(count);
+            }
+
+            return std::nullopt;
+        }
+    #else
+        using native_file = int;
+        constexpr native_file INVALID_FILE = -1;
+
+
+        static std::optional<std::string> open_file(const fs::path& path, native_file& file, std::size_t& size) {
+            file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (file == -1) return stream_to_string("failed to open file: ", std::strerror(errno));
+
+            struct stat info;
+            if (::fstat(file, &info) != 0) return stream_to_string("failed to get file size: ", std::strerror(errno));
+
+            size = (std::size_t) info.st_size;
+            return std::nullopt;
+        }
+
+
+        static void close_file(native_file file) {
+            ::close(file);
+        }
+
+
+        static std::optional<std::string> read_file(native_file file, std::size_t offset, std::span<std::byte> destination) {
+            while (!destination.empty()) {
+                auto count = ::pread(file, destination.data(), destination.size(), (off_t) offset);
+
+                if (count < 0 && errno == EINTR) continue;
+                if (count < 0) return stream_to_string("failed to read file: ", std::strerror(errno));
+                if (count == 0) return "file is smaller than expected, it may have changed while it was read";
+
+                offset += (std::size_t) count;
+                destination = destination.subspan((std::size_t) count);
+            }
+
+            return std::nullopt;
+        }
+    #endif
+
+
+    // Returns the parts of an object to keep in memory, given the bytes that were already read from its start.
+    // The first part starts at the start of the file and includes the head, and tables that overlap or directly follow each other are merged,
+    // so every table lies within a single part. The raw data of sections in between the tables is not included.
+    static std::vector<coff_reader::byte_range> get_buffer_ranges(std::span<const std::byte> head, std::size_t size) {
+        auto tables = coff_reader::get_table_ranges(head, size);
+        ranges::sort(tables, std::less { }, &coff_reader::byte_range::offset);
+
+        std::vector<coff_reader::byte_range> result { { 0, head.size() } };
+
+        for (const auto& range : tables) {
+            auto& last = result.back();
+
+            if (range.offset <= last.offset + last.size) {
+                last.size = (std::max)(last.offset + last.size, range.offset + range.size) - last.offset;
+            } else {
+                result.push_back(range);
+            }
+        }
+
+        return result;
+    }
+
+
+    prefetched_object::prefetched_object(read_queue* queue, fs::path path) :
+        queue(queue),
+        path(std::move(path))
+    {}
+
+
+    prefetched_object::~prefetched_object(void) {
+        if (started) queue->release();
+    }
+
+
+    void prefetched_object::wait(void) {
+        if (!done.load(std::memory_order_acquire)) {
+            queue->mark_urgent(this);
+            done.wait(false, std::memory_order_acquire);
+        }
+    }
+
+
+    void prefetched_object::cancel(void) {
+        queue->cancel(this);
+    }
+
+
+    std::vector<coff_reader::segment> prefetched_object::get_segments(void) const {
+        std::vector<coff_reader::segment> result;
+        for (const auto& buffer : buffers) result.push_back({ buffer.offset, { buffer.data.get(), buffer.size } });
+
+        return result;
+    }
+
+
+    void prefetched_object::finish(void) {
+        done.store(true, std::memory_order_release);
+        done.notify_all();
+    }
+
+
+    std::span<std::byte> prefetched_object::allocate_head(void) {
+        const auto head_size = (std::min)(size, HEAD_SIZE);
+
+        buffers.clear();
+        buffers.push_back({ 0, head_size, std::make_unique_for_overwrite<std::byte[]>(head_size) });
+
+        return { buffers.front().data.get(), head_size };
+    }
+
+
+    std::vector<prefetched_object::pending_read> prefetched_object::allocate_tables(void) {
+        auto head = std::move(buffers.front());
+        buffers.clear();
+
+        std::vector<pending_read> result;
+
+        for (const auto& range : get_buffer_ranges({ head.data.get(), head.size }, size)) {
+            // The first range always contains the head, which only has to be moved to a larger buffer if a table extends past it.
+            if (range.offset == 0) {
+                if (range.size == head.size) {
+                    buffers.push_back(std::move(head));
+                    continue;
+                }
+
+                auto data = std::make_unique_for_overwrite<std::byte[]>(range.size);
+                std::memcpy(data.get(), head.data.get(), head.size);
+
+                result.push_back({ head.size, { data.get() + head.size, range.size - head.size } });
+                buffers.push_back({ 0, range.size, std::move(data) });
+            } else {
+                auto data = std::make_unique_for_overwrite<std::byte[]>(range.size);
+
+                result.push_back({ range.offset, { data.get(), range.size } });
+                buffers.push_back({ range.offset, range.size, std::move(data) });
+            }
+        }
+
+        return result;
+    }
+
+
+    // Performs every read with a blocking system call on a thread of its own, with as many threads as objects that can be started at once.
+    class thread_backend final : public read_backend {
+    public:
+        thread_backend(read_queue& queue, std::size_t thread_count) : queue(queue) {
+            for (std::size_t i = 0; i < thread_count; ++i) threads.emplace_back([this] { run(); });
+        }
+
+        ~thread_backend(void) override {
+            for (auto& thread : threads) thread.join();
+        }
+
+
+        [[nodiscard]] std::string_view get_name(void) const override { return "threads"; }
+    private:
+        read_queue& queue;
+        std::vector<std::thread> threads;
+
+
+        void run(void) {
+            while (true) {
+                std::shared_ptr<prefetched_object> object;
+
+                {
+                    std::unique_lock lock { queue.mtx };
+                    queue.cv.wait(lock, [&] { return queue.stopping || queue.can_start(); });
+
+                    if (queue.stopping) return;
+                    object = queue.start_next();
+                }
+
+                read(*object);
+                object->finish();
+            }
+        }
+
+
+        static void read(prefetched_object& object) {
+            native_file file = INVALID_FILE;
+            object.error = open_file(object.path, file, object.size);
+
+            if (!object.error) {
+                object.error = read_file(file, 0, object.allocate_head());
+
+                if (!object.error) {
+                    for (const auto& read : object.allocate_tables()) {
+                        object.error = read_file(file, read.offset, read.destination);
+                        if (object.error) break;
+                    }
+                }
+            }
+
+            if (file != INVALID_FILE) close_file(file);
+        }
+    };
+
+
+#ifdef SYMGEN_IO_URING
+    // Keeps the reads of all started objects in flight at once through a single io_uring, which is driven by a single thread.
+    // Objects are opened and their sizes are queried through the ring as well, so a slow open (e.g. on network storage) does not hold up the other objects.
+    // The ring is used through the raw system calls, so no library is required. This requires IORING_OP_OPENAT and IORING_OP_STATX, which are supported since Linux 5.6.
+    class io_uring_backend final : public read_backend {
+    public:
+        // Returns nothing if io_uring is not available, e.g. because the kernel is too old, or io_uring is disabled by a sysctl or seccomp filter.
+        [[nodiscard]] static std::unique_ptr<io_uring_backend> create(read_queue& queue, std::size_t depth) {
+            // Every object has at most two operations in flight at once (opening it and querying its size, or reading the section table and the symbol and string tables).
+            const auto entries = std::bit_ceil((std::uint32_t) std::clamp<std::size_t>(2 * depth, 8, 4096));
+
+            io_uring_params params { };
+            const int fd = (int) ::syscall(__NR_io_uring_setup, entries, &params);
+            if (fd < 0) return nullptr;
+
+            std::unique_ptr<io_uring_backend> result { new io_uring_backend(queue, fd) };
+            if (!result->map_rings(params) || !result->supports_operations()) return nullptr;
+
+            result->thread = std::thread { [backend = result.get()] { backend->run(); } };
+            return result;
+        }
+
+
+        ~io_uring_backend(void) override {
+            if (thread.joinable()) thread.join();
+
+            if (sqes)                          ::munmap(sqes, sqes_size);
+            if (cq_ring && cq_ring != sq_ring) ::munmap(cq_ring, cq_ring_size);
+            if (sq_ring)                       ::munmap(sq_ring, sq_ring_size);
+
+            ::close(ring_fd);
+        }
+
+
+        [[nodiscard]] std::string_view get_name(void) const override { return "io_uring"; }
+    private:
+        // An object that has been started. The file is closed and the object is finished once the last of its operations has completed.
+        struct object_read {
+            std::shared_ptr<prefetched_object> object;
+            native_file file = INVALID_FILE;
+
+            // Result of the size query, and the number of operations (opening the file and querying its size) that have to complete before the head can be read.
+            struct statx info { };
+            int pending_setup = 2;
+
+            ~object_read(void) {
+                if (file != INVALID_FILE) close_file(file);
+                object->finish();
+            }
+        };
+
+        enum class operation_type { OPEN, STAT, READ };
+
+        // An operation on an object, the pointer to which is passed through the kernel as its user data.
+        // For reads, the range of the object that is read.
+        struct operation {
+            operation_type type;
+            std::shared_ptr<object_read> owner;
+            // Remainder of the range, after any short reads.
+            ::iovec destination { };
+            std::size_t offset = 0;
+            bool is_head = false;
+        };
+
+
+        read_queue& queue;
+        std::thread thread;
+
+        int ring_fd;
+        void* sq_ring = nullptr;
+        void* cq_ring = nullptr;
+        io_uring_sqe* sqes = nullptr;
+        std::size_t sq_ring_size = 0, cq_ring_size = 0, sqes_size = 0;
+
+        unsigned* sq_head = nullptr;
+        unsigned* sq_tail = nullptr;
+        unsigned* sq_array = nullptr;
+        unsigned sq_mask = 0, sq_entries = 0;
+
+        unsigned* cq_head = nullptr;
+        unsigned* cq_tail = nullptr;
+        io_uring_cqe* cqes = nullptr;
+        unsigned cq_mask = 0;
+
+        // Only used by the ring thread. Operations are kept in unsubmitted until there is space in the ring.
+        std::deque<std::unique_ptr<operation>> unsubmitted;
+        std::size_t in_flight = 0;
+
+
+        io_uring_backend(read_queue& queue, int ring_fd) : queue(queue), ring_fd(ring_fd) {}
+
+
+        bool map_rings(const io_uring_params& params) {
+            auto map = [&] (std::size_t size, std::uint64_t offset) -> void* {
+                void* result = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, (off_t) offset);
+                return result == MAP_FAILED ? nullptr : result;
+            };
+
+
+            sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cq_ring_size = params.cq_off.cqes  + params.cq_entries * sizeof(io_uring_cqe);
+            sqes_size    = params.sq_entries * sizeof(io_uring_sqe);
+
+            // Since Linux 5.4, both rings are stored in a single mapping.
+            const bool single_mapping = params.features & IORING_FEAT_SINGLE_MMAP;
+            if (single_mapping) sq_ring_size = cq_ring_size = (std::max)(sq_ring_size, cq_ring_size);
+
+            sq_ring = map(sq_ring_size, IORING_OFF_SQ_RING);
+            cq_ring = single_mapping ? sq_ring : map(cq_ring_size, IORING_OFF_CQ_RING);
+            sqes    = (io_uring_sqe*) map(sqes_size, IORING_OFF_SQES);
+
+            if (!sq_ring || !cq_ring || !sqes) return false;
+
+
+            auto field = [] (void* ring, std::uint32_t offset) { return (unsigned*) ((std::byte*) ring + offset); };
+
+            sq_head    = field(sq_ring, params.sq_off.head);
+            sq_tail    = field(sq_ring, params.sq_off.tail);
+            sq_array   = field(sq_ring, params.sq_off.array);
+            sq_mask    = *field(sq_ring, params.sq_off.ring_mask);
+            sq_entries = params.sq_entries;
+
+            cq_head    = field(cq_ring, params.cq_off.head);
+            cq_tail    = field(cq_ring, params.cq_off.tail);
+            cqes       = (io_uring_cqe*) field(cq_ring, params.cq_off.cqes);
+            cq_mask    = *field(cq_ring, params.cq_off.ring_mask);
+
+            return true;
+        }
+
+
+        // Checks the kernel supports every operation used by the backend. Kernels that do not support probing (before Linux 5.6) do not support all of them either.
+        bool supports_operations(void) {
+            constexpr unsigned probe_size = 256;
+
+            auto storage = std::make_unique<std::byte[]>(sizeof(io_uring_probe) + probe_size * sizeof(io_uring_probe_op));
+            auto* probe  = (io_uring_probe*) storage.get();
+
+            if (::syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_PROBE, probe, probe_size) < 0) return false;
+
+            return ranges::all_of(std::array { IORING_OP_OPENAT, IORING_OP_STATX, IORING_OP_READV }, [&] (auto opcode) {
+                return opcode <= probe->last_op && (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED);
+            });
+        }
+
+
+        void run(void) {
+            std::vector<std::shared_ptr<prefetched_object>> started;
+
+            while (true) {
+                {
+                    std::unique_lock lock { queue.mtx };
+
+                    // Only sleep if nothing is in flight, otherwise new objects are started once the next read completes.
+                    if (in_flight == 0 && unsubmitted.empty()) {
+                        queue.cv.wait(lock, [&] { return queue.stopping || queue.can_start(); });
+                        if (queue.stopping) return;
+                    }
+
+                    while (!queue.stopping && queue.can_start()) started.push_back(queue.start_next());
+                }
+
+                // Objects are started without holding the lock, since releasing an object takes the lock as well.
+                for (auto& object : started) start(std::move(object));
+                started.clear();
+
+
+                // Entries the kernel did not consume during the previous call are submitted again, along with the new ones.
+                const unsigned tail = submit();
+                const unsigned pending = tail - std::atomic_ref { *sq_head }.load(std::memory_order_acquire);
+
+                if (in_flight == 0) continue;
+
+                const long result = ::syscall(__NR_io_uring_enter, ring_fd, pending, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+
+                // Interrupted calls and temporary shortages of kernel resources are retried, any other error means the ring itself no longer works.
+                logger::instance().assert_that(
+                    result >= 0 || errno == EINTR || errno == EAGAIN || errno == EBUSY,
+                    "Failed to wait for reads through io_uring: ", std::strerror(errno)
+                );
+
+                complete();
+            }
+        }
+
+
+        // Opens the object and queries its size at the same time. Its head is read once both have completed.
+        void start(std::shared_ptr<prefetched_object> object) {
+            auto owner = std::make_shared<object_read>();
+            owner->object = std::move(object);
+
+            unsubmitted.push_back(std::make_unique<operation>(operation { .type = operation_type::OPEN, .owner = owner }));
+            unsubmitted.push_back(std::make_unique<operation>(operation { .type = operation_type::STAT, .owner = owner }));
+        }
+
+
+        void enqueue(const std::shared_ptr<object_read>& owner, std::size_t offset, std::span<std::byte> destination, bool is_head) {
+            if (destination.empty()) return;
+
+            unsubmitted.push_back(std::make_unique<operation>(operation {
+                .type        = operation_type::READ,
+                .owner       = owner,
+                .destination = { destination.data(), destination.size() },
+                .offset      = offset,
+                .is_head     = is_head
+            }));
+        }
+
+
+        // Moves operations into the submission queue while there is space, and returns the new tail of the queue.
+        unsigned submit(void) {
+            unsigned count = 0;
+            const unsigned tail = std::atomic_ref { *sq_tail }.load(std::memory_order_relaxed);
+
+            // At most as many operations as the ring has entries are in flight, so the completion queue (which is twice as large) can never overflow.
+            while (!unsubmitted.empty() && in_flight < sq_entries) {
+                auto op = std::move(unsubmitted.front());
+                unsubmitted.pop_front();
+
+                const unsigned index = (tail + count) & sq_mask;
+                auto& sqe = sqes[index];
+
+                // The path is owned by the prefetched_object, which the operation keeps alive until it has completed.
+                const auto* path = op->owner->object->path.c_str();
+                sqe = io_uring_sqe { };
+
+                switch (op->type) {
+                    case operation_type::OPEN:
+                        sqe.opcode     = IORING_OP_OPENAT;
+                        sqe.fd         = AT_FDCWD;
+                        sqe.addr       = (std::uint64_t) path;
+                        sqe.open_flags = O_RDONLY | O_CLOEXEC;
+                        break;
+                    case operation_type::STAT:
+                        sqe.opcode = IORING_OP_STATX;
+                        sqe.fd     = AT_FDCWD;
+                        sqe.addr   = (std::uint64_t) path;
+                        sqe.len    = STATX_SIZE;
+                        sqe.off    = (std::uint64_t) &op->owner->info;
+                        break;
+                    case operation_type::READ:
+                        sqe.opcode = IORING_OP_READV;
+                        sqe.fd     = op->owner->file;
+                        sqe.off    = op->offset;
+                        sqe.addr   = (std::uint64_t) &op->destination;
+                        sqe.len    = 1;
+                        break;
+                }
+
+                sqe.user_data = (std::uint64_t) op.release();
+
+                sq_array[index] = index;
+
+                ++count;
+                ++in_flight;
+            }
+
+            // Publishes the entries to the kernel.
+            std::atomic_ref { *sq_tail }.store(tail + count, std::memory_order_release);
+            return tail + count;
+        }
+
+
+        void complete(void) {
+            unsigned head = std::atomic_ref { *cq_head }.load(std::memory_order_relaxed);
+            const unsigned tail = std::atomic_ref { *cq_tail }.load(std::memory_order_acquire);
+
+            for (; head != tail; ++head) {
+                const auto& cqe = cqes[head & cq_mask];
+                std::unique_ptr<operation> op { (operation*) cqe.user_data };
+
+                --in_flight;
+
+                if (op->type == operation_type::READ) handle_read(std::move(op), cqe.res);
+                else handle_setup(std::move(op), cqe.res);
+            }
+
+            std::atomic_ref { *cq_head }.store(head, std::memory_order_release);
+        }
+
+
+        void handle_setup(std::unique_ptr<operation> op, std::int32_t result) {
+            auto& owner  = *op->owner;
+            auto& object = *owner.object;
+
+            if (result == -EINTR || result == -EAGAIN) {
+                unsubmitted.push_back(std::move(op));
+                return;
+            }
+
+
+            if (op->type == operation_type::OPEN) {
+                if (result >= 0) owner.file = result;
+                else if (!object.error) object.error = stream_to_string("failed to open file: ", std::strerror(-result));
+            } else {
+                if (result >= 0) object.size = (std::size_t) owner.info.stx_size;
+                else if (!object.error) object.error = stream_to_string("failed to get file size: ", std::strerror(-result));
+            }
+
+            // The head is read once the file is open and its size is known. If either failed, destroying the last operation finishes the object.
+            if (--owner.pending_setup == 0 && !object.error) enqueue(op->owner, 0, object.allocate_head(), true);
+        }
+
+
+        void handle_read(std::unique_ptr<operation> read, std::int32_t result) {
+            auto& object = *read->owner->object;
+
+            if (result == -EINTR || result == -EAGAIN) {
+                unsubmitted.push_back(std::move(read));
+                return;
+            }
+
+            if (result < 0) {
+                if (!object.error) object.error = stream_to_string("failed to read file: ", std::strerror(-result));
+                return;
+            }
+
+            if (result == 0) {
+                if (!object.error) object.error = "file is smaller than expected, it may have changed while it was read";
+                return;
+            }
+
+
+            // Short reads are continued where they left off.
+            if ((std::size_t) result < read->destination.iov_len) {
+                read->destination.iov_base = (std::byte*) read->destination.iov_base + result;
+                read->destination.iov_len -= (std::size_t) result;
+                read->offset += (std::size_t) result;
+
+                unsubmitted.push_back(std::move(read));
+                return;
+            }
+
+
+            // The head may be moved to a larger buffer, but it is no longer accessed through this read.
+            if (read->is_head && !object.error) {
+                for (const auto& table_read : object.allocate_tables()) {
+                    enqueue(read->owner, table_read.offset, table_read.destination, false);
+                }
+            }
+
+            // If this was the last read of the object, destroying it finishes the object.
+        }
+    };
+#endif
+
+
+    read_queue::read_queue(std::size_t depth) : depth((std::max)(depth, (std::size_t) 1)) {
+        #ifdef SYMGEN_IO_URING
+            backend = io_uring_backend::create(*this, this->depth);
+        #endif
+
+        if (!backend) backend = std::make_unique<thread_backend>(*this, this->depth);
+    }
+
+
+    read_queue::~read_queue(void) {
+        {
+            std::lock_guard lock { mtx };
+            stopping = true;
+        }
+
+        cv.notify_all();
+        backend.reset();
+    }
+
+
+    std::shared_ptr<prefetched_object> read_queue::prefetch(const fs::path& path) {
+        auto result = std::make_shared<prefetched_object>(this, path);
+
+        {
+            std::lock_guard lock { mtx };
+            waiting.push_back(result);
+        }
+
+        cv.notify_all();
+        return result;
+    }
+
+
+    bool read_queue::can_start(void) const {
+        return !waiting.empty() && (active < depth || waiting.front()->urgent);
+    }
+
+
+    std::shared_ptr<prefetched_object> read_queue::start_next(void) {
+        auto result = std::move(waiting.front());
+        waiting.pop_front();
+
+        result->started = true;
+        ++active;
+
+        return result;
+    }
+
+
+    void read_queue::mark_urgent(prefetched_object* object) {
+        {
+            std::lock_guard lock { mtx };
+            object->urgent = true;
+
+            // Move the object to the front of the queue, unless it was already started.
+            auto it = ranges::find(waiting, object, [] (const auto& entry) { return entry.get(); });
+            if (it != waiting.end()) std::rotate(waiting.begin(), it, std::next(it));
+        }
+
+        cv.notify_all();
+    }
+
+
+    void read_queue::cancel(prefetched_object* object) {
+        {
+            std::lock_guard lock { mtx };
+
+            auto it = ranges::find(waiting, object, [] (const auto& entry) { return entry.get(); });
+            if (it != waiting.end()) waiting.erase(it);
+        }
+
+        // The next object may be one that is waited for, which can be started even if the queue is full.
+        cv.notify_all();
+    }
+
+
+    void read_queue::release(void) {
+        {
+            std::lock_guard lock { mtx };
+            --active;
+        }
+
+        cv.notify_all();
+    }
+}
\ No newline at end of file
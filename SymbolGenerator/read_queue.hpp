@@ -0,0 +1,149 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+#include <SymbolGenerator/coff_reader.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace symgen {
+    class read_queue;
+
+
+    // Object file that is read in the background by a read_queue.
+    // Only the parts of the object that are accessed by a coff_reader are read and kept in memory, i.e. the file header, the section table,
+    // the symbol table and the string table. The raw data of the sections in between is never allocated.
+    class prefetched_object {
+    public:
+        prefetched_object(read_queue* queue, fs::path path);
+        ~prefetched_object(void);
+
+        prefetched_object(const prefetched_object&) = delete;
+        prefetched_object& operator=(const prefetched_object&) = delete;
+
+
+        // Waits until the object has been read. If the object has not been read yet, it is read before any other object.
+        void wait(void);
+
+        // Removes the object from the queue if it has not been started yet, e.g. because it turned out to be unchanged. The object must not be waited for afterwards.
+        void cancel(void);
+
+        // Returns an error message if the object could not be read. Only valid after wait() has returned.
+        [[nodiscard]] const std::optional<std::string>& get_error(void) const { return error; }
+
+        // Returns the parts of the object that were read, to construct a coff_reader from. Only valid after wait() has returned without an error.
+        [[nodiscard]] std::vector<coff_reader::segment> get_segments(void) const;
+        [[nodiscard]] std::size_t get_size(void) const { return size; }
+
+        [[nodiscard]] const fs::path& get_path(void) const { return path; }
+    private:
+        friend class read_queue;
+        friend class io_uring_backend;
+        friend class thread_backend;
+
+        read_queue* queue;
+        fs::path path;
+
+        // Part of the object that is kept in memory.
+        struct read_buffer {
+            std::size_t offset, size;
+            std::unique_ptr<std::byte[]> data;
+        };
+
+        // Part of the object that still has to be read, and the memory it is read into.
+        struct pending_read {
+            std::size_t offset;
+            std::span<std::byte> destination;
+        };
+
+
+        // Only accessed by the backend until the object is done.
+        std::size_t size = 0;
+        std::vector<read_buffer> buffers;
+        std::optional<std::string> error;
+
+        std::atomic_bool done = false;
+        // Set once a worker is waiting for the object, so it is started even if the queue is full, and once the object has been started.
+        // Both are guarded by the mutex of the queue.
+        bool urgent  = false;
+        bool started = false;
+
+        void finish(void);
+
+        // Allocates the buffer the first bytes of the object are read into, before the locations of its tables are known.
+        std::span<std::byte> allocate_head(void);
+        // Allocates the buffers for the tables of the object once its head has been read, and returns the reads that fill them.
+        // The tables are stored in as few buffers as possible, each of which covers a contiguous part of the file, so every table lies within a single buffer.
+        std::vector<pending_read> allocate_tables(void);
+    };
+
+
+    // Backend that performs the reads of a read_queue on threads of its own.
+    class read_backend {
+    public:
+        virtual ~read_backend(void) = default;
+
+        [[nodiscard]] virtual std::string_view get_name(void) const = 0;
+    };
+
+
+    // Reads objects in the background, in the order they are requested, so they are already in memory once a worker gets to them.
+    // At most a fixed number of objects are being read or waiting to be processed at any time, which bounds both the number of outstanding reads
+    // and the memory used by objects that have been read ahead (which is the size of their tables, rather than the size of the objects). Objects that are waited for are always started immediately, so a worker never waits
+    // for objects that are queued in front of its own.
+    //
+    // On Linux, objects are opened and read through io_uring, so a single thread keeps all of them in flight.
+    // Elsewhere, or if io_uring is not available (e.g. on kernels before 5.6 or if it is disabled for the process), every object is read by a thread of its own.
+    class read_queue {
+    public:
+        explicit read_queue(std::size_t depth);
+        ~read_queue(void);
+
+        read_queue(const read_queue&) = delete;
+        read_queue& operator=(const read_queue&) = delete;
+
+
+        // Starts reading the given object once there is space in the queue.
+        [[nodiscard]] std::shared_ptr<prefetched_object> prefetch(const fs::path& path);
+
+        // Name of the mechanism used to perform the reads, for diagnostics.
+        [[nodiscard]] std::string_view get_backend_name(void) const { return backend->get_name(); }
+        [[nodiscard]] std::size_t get_depth(void) const { return depth; }
+    private:
+        friend class prefetched_object;
+        friend class io_uring_backend;
+        friend class thread_backend;
+
+        std::size_t depth;
+
+        std::mutex mtx;
+        std::condition_variable cv;
+        // Objects that have not been started yet, in the order they were requested.
+        std::deque<std::shared_ptr<prefetched_object>> waiting;
+        // Number of objects that have been started, and whose prefetched_object has not been destroyed yet.
+        std::size_t active = 0;
+        bool stopping = false;
+
+        std::unique_ptr<read_backend> backend;
+
+
+        // Returns whether the next object can be started. Must be called with the lock held.
+        [[nodiscard]] bool can_start(void) const;
+        // Removes the next object from the queue and counts it as active. Must be called with the lock held, and only if can_start() returned true.
+        [[nodiscard]] std::shared_ptr<prefetched_object> start_next(void);
+
+        void mark_urgent(prefetched_object* object);
+        void cancel(prefetched_object* object);
+        void release(void);
+    };
+}
\ No newline at end of file
@@ -3,11 +3,27 @@
 #include <SymbolGenerator/defs.hpp>
 #include <SymbolGenerator/argument_parser.hpp>
 #include <SymbolGenerator/utility.hpp>
+#include <SymbolGenerator/rule_engine.hpp>
 
-#include <regex>
+#include <algorithm>
+#include <array>
+#include <sstream>
+#include <string>
+#include <tuple>
 
 
 namespace symgen {
+    struct rule_set {
+        // The original pattern strings, for reporting which rule matched.
+        std::vector<std::string> patterns;
+        rule_engine engine;
+
+
+        [[nodiscard]] std::optional<std::size_t> match(std::string_view str) const { return engine.match(str); }
+        [[nodiscard]] bool empty(void) const { return patterns.empty(); }
+    };
+
+
     class rule_cache {
     public:
         static rule_cache& instance(void) {
@@ -16,31 +32,87 @@ namespace symgen {
         }
 
 
-        [[nodiscard]] const std::vector<std::regex>& get_includes(void) const { return include; }
-        [[nodiscard]] const std::vector<std::regex>& get_excludes(void) const { return exclude; }
-        [[nodiscard]] const std::vector<std::regex>& get_force_includes(void) const { return force_include; }
-        [[nodiscard]] const std::vector<std::regex>& get_force_excludes(void) const { return force_exclude; }
+        [[nodiscard]] const rule_set& get_includes(void) const { return include; }
+        [[nodiscard]] const rule_set& get_excludes(void) const { return exclude; }
+        [[nodiscard]] const rule_set& get_force_includes(void) const { return force_include; }
+        [[nodiscard]] const rule_set& get_force_excludes(void) const { return force_exclude; }
+
+
+        // Generates the C++ source file for -emit-matcher, which contains the compiled tables of all rules.
+        // Compiling the file into the program registers the tables, so the same rules no longer have to be compiled at startup.
+        [[nodiscard]] std::string generate_matcher_source(void) const {
+            std::ostringstream stream;
+
+            stream << "// Generated by SymbolGenerator -emit-matcher. Do not edit, rerun SymbolGenerator with the new rules instead.\n";
+            stream << "// Generated from the following rules:\n";
+
+            for (const auto& [field, precompiled_field, argument] : fields) {
+                if (!(this->*field).empty()) stream << "//  -" << argument << " " << join((this->*field).patterns, " ") << "\n";
+            }
+
+            stream << "#include <SymbolGenerator/rule_engine.hpp>\n\n\n";
+            stream << "namespace {\n";
+            stream << "    using namespace std::string_view_literals;\n\n\n";
+
+            for (const auto& [field, precompiled_field, argument] : fields) {
+                const auto& rules = this->*field;
+
+                rules.engine.write_tables(stream, stream_to_string("rules_", argument), rules.patterns);
+                stream << "\n\n";
+            }
+
+            stream << "    constexpr symgen::precompiled_rules rules { rules_y, rules_n, rules_yo, rules_no };\n\n";
+            stream << "    [[maybe_unused]] const bool registered = (symgen::precompiled_rules::registered() = &rules, true);\n";
+            stream << "}\n";
+
+            return stream.str();
+        }
     private:
-        std::vector<std::regex> include, exclude, force_include, force_exclude;
+        rule_set include, exclude, force_include, force_exclude;
+
+
+        constexpr static std::array fields {
+            std::tuple { &rule_cache::include,       &precompiled_rules::include,       "y"sv  },
+            std::tuple { &rule_cache::exclude,       &precompiled_rules::exclude,       "n"sv  },
+            std::tuple { &rule_cache::force_include, &precompiled_rules::force_include, "yo"sv },
+            std::tuple { &rule_cache::force_exclude, &precompiled_rules::force_exclude, "no"sv }
+        };
 
 
         rule_cache(void) {
-            constexpr std::array fields {
-                std::tuple { &rule_cache::include, "y"sv },
-                std::tuple { &rule_cache::exclude, "n"sv },
-                std::tuple { &rule_cache::force_include, "yo"sv },
-                std::tuple { &rule_cache::force_exclude, "no"sv }
-            };
+            const auto* precompiled = precompiled_rules::registered();
+
+            for (const auto& [field, precompiled_field, argument] : fields) {
+                auto& rules = this->*field;
 
+                if (auto value = argument_parser::instance().template get_argument<std::string>(argument); value) {
+                    std::string_view sv { *value };
+                    for (auto substr : split(sv, " ")) {
+                        rules.patterns.emplace_back(substr);
+                    }
+                }
 
-            for (const auto& [field, argument] : fields) {
-                auto value = argument_parser::instance().template get_argument<std::string>(argument);
-                if (!value) continue;
 
-                std::string_view sv { *value };
-                for (auto substr : split(sv, " ")) {
-                    (this->*field).emplace_back(substr.begin(), substr.end());
+                // Precompiled tables are only used if they were generated from exactly the same patterns, so outdated tables are never used by accident.
+                if (precompiled && std::ranges::equal((precompiled->*precompiled_field).patterns, rules.patterns)) {
+                    rules.engine = rule_engine { precompiled->*precompiled_field };
+
+                    if (!rules.empty()) logger::instance().verbose("Using precompiled tables for ", rules.patterns.size(), " ", argument, " rule(s).");
+                    continue;
+                }
+
+                if (precompiled) {
+                    logger::instance().warning("The precompiled ", argument, " rules differ from the ones provided, so they are compiled at startup instead. Rerun -emit-matcher to update them.");
                 }
+
+                if (rules.empty()) continue;
+
+                rules.engine = rule_engine { rules.patterns };
+
+                logger::instance().verbose(
+                    "Compiled ", rules.patterns.size(), " ", argument, " rule(s) into ", rules.engine.get_automaton_count(), " automata ",
+                    "(", rules.engine.get_fallback_count(), " rule(s) use std::regex)."
+                );
             }
         }
     };
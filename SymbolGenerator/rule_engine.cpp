@@ -0,0 +1,748 @@
+#include <SymbolGenerator/rule_engine.hpp>
+#include <SymbolGenerator/utility.hpp>
+
+#include <algorithm>
+#include <bitset>
+#include <cctype>
+#include <memory>
+#include <utility>
+
+
+namespace symgen {
+    namespace {
+        // Thrown when a pattern uses a construct that cannot be compiled, in which case it falls back to std::regex.
+        struct unsupported_pattern {};
+
+
+        constexpr std::size_t MAX_PARSE_DEPTH = 256;
+        constexpr std::size_t MAX_REPEAT      = 1024;
+        constexpr std::size_t MAX_NFA_STATES  = 1 << 16;
+        constexpr std::size_t MAX_DFA_STATES  = 1 << 11;
+        constexpr std::size_t UNBOUNDED       = std::numeric_limits<std::size_t>::max();
+
+
+        using charset = std::bitset<256>;
+
+
+        struct regex_node {
+            enum node_type { EMPTY, CHARSET, CONCAT, ALTERNATION, REPEAT } type = EMPTY;
+
+            charset chars;
+            std::vector<std::unique_ptr<regex_node>> children;
+            std::size_t min = 0, max = 0;
+
+            // Number of NFA states required to compile this node.
+            std::size_t state_count = 1;
+        };
+
+        using node_ptr = std::unique_ptr<regex_node>;
+
+
+        // Recursive descent parser for the subset of the ECMAScript grammar that describes regular languages.
+        // Since patterns are always matched against the entire string, ^ and $ are only accepted at the start and end of a top-level alternative.
+        class regex_parser {
+        public:
+            explicit regex_parser(std::string_view pattern) : input(pattern) {}
+
+
+            node_ptr parse(void) {
+                auto result = alternation(0);
+                if (position != input.size()) throw unsupported_pattern { };
+
+                return result;
+            }
+        private:
+            std::string_view input;
+            std::size_t position = 0;
+
+
+            [[nodiscard]] bool at_end(void) const { return position == input.size(); }
+            [[nodiscard]] char peek(void) const { return at_end() ? '\0' : input[position]; }
+            char next(void) { if (at_end()) throw unsupported_pattern { }; return input[position++]; }
+
+            bool consume(std::string_view sv) {
+                if (!input.substr(position).starts_with(sv)) return false;
+
+                position += sv.size();
+                return true;
+            }
+
+
+            static node_ptr make_charset(const charset& chars) {
+                auto node   = std::make_unique<regex_node>();
+                node->type  = regex_node::CHARSET;
+                node->chars = chars;
+                node->state_count = 2;
+
+                return node;
+            }
+
+
+            node_ptr alternation(std::size_t depth) {
+                if (depth > MAX_PARSE_DEPTH) throw unsupported_pattern { };
+
+                auto node  = std::make_unique<regex_node>();
+                node->type = regex_node::ALTERNATION;
+                node->state_count = 2;
+
+                do {
+                    node->children.push_back(concatenation(depth));
+                    node->state_count += node->children.back()->state_count;
+                } while (consume("|"));
+
+
+                if (node->children.size() == 1) return std::move(node->children.front());
+                return node;
+            }
+
+
+            node_ptr concatenation(std::size_t depth) {
+                auto node  = std::make_unique<regex_node>();
+                node->type = regex_node::CONCAT;
+                node->state_count = 1;
+
+                if (depth == 0) consume("^");
+
+                while (!at_end() && peek() != '|' && peek() != ')') {
+                    if (peek() == '$') {
+                        ++position;
+                        if (depth != 0 || !(at_end() || peek() == '|')) throw unsupported_pattern { };
+                        break;
+                    }
+
+                    node->children.push_back(repetition(depth));
+                    node->state_count += node->children.back()->state_count;
+                }
+
+                return node;
+            }
+
+
+            node_ptr repetition(std::size_t depth) {
+                auto node = atom(depth);
+
+
+                std::size_t min, max;
+
+                if      (consume("*")) { min = 0; max = UNBOUNDED; }
+                else if (consume("+")) { min = 1; max = UNBOUNDED; }
+                else if (consume("?")) { min = 0; max = 1; }
+                else if (consume("{")) {
+                    min = number();
+                    max = min;
+
+                    if (consume(",")) max = (peek() == '}') ? UNBOUNDED : number();
+                    if (!consume("}") || max < min) throw unsupported_pattern { };
+                }
+                else return node;
+
+
+                // Laziness doesn't affect whether the entire string matches, so lazy quantifiers are equivalent to greedy ones here.
+                consume("?");
+
+                // Repeating a quantifier directly is an error in ECMAScript. Leave reporting it to std::regex.
+                if (std::string_view { "*+?{" }.find(peek()) != std::string_view::npos && !at_end()) throw unsupported_pattern { };
+
+
+                std::size_t copies = (max == UNBOUNDED) ? min + 1 : max;
+                if (copies > MAX_REPEAT || node->state_count * copies > MAX_NFA_STATES) throw unsupported_pattern { };
+
+                auto repeat = std::make_unique<regex_node>();
+                repeat->type        = regex_node::REPEAT;
+                repeat->min         = min;
+                repeat->max         = max;
+                repeat->state_count = (node->state_count + 2) * copies + 1;
+                repeat->children.push_back(std::move(node));
+
+                return repeat;
+            }
+
+
+            std::size_t number(void) {
+                if (at_end() || !std::isdigit((unsigned char) peek())) throw unsupported_pattern { };
+
+                std::size_t result = 0;
+                while (!at_end() && std::isdigit((unsigned char) peek())) {
+                    result = result * 10 + (std::size_t) (next() - '0');
+                    if (result > MAX_REPEAT) throw unsupported_pattern { };
+                }
+
+                return result;
+            }
+
+
+            node_ptr atom(std::size_t depth) {
+                char c = next();
+
+                switch (c) {
+                    case '(': {
+                        // Capture groups behave like non-capturing groups, since captures are never used.
+                        // Lookaheads and other extensions cannot be compiled.
+                        if (consume("?")) {
+                            if (!consume(":")) throw unsupported_pattern { };
+                        }
+
+                        auto node = alternation(depth + 1);
+                        if (!consume(")")) throw unsupported_pattern { };
+
+                        return node;
+                    }
+
+                    case '.': {
+                        charset chars;
+                        chars.set();
+                        chars.reset('\n');
+                        chars.reset('\r');
+
+                        return make_charset(chars);
+                    }
+
+                    case '[':  return make_charset(bracket_expression());
+                    case '\\': return make_charset(escape());
+
+                    // Characters that are either special or an error when unescaped.
+                    case '^': case '$': case '*': case '+': case '?': case '{': case '}': case ']': case ')': case '|':
+                        throw unsupported_pattern { };
+
+                    default: {
+                        charset chars;
+                        chars.set((unsigned char) c);
+
+                        return make_charset(chars);
+                    }
+                }
+            }
+
+
+            charset bracket_expression(void) {
+                bool negated = consume("^");
+                charset chars;
+
+                // An empty class or a class starting with ] is handled inconsistently between implementations.
+                if (peek() == ']') throw unsupported_pattern { };
+
+
+                while (!consume("]")) {
+                    // Character classes ([:alpha:]), collating elements and equivalence classes.
+                    if (consume("[:") || consume("[.") || consume("[=")) throw unsupported_pattern { };
+
+
+                    auto [first, first_char] = class_atom();
+
+                    if (peek() == '-' && position + 1 < input.size() && input[position + 1] != ']') {
+                        ++position;
+                        auto [last, last_char] = class_atom();
+
+                        // Ranges between class escapes (e.g. [\d-z]) are not allowed.
+                        if (!first_char || !last_char || *first_char > *last_char) throw unsupported_pattern { };
+
+                        for (std::size_t i = *first_char; i <= *last_char; ++i) chars.set(i);
+                    } else {
+                        chars |= first;
+                    }
+                }
+
+
+                if (negated) chars.flip();
+                return chars;
+            }
+
+
+            // Returns the set of characters matched by a single element of a bracket expression, and the character itself if it is a single character.
+            std::pair<charset, std::optional<unsigned char>> class_atom(void) {
+                char c = next();
+
+                if (c == '\\') {
+                    if (peek() == 'b') throw unsupported_pattern { }; // Backspace inside a class, word boundary outside.
+
+                    auto chars = escape();
+                    if (chars.count() != 1) return { chars, std::nullopt };
+
+                    for (std::size_t i = 0; i < 256; ++i) {
+                        if (chars[i]) return { chars, (unsigned char) i };
+                    }
+                }
+
+                charset chars;
+                chars.set((unsigned char) c);
+                return { chars, (unsigned char) c };
+            }
+
+
+            charset escape(void) {
+                char c = next();
+                charset chars;
+
+                auto set_range = [&] (char from, char to) {
+                    for (int i = from; i <= to; ++i) chars.set((unsigned char) i);
+                };
+
+
+                switch (c) {
+                    case 'd': case 'D':
+                        set_range('0', '9');
+                        break;
+                    case 'w': case 'W':
+                        set_range('a', 'z');
+                        set_range('A', 'Z');
+                        set_range('0', '9');
+                        chars.set('_');
+                        break;
+                    case 's': case 'S':
+                        for (char ws : { ' ', '\t', '\n', '\v', '\f', '\r' }) chars.set((unsigned char) ws);
+                        break;
+
+                    case 't': chars.set('\t'); return chars;
+                    case 'n': chars.set('\n'); return chars;
+                    case 'r': chars.set('\r'); return chars;
+                    case 'f': chars.set('\f'); return chars;
+                    case 'v': chars.set('\v'); return chars;
+
+                    case '0':
+                        if (!at_end() && std::isdigit((unsigned char) peek())) throw unsupported_pattern { };
+                        chars.set(0);
+                        return chars;
+
+                    case 'x': {
+                        std::size_t value = 0;
+
+                        for (std::size_t i = 0; i < 2; ++i) {
+                            char h = next();
+                            if (!std::isxdigit((unsigned char) h)) throw unsupported_pattern { };
+
+                            value = value * 16 + (std::size_t) (std::isdigit((unsigned char) h) ? h - '0' : (std::tolower((unsigned char) h) - 'a' + 10));
+                        }
+
+                        chars.set(value);
+                        return chars;
+                    }
+
+                    default:
+                        // Backreferences, word boundaries, unicode and control escapes cannot be compiled.
+                        // Any other escaped character is an identity escape.
+                        if (std::isalnum((unsigned char) c)) throw unsupported_pattern { };
+
+                        chars.set((unsigned char) c);
+                        return chars;
+                }
+
+
+                if (std::isupper((unsigned char) c)) chars.flip();
+                return chars;
+            }
+        };
+
+
+        struct nfa_state {
+            // Either a transition on one of the given characters, or only epsilon transitions.
+            bool has_chars = false;
+            charset chars;
+            std::uint32_t target = 0;
+
+            std::vector<std::uint32_t> epsilon;
+            std::uint32_t accepts = std::numeric_limits<std::uint32_t>::max();
+        };
+
+
+        // Thompson construction of an NFA matching any of a set of patterns.
+        class nfa_builder {
+        public:
+            std::vector<nfa_state> states;
+
+
+            nfa_builder(void) { states.emplace_back(); } // The start state.
+
+
+            void add_pattern(const regex_node& root, std::uint32_t index) {
+                auto [begin, end] = build(root);
+
+                states[0].epsilon.push_back(begin);
+                states[end].accepts = index;
+            }
+        private:
+            struct fragment { std::uint32_t begin, end; };
+
+
+            std::uint32_t new_state(void) {
+                states.emplace_back();
+                return (std::uint32_t) (states.size() - 1);
+            }
+
+
+            fragment build(const regex_node& node) {
+                switch (node.type) {
+                    case regex_node::EMPTY: {
+                        auto s = new_state();
+                        return { s, s };
+                    }
+
+                    case regex_node::CHARSET: {
+                        auto begin = new_state(), end = new_state();
+
+                        states[begin].has_chars = true;
+                        states[begin].chars     = node.chars;
+                        states[begin].target    = end;
+
+                        return { begin, end };
+                    }
+
+                    case regex_node::CONCAT: {
+                        auto begin = new_state(), end = begin;
+
+                        for (const auto& child : node.children) {
+                            auto f = build(*child);
+                            states[end].epsilon.push_back(f.begin);
+                            end = f.end;
+                        }
+
+                        return { begin, end };
+                    }
+
+                    case regex_node::ALTERNATION: {
+                        auto begin = new_state(), end = new_state();
+
+                        for (const auto& child : node.children) {
+                            auto f = build(*child);
+                            states[begin].epsilon.push_back(f.begin);
+                            states[f.end].epsilon.push_back(end);
+                        }
+
+                        return { begin, end };
+                    }
+
+                    case regex_node::REPEAT: {
+                        const auto& child = *node.children.front();
+                        auto begin = new_state(), end = begin;
+
+                        for (std::size_t i = 0; i < node.min; ++i) {
+                            auto f = build(child);
+                            states[end].epsilon.push_back(f.begin);
+                            end = f.end;
+                        }
+
+
+                        if (node.max == UNBOUNDED) {
+                            auto f = build(child);
+                            auto loop_end = new_state();
+
+                            states[end].epsilon.push_back(f.begin);
+                            states[end].epsilon.push_back(loop_end);
+                            states[f.end].epsilon.push_back(f.begin);
+                            states[f.end].epsilon.push_back(loop_end);
+
+                            return { begin, loop_end };
+                        }
+
+
+                        // Optional copies: each of them can be skipped, skipping all remaining ones.
+                        auto optional_end = new_state();
+
+                        for (std::size_t i = node.min; i < node.max; ++i) {
+                            auto f = build(child);
+                            states[end].epsilon.push_back(f.begin);
+                            states[end].epsilon.push_back(optional_end);
+                            end = f.end;
+                        }
+
+                        states[end].epsilon.push_back(optional_end);
+                        return { begin, optional_end };
+                    }
+                }
+
+                throw unsupported_pattern { };
+            }
+        };
+    }
+
+
+    struct rule_engine::compiled_pattern {
+        std::size_t index;
+        std::string source;
+        node_ptr root;
+    };
+
+
+    rule_engine::rule_engine(const std::vector<std::string>& patterns) : pattern_count(patterns.size()) {
+        std::vector<compiled_pattern> compiled;
+
+        for (const auto& [i, pattern] : patterns | views::enumerate) {
+            try {
+                compiled.push_back({ (std::size_t) i, pattern, regex_parser { pattern }.parse() });
+            } catch (const unsupported_pattern&) {
+                fallbacks.emplace_back((std::size_t) i, std::regex { pattern.begin(), pattern.end() });
+            }
+        }
+
+        if (!compiled.empty()) build_automata(compiled);
+    }
+
+
+    rule_engine::rule_engine(const precompiled_rule_set& tables) : pattern_count(tables.patterns.size()) {
+        for (const auto& source : tables.automata) {
+            automaton dfa;
+
+            std::ranges::copy(source.byte_classes, dfa.byte_classes.begin());
+            dfa.class_count = source.class_count;
+            dfa.transitions.assign(source.transitions.begin(), source.transitions.end());
+            dfa.accepts.assign(source.accepts.begin(), source.accepts.end());
+
+            automata.push_back(std::move(dfa));
+        }
+
+        for (auto index : tables.fallbacks) {
+            const auto& pattern = tables.patterns[index];
+            fallbacks.emplace_back((std::size_t) index, std::regex { pattern.begin(), pattern.end() });
+        }
+    }
+
+
+    void rule_engine::write_tables(std::ostream& stream, std::string_view name, const std::vector<std::string>& patterns) const {
+        // Writes the given values as the initializer of an array, a fixed number of values per line.
+        auto write_array = [&] (std::string_view type, std::string_view array_name, const auto& values) {
+            stream << "    constexpr " << type << " " << array_name << "[] = {";
+
+            for (const auto& [i, value] : values | views::enumerate) {
+                stream << (i % 16 == 0 ? "\n        " : " ") << (std::uint32_t) value << ",";
+            }
+
+            stream << "\n    };\n\n";
+        };
+
+        // Empty arrays are not allowed, so empty spans are written without one.
+        auto span_of = [] (bool empty, std::string_view array_name) {
+            return empty ? std::string { "{ }" } : std::string { array_name };
+        };
+
+
+        stream << "    constexpr std::string_view " << name << "_patterns[] = {\n";
+
+        for (const auto& pattern : patterns) {
+            stream << "        \"";
+
+            for (char c : pattern) {
+                if (c == '"' || c == '\\') stream << '\\' << c;
+                else if ((unsigned char) c < 0x20 || (unsigned char) c >= 0x7F) stream << "\\x" << std::hex << (std::uint32_t) (unsigned char) c << std::dec << "\"\"";
+                else stream << c;
+            }
+
+            stream << "\"sv,\n";
+        }
+
+        // Rule sets without patterns still get an array, so the patterns can always be compared.
+        if (patterns.empty()) stream << "        \"\"sv\n";
+        stream << "    };\n\n";
+
+
+        std::string automata_list;
+
+        for (const auto& [i, dfa] : automata | views::enumerate) {
+            auto prefix = stream_to_string(name, "_", i);
+
+            write_array("std::uint8_t", prefix + "_classes", dfa.byte_classes);
+            write_array("std::uint32_t", prefix + "_transitions", dfa.transitions);
+            write_array("std::uint32_t", prefix + "_accepts", dfa.accepts);
+
+            automata_list += stream_to_string(
+                "        symgen::precompiled_automaton { ", prefix, "_classes, ", dfa.class_count, ", ", prefix, "_transitions, ", prefix, "_accepts },\n"
+            );
+        }
+
+        if (!automata.empty()) stream << "    constexpr symgen::precompiled_automaton " << name << "_automata[] = {\n" << automata_list << "    };\n\n";
+
+
+        std::vector<std::uint32_t> fallback_indices;
+        for (const auto& [index, rgx] : fallbacks) fallback_indices.push_back((std::uint32_t) index);
+
+        if (!fallback_indices.empty()) write_array("std::uint32_t", stream_to_string(name, "_fallbacks"), fallback_indices);
+
+
+        stream << "    constexpr symgen::precompiled_rule_set " << name << " {\n"
+               << "        std::span { " << name << "_patterns }.first(" << patterns.size() << "),\n"
+               << "        " << span_of(automata.empty(), stream_to_string(name, "_automata")) << ",\n"
+               << "        " << span_of(fallback_indices.empty(), stream_to_string(name, "_fallbacks")) << "\n"
+               << "    };\n";
+    }
+
+
+    std::optional<std::size_t> rule_engine::match(std::string_view str) const {
+        std::uint32_t result = NO_MATCH;
+
+        for (const auto& dfa : automata) {
+            std::uint32_t state = START_STATE;
+
+            for (char c : str) {
+                state = dfa.transitions[state * dfa.class_count + dfa.byte_classes[(unsigned char) c]];
+                if (state == DEAD_STATE) break;
+            }
+
+            result = std::min(result, dfa.accepts[state]);
+        }
+
+
+        // Fallbacks are ordered by index, so only the ones before the current result have to be checked, and the first one to match wins.
+        for (const auto& [index, rgx] : fallbacks) {
+            if (index >= result) break;
+
+            if (std::regex_match(str.begin(), str.end(), rgx)) {
+                result = (std::uint32_t) index;
+                break;
+            }
+        }
+
+
+        if (result == NO_MATCH) return std::nullopt;
+        return (std::size_t) result;
+    }
+
+
+    void rule_engine::build_automata(std::span<const compiled_pattern> patterns) {
+        // Splits the patterns over two automata, or falls back to std::regex if a single pattern is too large on its own.
+        auto split = [&] {
+            if (patterns.size() == 1) {
+                const auto& pattern = patterns.front();
+                auto it = std::lower_bound(fallbacks.begin(), fallbacks.end(), pattern.index, [] (const auto& pair, std::size_t index) { return pair.first < index; });
+
+                fallbacks.emplace(it, pattern.index, std::regex { pattern.source.begin(), pattern.source.end() });
+                return;
+            }
+
+            build_automata(patterns.first(patterns.size() / 2));
+            build_automata(patterns.subspan(patterns.size() / 2));
+        };
+
+
+        nfa_builder builder;
+        std::size_t total_states = 0;
+
+        for (const auto& pattern : patterns) {
+            total_states += pattern.root->state_count;
+            if (total_states > MAX_NFA_STATES) return split();
+
+            builder.add_pattern(*pattern.root, (std::uint32_t) pattern.index);
+        }
+
+        const auto& nfa = builder.states;
+
+
+        // Partition bytes into classes of bytes that every transition treats the same way.
+        automaton dfa;
+        dfa.byte_classes.fill(0);
+        dfa.class_count = 1;
+
+        for (const auto& state : nfa) {
+            if (!state.has_chars) continue;
+
+            hash_map<std::pair<std::uint8_t, bool>, std::uint8_t> refined;
+            std::size_t refined_count = 0;
+
+            for (std::size_t b = 0; b < 256; ++b) {
+                auto [it, inserted] = refined.try_emplace(std::pair { dfa.byte_classes[b], (bool) state.chars[b] }, (std::uint8_t) refined_count);
+                if (inserted) ++refined_count;
+
+                dfa.byte_classes[b] = it->second;
+            }
+
+            dfa.class_count = refined_count;
+        }
+
+        std::vector<std::uint8_t> representatives(dfa.class_count);
+        for (std::size_t b = 256; b-- > 0;) representatives[dfa.byte_classes[b]] = (std::uint8_t) b;
+
+
+        // Byte classes on which each NFA state has a transition.
+        std::vector<std::vector<std::uint8_t>> state_classes(nfa.size());
+
+        for (const auto& [s, state] : nfa | views::enumerate) {
+            if (!state.has_chars) continue;
+
+            for (std::size_t c = 0; c < dfa.class_count; ++c) {
+                if (state.chars[representatives[c]]) state_classes[s].push_back((std::uint8_t) c);
+            }
+        }
+
+
+        // Subset construction. DFA states are identified by the sorted set of NFA states they represent.
+        // Only states with a character transition or that accept a pattern are kept, since the other ones do not affect the DFA,
+        // which makes sets that only differ in epsilon states map to the same DFA state.
+        std::vector<std::uint32_t> visited(nfa.size(), 0);
+        std::uint32_t generation = 0;
+
+        auto closure = [&] (const std::vector<std::uint32_t>& initial) {
+            ++generation;
+
+            std::vector<std::uint32_t> set, stack;
+
+            for (auto s : initial) {
+                if (visited[s] == generation) continue;
+
+                visited[s] = generation;
+                set.push_back(s);
+                stack.push_back(s);
+            }
+
+            while (!stack.empty()) {
+                auto s = stack.back();
+                stack.pop_back();
+
+                for (auto t : nfa[s].epsilon) {
+                    if (visited[t] == generation) continue;
+
+                    visited[t] = generation;
+                    set.push_back(t);
+                    stack.push_back(t);
+                }
+            }
+
+            std::erase_if(set, [&] (auto s) { return !nfa[s].has_chars && nfa[s].accepts == NO_MATCH; });
+            ranges::sort(set);
+
+            return set;
+        };
+
+
+        hash_map<std::vector<std::uint32_t>, std::uint32_t> state_ids;
+        std::vector<std::vector<std::uint32_t>> worklist;
+
+        auto add_state = [&] (std::vector<std::uint32_t> set) {
+            auto [it, inserted] = state_ids.try_emplace(set, (std::uint32_t) dfa.accepts.size());
+
+            if (inserted) {
+                std::uint32_t accepts = NO_MATCH;
+                for (auto s : set) accepts = std::min(accepts, nfa[s].accepts);
+
+                dfa.accepts.push_back(accepts);
+                dfa.transitions.resize(dfa.transitions.size() + dfa.class_count, DEAD_STATE);
+                worklist.push_back(std::move(set));
+            }
+
+            return it->second;
+        };
+
+
+        add_state({ });          // DEAD_STATE
+        add_state(closure({ 0 })); // START_STATE
+
+        std::vector<std::vector<std::uint32_t>> targets(dfa.class_count);
+
+        for (std::uint32_t id = START_STATE; id < worklist.size(); ++id) {
+            if (dfa.accepts.size() > MAX_DFA_STATES) return split();
+
+            for (auto& t : targets) t.clear();
+
+            for (auto s : worklist[id]) {
+                for (auto c : state_classes[s]) targets[c].push_back(nfa[s].target);
+            }
+
+
+            for (std::size_t c = 0; c < dfa.class_count; ++c) {
+                if (targets[c].empty()) continue;
+
+                auto target = add_state(closure(targets[c]));
+                dfa.transitions[id * dfa.class_count + c] = target;
+            }
+        }
+
+
+        automata.push_back(std::move(dfa));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <regex>
+#include <span>
+#include <string_view>
+#include <vector>
+
+
+namespace symgen {
+    // Tables of a compiled rule_engine, as written to C++ source by -emit-matcher.
+    // The generated source only contains constant data, so compiling it into the program removes the cost of compiling the rules at startup.
+    struct precompiled_automaton {
+        std::span<const std::uint8_t, 256> byte_classes;
+        std::size_t class_count;
+        std::span<const std::uint32_t> transitions;
+        std::span<const std::uint32_t> accepts;
+    };
+
+    struct precompiled_rule_set {
+        std::span<const std::string_view> patterns;
+        std::span<const precompiled_automaton> automata;
+        // Indices of the patterns that cannot be expressed as a DFA. These are still compiled into a std::regex at startup.
+        std::span<const std::uint32_t> fallbacks;
+    };
+
+
+    // The rule sets of a source file generated by -emit-matcher. The generated file registers them when the program starts,
+    // and the rule_cache uses them instead of compiling the rules, as long as they were generated from the same patterns.
+    struct precompiled_rules {
+        precompiled_rule_set include, exclude, force_include, force_exclude;
+
+
+        // The rules compiled into the program, or null if there are none.
+        static const precompiled_rules*& registered(void) {
+            static const precompiled_rules* instance = nullptr;
+            return instance;
+        }
+    };
+
+
+    // Matches strings against an ordered list of (ECMAScript) regexes at once.
+    // All patterns are compiled together into a DFA, so matching takes a single pass over the string, regardless of the number of patterns.
+    // Patterns using constructs that cannot be expressed as a DFA (backreferences, lookaheads, word boundaries, etc.) fall back to std::regex.
+    // If the combined DFA would become too large, the patterns are split over multiple smaller DFAs instead.
+    class rule_engine {
+    public:
+        rule_engine(void) = default;
+        explicit rule_engine(const std::vector<std::string>& patterns);
+        // Loads the automata from precompiled tables, rather than compiling the patterns.
+        explicit rule_engine(const precompiled_rule_set& tables);
+
+
+        // Returns the index of the first pattern that matches the entire string, i.e. the same result as trying std::regex_match for each pattern in order.
+        [[nodiscard]] std::optional<std::size_t> match(std::string_view str) const;
+
+        [[nodiscard]] bool empty(void) const { return pattern_count == 0; }
+        [[nodiscard]] std::size_t size(void) const { return pattern_count; }
+        [[nodiscard]] std::size_t get_automaton_count(void) const { return automata.size(); }
+        [[nodiscard]] std::size_t get_fallback_count(void) const { return fallbacks.size(); }
+
+
+        // Writes the tables of this engine as a constexpr precompiled_rule_set with the given name, together with the arrays it refers to.
+        // The names of the arrays start with the same name. The patterns must be the ones the engine was created from.
+        void write_tables(std::ostream& stream, std::string_view name, const std::vector<std::string>& patterns) const;
+    private:
+        constexpr static std::uint32_t DEAD_STATE  = 0;
+        constexpr static std::uint32_t START_STATE = 1;
+        constexpr static std::uint32_t NO_MATCH    = std::numeric_limits<std::uint32_t>::max();
+
+
+        struct automaton {
+            // Bytes that are never distinguished by any pattern share the same class, which keeps the transition table small.
+            std::array<std::uint8_t, 256> byte_classes;
+            std::size_t class_count;
+
+            // Transition for state s and byte class c is stored at s * class_count + c.
+            std::vector<std::uint32_t> transitions;
+            // Index of the first pattern accepted in each state, or NO_MATCH.
+            std::vector<std::uint32_t> accepts;
+        };
+
+
+        std::size_t pattern_count = 0;
+        std::vector<automaton> automata;
+        std::vector<std::pair<std::size_t, std::regex>> fallbacks;
+
+
+        struct compiled_pattern;
+        void build_automata(std::span<const compiled_pattern> patterns);
+    };
+}
\ No newline at end of file
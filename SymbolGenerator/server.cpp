@@ -0,0 +1,259 @@
+#include <SymbolGenerator/server.hpp>
+#include <SymbolGenerator/argument_parser.hpp>
+#include <SymbolGenerator/utility.hpp>
+#include <SymbolGenerator/logger.hpp>
+#include <SymbolGenerator/statistics.hpp>
+#include <SymbolGenerator/import_library.hpp>
+
+#include <array>
+#include <chrono>
+#include <thread>
+
+using std::chrono::steady_clock;
+
+
+namespace symgen {
+    // Sent as the first string of every request, so a server never misinterprets a request from a different version of the program.
+    constexpr std::string_view PROTOCOL_NAME = "SymbolGenerator/1";
+
+    // Requests only contain arguments, so anything larger than this is not a valid request.
+    constexpr std::size_t MAX_MESSAGE_SIZE = 16 << 20;
+
+
+    // Messages are lists of strings, prefixed by their total size in bytes. Every string is prefixed by its own size.
+    static bool send_message(const local_socket& socket, std::span<const std::string> message) {
+        std::vector<std::byte> buffer(sizeof(std::uint32_t));
+
+        auto append = [&] (const void* src, std::size_t size) {
+            buffer.insert(buffer.end(), (const std::byte*) src, (const std::byte*) src + size);
+        };
+
+        for (const auto& string : message) {
+            const std::uint32_t size = (std::uint32_t) string.size();
+
+            append(&size, sizeof(size));
+            append(string.data(), string.size());
+        }
+
+        const std::uint32_t total_size = (std::uint32_t) (buffer.size() - sizeof(std::uint32_t));
+        std::memcpy(buffer.data(), &total_size, sizeof(total_size));
+
+        return socket.send(buffer);
+    }
+
+
+    static std::optional<std::vector<std::string>> receive_message(const local_socket& socket) {
+        std::array<std::byte, sizeof(std::uint32_t)> size_bytes;
+        if (!socket.receive(size_bytes)) return std::nullopt;
+
+        const auto total_size = read_le<std::uint32_t>(size_bytes, 0);
+        if (total_size > MAX_MESSAGE_SIZE) return std::nullopt;
+
+        std::vector<std::byte> buffer(total_size);
+        if (!socket.receive(buffer)) return std::nullopt;
+
+
+        std::vector<std::string> result;
+        std::size_t offset = 0;
+
+        while (offset < buffer.size()) {
+            if (buffer.size() - offset < sizeof(std::uint32_t)) return std::nullopt;
+
+            const auto size = read_le<std::uint32_t>(buffer, offset);
+            offset += sizeof(std::uint32_t);
+
+            if (size > buffer.size() - offset) return std::nullopt;
+
+            result.emplace_back((const char*) buffer.data() + offset, size);
+            offset += size;
+        }
+
+        return result;
+    }
+
+
+    // Normalizes a directory path, so paths that only differ in a trailing separator compare equal.
+    static fs::path normalize_directory(const fs::path& path) {
+        auto result = path.lexically_normal();
+        return result.has_filename() ? result : result.parent_path();
+    }
+
+
+    server::server(fs::path socket_path, export_generator& generator) : socket_path(std::move(socket_path)), generator(&generator) {}
+
+
+    void server::run(void) {
+        auto listener = local_socket::listen(socket_path);
+
+
+        // Process all objects up front, so the first request only has to process the objects that changed since the server was started.
+        {
+            std::lock_guard lock { generator_mtx };
+            auto stats = generator->update();
+
+            logger::instance().normal("Processed ", stats.object_count, " objects, found ", generator->get_symbol_count(), " symbols to export.");
+            generator->release_unused_names();
+
+            // Statistics are written for every request, so they should not include this initial update.
+            statistics::instance().reset();
+        }
+
+        logger::instance().normal("Listening for requests on ", socket_path);
+
+
+        while (true) {
+            auto connection = listener.accept();
+
+            if (!connection) {
+                logger::instance().warning("Failed to accept connection on ", socket_path);
+                continue;
+            }
+
+            std::thread { [this, connection = std::move(*connection)] () mutable {
+                handle_request(std::move(connection));
+            } }.detach();
+        }
+    }
+
+
+    void server::handle_request(local_socket connection) {
+        auto request = receive_message(connection);
+
+        if (!request) {
+            logger::instance().warning("Received an invalid request.");
+            return;
+        }
+
+
+        std::vector<std::string> response;
+
+        try {
+            response = process_request(*request);
+        } catch (std::exception& e) {
+            logger::instance().error("Failed to process request: ", e.what());
+            response = { "error", e.what() };
+        }
+
+        if (!send_message(connection, response)) {
+            logger::instance().warning("Failed to send response, the client may have been terminated.");
+        }
+    }
+
+
+    std::vector<std::string> server::process_request(std::span<const std::string> request) {
+        if (request.size() < 2 || request[0] != PROTOCOL_NAME) return { "rejected", "the client uses a different protocol version" };
+
+        const fs::path working_directory = request[1];
+
+        argument_parser args;
+        args.add_arguments(request.subspan(2));
+
+
+        // Symbols are classified using the server's own settings, and objects are found using its own -archives setting, so these have to be identical.
+        const auto& server_args = argument_parser::instance();
+
+        for (const auto& setting : std::array { "y", "n", "yo", "no", "fn", "archives" }) {
+            if (args.get_argument_text(setting) != server_args.get_argument_text(setting)) {
+                return { "rejected", stream_to_string("the -", setting, " setting differs from the one the server was started with") };
+            }
+        }
+
+
+        auto input   = args.get_argument_text("i");
+        auto output  = args.get_argument_text("o");
+        auto library = args.get_argument_text("lib");
+
+        if (!input || !output || !library) return { "rejected", "the request is missing one of -i, -o and -lib" };
+
+        if (normalize_directory(working_directory / *input) != normalize_directory(fs::absolute(generator->get_input_directory()))) {
+            return { "rejected", "the input directory differs from the one the server was started with" };
+        }
+
+
+        std::optional<fs::path> import_library;
+        if (auto path = args.get_argument_text("implib"); path) import_library = working_directory / *path;
+
+        std::uint16_t machine = 0;
+
+        if (auto name = args.get_argument_text("machine"); name) {
+            auto parsed = parse_machine_name(*name);
+            if (!parsed) return { "rejected", stream_to_string("unsupported machine type ", *name) };
+
+            machine = *parsed;
+        }
+
+
+        std::lock_guard lock { generator_mtx };
+        steady_clock::time_point start = steady_clock::now();
+
+        auto stats = generator->update();
+
+        unit_statistics output_stats;
+        auto output_timer = statistics::instance().time(output_stats, stage::OUTPUT);
+
+        auto error = generator->write_def_file(working_directory / *output, *library, args.has_argument("ordinal"), import_library, machine);
+
+        output_timer.stop();
+        statistics::instance().add(output_stats);
+
+        if (error) {
+            logger::instance().error(*error);
+            return { "error", std::move(*error) };
+        }
+
+        // Symbols that were renamed or removed would otherwise keep their names in memory for as long as the server runs.
+        generator->release_unused_names();
+
+        steady_clock::time_point stop = steady_clock::now();
+
+        // If the server was started with -stats, the file describes the most recent request.
+        if (auto stats_path = server_args.get_argument<std::string>("stats"); stats_path) {
+            if (!statistics::instance().write(*stats_path, stop - start)) logger::instance().warning("Failed to write statistics to ", *stats_path);
+        }
+
+
+        auto message = stream_to_string(
+            "Generated ", *output, " with ", generator->get_symbol_count(), " symbols ",
+            "(", stats.processed_count, " of ", stats.object_count, " objects processed, ",
+            stats.removed_count, " removed, in ", std::chrono::duration_cast<std::chrono::milliseconds>(stop - start), ")."
+        );
+
+        logger::instance().normal(message);
+        return { "ok", std::move(message) };
+    }
+
+
+    std::optional<std::string> request_from_server(const fs::path& socket_path, std::span<const std::string> args) {
+        auto connection = local_socket::connect(socket_path);
+
+        if (!connection) {
+            logger::instance().verbose("No server is listening on ", socket_path, ", generating the .def file locally.");
+            return std::nullopt;
+        }
+
+
+        std::vector<std::string> request { std::string { PROTOCOL_NAME }, fs::current_path().string() };
+        request.insert(request.end(), args.begin(), args.end());
+
+        if (!send_message(*connection, request)) {
+            logger::instance().warning("Failed to send request to the server on ", socket_path, ", generating the .def file locally.");
+            return std::nullopt;
+        }
+
+
+        auto response = receive_message(*connection);
+
+        if (!response || response->size() != 2) {
+            logger::instance().warning("The server on ", socket_path, " did not respond, generating the .def file locally.");
+            return std::nullopt;
+        }
+
+        if ((*response)[0] != "ok") {
+            logger::instance().warning("The server on ", socket_path, " could not handle the request (", (*response)[1], "), generating the .def file locally.");
+            return std::nullopt;
+        }
+
+
+        return std::move((*response)[1]);
+    }
+}
\ No newline at end of file
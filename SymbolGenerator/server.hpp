@@ -0,0 +1,43 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+#include <SymbolGenerator/export_generator.hpp>
+#include <SymbolGenerator/local_socket.hpp>
+
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+
+namespace symgen {
+    // Long-running server started with -serve, which keeps the results of every object and the merged export set in memory between builds.
+    // Clients (SymbolGenerator invoked with -server) send their arguments, and the server updates the export set and writes the .def file they asked for.
+    // Compiled filters and symbol classifications are kept as well, so a request only costs as much as the objects that changed since the last one.
+    //
+    // Classification depends on the filter settings the server was started with, so requests with different settings are rejected,
+    // in which case the client generates the .def file by itself. Requests from multiple clients are accepted concurrently,
+    // but updates are processed one at a time.
+    class server {
+    public:
+        server(fs::path socket_path, export_generator& generator);
+
+        // Accepts requests until the process is terminated.
+        [[noreturn]] void run(void);
+    private:
+        fs::path socket_path;
+        export_generator* generator;
+
+        std::mutex generator_mtx;
+
+
+        void handle_request(local_socket connection);
+        std::vector<std::string> process_request(std::span<const std::string> request);
+    };
+
+
+    // Asks the server listening on the given socket to generate the .def file described by the given arguments.
+    // Returns the result message if the server handled the request, or nothing if there is no server or it rejected the request.
+    std::optional<std::string> request_from_server(const fs::path& socket_path, std::span<const std::string> args);
+}
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include <SymbolGenerator/shard_file.hpp>
+#include <SymbolGenerator/argument_parser.hpp>
+#include <SymbolGenerator/object_cache.hpp>
+#include <SymbolGenerator/mapped_file.hpp>
+#include <SymbolGenerator/string_pool.hpp>
+#include <SymbolGenerator/utility.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+
+
+namespace symgen {
+    constexpr std::size_t HEADER_SIZE = 32;
+
+
+    std::optional<shard_spec> shard_spec::parse(std::string_view text) {
+        auto separator = text.find('/');
+        if (separator == std::string_view::npos) return std::nullopt;
+
+        auto parse_number = [] (std::string_view sv) -> std::optional<std::uint32_t> {
+            std::uint32_t result = 0;
+            auto [end, error] = std::from_chars(sv.data(), sv.data() + sv.size(), result);
+
+            if (sv.empty() || error != std::errc { } || end != sv.data() + sv.size()) return std::nullopt;
+            return result;
+        };
+
+        auto index = parse_number(text.substr(0, separator));
+        auto count = parse_number(text.substr(separator + 1));
+
+        if (!index || !count || *index == 0 || *index > *count) return std::nullopt;
+        return shard_spec { *index, *count };
+    }
+
+
+    bool shard_spec::contains(const fs::path& relative_path) const {
+        // Use the generic format, so Windows and other hosts assign objects the same way.
+        return stable_hash(relative_path.generic_string()) % count == index - 1;
+    }
+
+
+    std::uint64_t shard_file::hash_settings(void) {
+        hash_map<std::string, std::string> settings;
+
+        for (const auto& setting : std::array { "y", "n", "yo", "no", "fn", "archives" }) {
+            if (auto arg = argument_parser::instance().get_argument_text(setting); arg) settings.emplace(setting, *arg);
+        }
+
+        return object_cache::hash_settings(settings);
+    }
+
+
+    shard_file::shard_file(const fs::path& path) {
+        std::error_code ec;
+
+        if (!fs::exists(path, ec)) {
+            error = "file does not exist";
+            return;
+        }
+
+        mapped_file file { path };
+        auto data = file.data();
+
+        if (file.get_error()) {
+            error = *file.get_error();
+            return;
+        }
+
+        if (data.size() < HEADER_SIZE || read_le<std::uint32_t>(data, 0) != FORMAT_MAGIC) {
+            error = "file is not a shard file";
+            return;
+        }
+
+        if (auto version = read_le<std::uint32_t>(data, 4); version != FORMAT_VERSION) {
+            error = stream_to_string("shard file uses format version ", version, ", expected version ", FORMAT_VERSION);
+            return;
+        }
+
+
+        settings_hash = read_le<std::uint64_t>(data, 8);
+        shard.index   = read_le<std::uint32_t>(data, 16);
+        shard.count   = read_le<std::uint32_t>(data, 20);
+        machine       = read_le<std::uint16_t>(data, 28);
+
+        const auto symbol_count = read_le<std::uint32_t>(data, 24);
+
+        // The shard is used to index the shards of a merge, so it has to be valid even if the file was damaged while it was copied between machines.
+        if (shard.count == 0 || shard.index == 0 || shard.index > shard.count) {
+            error = "shard file is corrupt";
+            return;
+        }
+
+
+        std::size_t offset = HEADER_SIZE;
+        bool truncated = false;
+
+        auto read_number = [&] (void) -> std::size_t {
+            std::size_t result = 0;
+
+            for (std::size_t shift = 0; shift < 8 * sizeof(std::size_t); shift += 7) {
+                if (offset >= data.size()) break;
+
+                auto byte = read_le<std::uint8_t>(data, offset++);
+                result |= (std::size_t) (byte & 0x7F) << shift;
+
+                if (!(byte & 0x80)) return result;
+            }
+
+            truncated = true;
+            return 0;
+        };
+
+
+        auto& pool = string_pool::instance();
+        std::string name;
+
+        symbols.reserve((std::min)((std::size_t) symbol_count, data.size()));
+
+        for (std::uint32_t i = 0; i < symbol_count; ++i) {
+            if (offset >= data.size()) {
+                truncated = true;
+                break;
+            }
+
+            auto flags = read_le<std::uint8_t>(data, offset++);
+            auto prefix_length = read_number();
+            auto suffix_length = read_number();
+
+            if (truncated || prefix_length > name.size() || suffix_length > data.size() - offset) {
+                truncated = true;
+                break;
+            }
+
+            name.resize(prefix_length);
+            name.append((const char*) data.data() + offset, suffix_length);
+            offset += suffix_length;
+
+            symbols.push_back({ pool.intern(name), (flags & 1) != 0 });
+        }
+
+
+        if (truncated) {
+            error = "shard file is truncated";
+            symbols.clear();
+        }
+    }
+
+
+    bool shard_file::write(const fs::path& path, const shard_spec& shard, std::uint16_t machine, std::span<const included_symbol> symbols) {
+        std::string contents;
+
+        auto append = [&] (const auto& value) {
+            contents.append((const char*) &value, sizeof(value));
+        };
+
+        auto append_number = [&] (std::size_t value) {
+            do {
+                contents += (char) ((value & 0x7F) | (value >= 0x80 ? 0x80 : 0));
+                value >>= 7;
+            } while (value);
+        };
+
+
+        append(FORMAT_MAGIC);
+        append(FORMAT_VERSION);
+        append(hash_settings());
+        append(shard.index);
+        append(shard.count);
+        append((std::uint32_t) symbols.size());
+        append(machine);
+        contents.append(HEADER_SIZE - contents.size(), '\0');
+
+
+        // Sort the symbols, so the same set of symbols always produces the same file, and consecutive names share as much as possible.
+        std::vector<const included_symbol*> ordered;
+        ordered.reserve(symbols.size());
+
+        for (const auto& symbol : symbols) ordered.push_back(&symbol);
+        ranges::sort(ordered, std::less<> { }, [] (const auto* symbol) { return symbol->mangled_name.view(); });
+
+
+        std::string_view previous;
+
+        for (const auto* symbol : ordered) {
+            auto name = symbol->mangled_name.view();
+            auto prefix_length = (std::size_t) (std::ranges::mismatch(name, previous).in1 - name.begin());
+
+            contents += (char) (symbol->is_data_symbol ? 1 : 0);
+            append_number(prefix_length);
+            append_number(name.size() - prefix_length);
+            contents += name.substr(prefix_length);
+
+            previous = name;
+        }
+
+
+        return write_file_if_changed(path, contents) != write_result::FAILED;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+#include <SymbolGenerator/translation_unit_processor.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace symgen {
+    // Deterministic subset of the objects in the input directory, for -shard k/N.
+    // Objects are assigned to shards by the stable_hash of their path relative to the input directory, so every machine of a build farm
+    // assigns an object to the same shard, regardless of where the input directory is located, and adding an object never moves any other object.
+    // Archives are assigned as a whole, rather than per member.
+    struct shard_spec {
+        // One-based, i.e. the shards of -shard k/N are 1/N up to N/N.
+        std::uint32_t index = 1;
+        std::uint32_t count = 1;
+
+
+        // Parses a shard in the form k/N. Returns nothing if the text is not of that form, or if k is not between 1 and N.
+        [[nodiscard]] static std::optional<shard_spec> parse(std::string_view text);
+
+        [[nodiscard]] bool contains(const fs::path& relative_path) const;
+
+        bool operator==(const shard_spec&) const = default;
+    };
+
+
+    // Exports of a single shard of the input objects, written by -shard and combined into a .def file by -merge.
+    //
+    // Layout (all integers are little-endian):
+    //  - Header: magic, format version, settings hash, shard index and count, symbol count and the machine type of the objects (or zero).
+    //  - Symbols, ordered by name: a flags byte (1 for data symbols), the length of the prefix the name shares with the previous name
+    //    and the length of the rest of the name (both LEB128-encoded), followed by the rest of the name.
+    //    Names of the same namespace mostly share long prefixes, so this keeps the file small compared to storing the names in full.
+    class shard_file {
+    public:
+        constexpr static std::uint32_t FORMAT_MAGIC   = 0x53454753; // "SGES"
+        constexpr static std::uint32_t FORMAT_VERSION = 1;
+
+
+        explicit shard_file(const fs::path& path);
+
+
+        // Returns an error if the file could not be read, e.g. because it was created by a different version.
+        [[nodiscard]] const std::optional<std::string>& get_error(void) const { return error; }
+
+        [[nodiscard]] const shard_spec& get_shard(void) const { return shard; }
+        [[nodiscard]] std::uint64_t get_settings_hash(void) const { return settings_hash; }
+        [[nodiscard]] std::uint16_t get_machine(void) const { return machine; }
+        [[nodiscard]] const std::vector<included_symbol>& get_symbols(void) const { return symbols; }
+
+
+        // Hash of the arguments that decide which symbols are exported. Shards can only be merged if they were created with the same settings.
+        [[nodiscard]] static std::uint64_t hash_settings(void);
+
+        // Writes the given symbols to a shard file. The file is only rewritten if its contents changed. Returns false if it could not be written.
+        [[nodiscard]] static bool write(const fs::path& path, const shard_spec& shard, std::uint16_t machine, std::span<const included_symbol> symbols);
+    private:
+        std::optional<std::string> error = std::nullopt;
+
+        shard_spec shard;
+        std::uint64_t settings_hash = 0;
+        std::uint16_t machine = 0;
+        std::vector<included_symbol> symbols;
+    };
+}
\ No newline at end of file
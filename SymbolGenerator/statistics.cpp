@@ -0,0 +1,244 @@
+#include <SymbolGenerator/statistics.hpp>
+#include <SymbolGenerator/argument_parser.hpp>
+#include <SymbolGenerator/utility.hpp>
+
+#include <iomanip>
+#include <sstream>
+
+#ifdef _WIN32
+    #include <Windows.h>
+    #include <Psapi.h>
+#else
+    #include <sys/resource.h>
+    #include <time.h>
+#endif
+
+
+namespace symgen {
+    #ifdef _WIN32
+        static std::chrono::nanoseconds filetime_to_duration(const FILETIME& time) {
+            // FILETIMEs are measured in units of 100ns.
+            return std::chrono::nanoseconds { ((std::uint64_t { time.dwHighDateTime } << 32) | time.dwLowDateTime) * 100 };
+        }
+
+
+        static std::chrono::nanoseconds get_thread_cpu_time(void) {
+            FILETIME creation, exit, kernel, user;
+            if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) return std::chrono::nanoseconds { 0 };
+
+            return filetime_to_duration(kernel) + filetime_to_duration(user);
+        }
+
+
+        static std::chrono::nanoseconds get_process_cpu_time(void) {
+            FILETIME creation, exit, kernel, user;
+            if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) return std::chrono::nanoseconds { 0 };
+
+            return filetime_to_duration(kernel) + filetime_to_duration(user);
+        }
+
+
+        static std::uint64_t get_peak_memory(void) {
+            PROCESS_MEMORY_COUNTERS counters;
+            if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+
+            return counters.PeakWorkingSetSize;
+        }
+    #else
+        static std::chrono::nanoseconds get_thread_cpu_time(void) {
+            timespec time;
+            if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0) return std::chrono::nanoseconds { 0 };
+
+            return std::chrono::seconds { time.tv_sec } + std::chrono::nanoseconds { time.tv_nsec };
+        }
+
+
+        static std::chrono::nanoseconds get_process_cpu_time(void) {
+            rusage usage;
+            if (getrusage(RUSAGE_SELF, &usage) != 0) return std::chrono::nanoseconds { 0 };
+
+            auto to_duration = [] (const timeval& time) { return std::chrono::seconds { time.tv_sec } + std::chrono::microseconds { time.tv_usec }; };
+            return to_duration(usage.ru_utime) + to_duration(usage.ru_stime);
+        }
+
+
+        static std::uint64_t get_peak_memory(void) {
+            rusage usage;
+            if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+
+            // The maximum resident set size is measured in bytes on macOS, and in kilobytes everywhere else.
+            #ifdef __APPLE__
+                return (std::uint64_t) usage.ru_maxrss;
+            #else
+                return (std::uint64_t) usage.ru_maxrss * 1024;
+            #endif
+        }
+    #endif
+
+
+    stage_time& stage_time::operator+=(const stage_time& other) {
+        wall  += other.wall;
+        cpu   += other.cpu;
+        calls += other.calls;
+
+        return *this;
+    }
+
+
+    unit_statistics& unit_statistics::operator+=(const unit_statistics& other) {
+        for (std::size_t i = 0; i < stages.size(); ++i) stages[i] += other.stages[i];
+        for (std::size_t i = 0; i < counters.size(); ++i) counters[i] += other.counters[i];
+
+        total += other.total;
+        return *this;
+    }
+
+
+    stage_timer::stage_timer(stage_time* target, bool measure_cpu_time) : target(target), measure_cpu_time(measure_cpu_time) {
+        if (!target) return;
+
+        if (measure_cpu_time) cpu_start = get_thread_cpu_time();
+        wall_start = std::chrono::steady_clock::now();
+    }
+
+
+    void stage_timer::stop(void) {
+        if (!target) return;
+
+        target->wall += std::chrono::steady_clock::now() - wall_start;
+        if (measure_cpu_time) target->cpu += get_thread_cpu_time() - cpu_start;
+        target->calls += 1;
+
+        target = nullptr;
+    }
+
+
+    statistics::statistics(void) :
+        enabled(argument_parser::instance().has_argument("stats")),
+        process_cpu_start(get_process_cpu_time())
+    {}
+
+
+    void statistics::add_unit(std::string path, const unit_statistics& stats) {
+        if (!enabled) return;
+
+        std::lock_guard lock { mtx };
+
+        totals += stats;
+        units.push_back(unit_entry { std::move(path), stats });
+    }
+
+
+    void statistics::add(const unit_statistics& stats) {
+        if (!enabled) return;
+
+        std::lock_guard lock { mtx };
+        totals += stats;
+    }
+
+
+    static std::string escape_json(std::string_view sv) {
+        std::string result;
+        result.reserve(sv.size());
+
+        for (char c : sv) {
+            switch (c) {
+                case '"':  result += "\\\""; break;
+                case '\\': result += "\\\\"; break;
+                case '\n': result += "\\n";  break;
+                case '\r': result += "\\r";  break;
+                case '\t': result += "\\t";  break;
+                default:
+                    if ((unsigned char) c < 0x20) {
+                        result += stream_to_string("\\u00", "0123456789abcdef"[c >> 4], "0123456789abcdef"[c & 0xF]);
+                    } else {
+                        result += c;
+                    }
+            }
+        }
+
+        return result;
+    }
+
+
+    static void write_milliseconds(std::ostream& stream, std::chrono::nanoseconds time) {
+        stream << std::fixed << std::setprecision(3) << std::chrono::duration<double, std::milli> { time }.count();
+    }
+
+
+    static void write_unit(std::ostream& stream, const unit_statistics& stats, std::string_view indent) {
+        stream << indent << "\"wall_ms\": ";
+        write_milliseconds(stream, stats.total.wall);
+        stream << ",\n" << indent << "\"cpu_ms\": ";
+        write_milliseconds(stream, stats.total.cpu);
+
+
+        stream << ",\n" << indent << "\"stages\": {\n";
+
+        for (std::size_t i = 0; i < stage_names.size(); ++i) {
+            const auto& time = stats.stages[i];
+
+            stream << indent << "    \"" << stage_names[i] << "\": { \"wall_ms\": ";
+            write_milliseconds(stream, time.wall);
+
+            if (!is_per_symbol_stage((stage) i)) {
+                stream << ", \"cpu_ms\": ";
+                write_milliseconds(stream, time.cpu);
+            }
+
+            stream << ", \"calls\": " << time.calls << " }" << (i + 1 < stage_names.size() ? ",\n" : "\n");
+        }
+
+
+        stream << indent << "},\n" << indent << "\"counters\": {\n";
+
+        for (std::size_t i = 0; i < counter_names.size(); ++i) {
+            stream << indent << "    \"" << counter_names[i] << "\": " << stats.counters[i] << (i + 1 < counter_names.size() ? ",\n" : "\n");
+        }
+
+        stream << indent << "}";
+    }
+
+
+    bool statistics::write(const fs::path& path, std::chrono::nanoseconds wall_time) {
+        std::lock_guard lock { mtx };
+
+        const auto process_cpu_time = get_process_cpu_time();
+
+        // The totals of the run as a whole are measured for the entire process, rather than added up from the translation units.
+        unit_statistics summary = totals;
+        summary.total = stage_time { .wall = wall_time, .cpu = process_cpu_time - process_cpu_start, .calls = 1 };
+
+
+        std::ostringstream stream;
+        stream << "{\n";
+        write_unit(stream, summary, "    ");
+        stream << ",\n    \"peak_memory_bytes\": " << get_peak_memory() << ",\n";
+
+        stream << "    \"units\": [\n";
+
+        for (const auto& [i, unit] : units | views::enumerate) {
+            stream << "        {\n            \"path\": \"" << escape_json(unit.path) << "\",\n";
+            write_unit(stream, unit.stats, "            ");
+            stream << "\n        }" << (i + 1 < units.size() ? ",\n" : "\n");
+        }
+
+        stream << "    ]\n}\n";
+
+
+        totals = unit_statistics { };
+        units.clear();
+        process_cpu_start = process_cpu_time;
+
+        return write_file_if_changed(path, stream.str()) != write_result::FAILED;
+    }
+
+
+    void statistics::reset(void) {
+        std::lock_guard lock { mtx };
+
+        totals = unit_statistics { };
+        units.clear();
+        process_cpu_start = get_process_cpu_time();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace symgen {
+    enum class stage : std::uint8_t {
+        DIRECTORY_SCAN, OBJECT_LOAD, DEMANGLING, BUILTIN_FILTERS, RULE_MATCHING, FILTER_PLUGIN, CACHE_LOAD, CACHE_WRITE, MERGE, OUTPUT
+    };
+
+    constexpr std::array stage_names {
+        "directory_scan"sv, "object_load"sv, "demangling"sv, "builtin_filters"sv, "rule_matching"sv,
+        "filter_plugin"sv, "cache_load"sv, "cache_write"sv, "merge"sv, "output"sv
+    };
+
+
+    // Stages that run once per symbol. Measuring the CPU time of a thread requires a system call on most platforms,
+    // which would cost as much as the stage itself, so only the wall time of these stages is measured.
+    constexpr bool is_per_symbol_stage(stage s) {
+        return s == stage::DEMANGLING || s == stage::BUILTIN_FILTERS || s == stage::RULE_MATCHING;
+    }
+
+
+    enum class counter : std::uint8_t {
+        OBJECTS, OBJECTS_FROM_CACHE, SYMBOLS_SEEN, SYMBOLS_INCLUDED, SYMBOLS_FILTERED, SYMBOLS_REJECTED_BY_PLUGIN,
+        CACHE_HITS, CACHE_MISSES, DUPLICATE_SYMBOLS, DUPLICATE_EXPORTS, SYMBOLS_NOT_DEMANGLED
+    };
+
+    constexpr std::array counter_names {
+        "objects"sv, "objects_from_cache"sv, "symbols_seen"sv, "symbols_included"sv, "symbols_filtered"sv, "symbols_rejected_by_plugin"sv,
+        // Symbols that were found in the cache of their object, and symbols that had to be classified even though caching is enabled.
+        "cache_hits"sv, "cache_misses"sv,
+        // Symbols that were already classified by another translation unit, and exports that are exported by more than one object.
+        "duplicate_symbols"sv, "duplicate_exports"sv,
+        // Symbols that were classified by the scopes in their mangled name, without demangling them.
+        "symbols_not_demangled"sv
+    };
+
+
+    struct stage_time {
+        std::chrono::nanoseconds wall { 0 };
+        std::chrono::nanoseconds cpu  { 0 };
+        std::uint64_t calls = 0;
+
+        stage_time& operator+=(const stage_time& other);
+    };
+
+
+    // Timings and counters of a single translation unit, or of a whole run.
+    struct unit_statistics {
+        std::array<stage_time, stage_names.size()> stages;
+        std::array<std::uint64_t, counter_names.size()> counters { };
+        stage_time total;
+
+        unit_statistics& operator+=(const unit_statistics& other);
+
+        stage_time& operator[](stage s) { return stages[(std::size_t) s]; }
+        std::uint64_t& operator[](counter c) { return counters[(std::size_t) c]; }
+    };
+
+
+    // Adds the time that passed between its construction and its destruction (or the call to stop()) to a stage_time.
+    // A timer without a target does nothing, so timers cost nothing if -stats is not provided.
+    class stage_timer {
+    public:
+        stage_timer(stage_time* target, bool measure_cpu_time);
+        ~stage_timer(void) { stop(); }
+
+        stage_timer(const stage_timer&) = delete;
+        stage_timer& operator=(const stage_timer&) = delete;
+
+        void stop(void);
+    private:
+        stage_time* target;
+        bool measure_cpu_time;
+
+        std::chrono::steady_clock::time_point wall_start;
+        std::chrono::nanoseconds cpu_start { 0 };
+    };
+
+
+    // Collects the statistics of every translation unit and of the stages that run once per update if -stats is provided,
+    // and writes them to the file given by -stats as JSON.
+    class statistics {
+    public:
+        static statistics& instance(void) {
+            static statistics i;
+            return i;
+        }
+
+
+        [[nodiscard]] bool is_enabled(void) const { return enabled; }
+
+        [[nodiscard]] stage_timer time(stage_time& target, bool measure_cpu_time = true) const {
+            return stage_timer { enabled ? &target : nullptr, measure_cpu_time };
+        }
+
+        [[nodiscard]] stage_timer time(unit_statistics& target, stage s) const {
+            return time(target[s], !is_per_symbol_stage(s));
+        }
+
+
+        // Both are safe to call concurrently.
+        void add_unit(std::string path, const unit_statistics& stats);
+        void add(const unit_statistics& stats);
+
+        // Writes all statistics collected since the last call (or since the program started) as JSON, and resets them.
+        // Returns false if the file could not be written.
+        bool write(const fs::path& path, std::chrono::nanoseconds wall_time);
+        // Discards all statistics collected so far.
+        void reset(void);
+    private:
+        struct unit_entry {
+            std::string path;
+            unit_statistics stats;
+        };
+
+
+        bool enabled;
+
+        std::mutex mtx;
+        unit_statistics totals;
+        std::vector<unit_entry> units;
+        std::chrono::nanoseconds process_cpu_start;
+
+
+        statistics(void);
+    };
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include <SymbolGenerator/string_pool.hpp>
+#include <SymbolGenerator/utility.hpp>
+
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <new>
+
+
+namespace symgen {
+    interned_string string_pool::intern(std::string_view string) {
+        const lookup_key key { hash_of(string), string };
+
+        auto& s = shards[get_shard_index<shard_count>(key.hash)];
+
+        // Most names are shared between many objects, so most lookups find an existing entry and only need a shared lock.
+        {
+            std::shared_lock lock { s.mtx };
+            if (auto it = s.entries.find(key); it != s.entries.end()) return interned_string { *it };
+        }
+
+        std::unique_lock lock { s.mtx };
+        if (auto it = s.entries.find(key); it != s.entries.end()) return interned_string { *it };
+
+        const header* entry = allocate(s, string, key.hash);
+        s.entries.insert(entry);
+
+        return interned_string { entry };
+    }
+
+
+    std::size_t string_pool::size(void) const {
+        std::size_t result = 0;
+
+        for (const auto& s : shards) {
+            std::shared_lock lock { s.mtx };
+            result += s.entries.size();
+        }
+
+        return result;
+    }
+
+
+    std::size_t string_pool::get_memory_usage(void) const {
+        std::size_t result = 0;
+
+        for (const auto& s : shards) {
+            std::shared_lock lock { s.mtx };
+            result += s.memory_usage;
+        }
+
+        return result;
+    }
+
+
+    std::vector<std::unique_ptr<std::byte[]>> string_pool::release(void) {
+        std::vector<std::unique_ptr<std::byte[]>> result;
+
+        for (auto& s : shards) {
+            std::move(s.blocks.begin(), s.blocks.end(), std::back_inserter(result));
+
+            s.blocks.clear();
+            s.entries      = { };
+            s.cursor       = nullptr;
+            s.block_end    = nullptr;
+            s.memory_usage = 0;
+        }
+
+        return result;
+    }
+
+
+    const string_pool::header* string_pool::allocate(shard& s, std::string_view string, std::size_t hash) {
+        // Keep every entry aligned, so the header of the next entry can be accessed directly.
+        const std::size_t size = (sizeof(header) + string.size() + alignof(header) - 1) & ~(alignof(header) - 1);
+
+        std::byte* destination;
+
+        if ((std::size_t) (s.block_end - s.cursor) >= size) {
+            destination = s.cursor;
+            s.cursor += size;
+        } else if (size > block_size / 4) {
+            // Strings too large to share a block get a block of their own. The current block is kept, since it likely still has room for smaller strings.
+            destination = s.blocks.emplace_back(std::make_unique_for_overwrite<std::byte[]>(size)).get();
+            s.memory_usage += size;
+        } else {
+            destination = s.blocks.emplace_back(std::make_unique_for_overwrite<std::byte[]>(block_size)).get();
+            s.memory_usage += block_size;
+
+            s.cursor    = destination + size;
+            s.block_end = destination + block_size;
+        }
+
+
+        auto* entry = new (destination) header { hash, (std::uint32_t) string.size() };
+        std::memcpy((void*) (entry + 1), string.data(), string.size());
+
+        return entry;
+    }
+}
\ No newline at end of file
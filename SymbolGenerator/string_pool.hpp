@@ -0,0 +1,133 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <shared_mutex>
+#include <string_view>
+#include <vector>
+
+
+namespace symgen {
+    class string_pool;
+
+
+    // Handle to a string stored in the string pool. Every distinct string is stored exactly once, so handles are compared by address,
+    // and copying one costs no more than copying a pointer. The string stays valid until the pool is rebuilt (see string_pool::rebuild).
+    class interned_string {
+    public:
+        interned_string(void) = default;
+
+
+        [[nodiscard]] std::string_view view(void) const {
+            return entry ? std::string_view { (const char*) (entry + 1), entry->size } : std::string_view { };
+        }
+
+        [[nodiscard]] std::size_t hash(void) const { return entry ? entry->hash : 0; }
+        [[nodiscard]] bool empty(void) const { return view().empty(); }
+
+        bool operator==(const interned_string& other) const { return entry == other.entry; }
+
+
+        friend std::ostream& operator<<(std::ostream& stream, const interned_string& string) {
+            return stream << string.view();
+        }
+    private:
+        friend class string_pool;
+
+        // The characters of the string are stored directly after the header.
+        struct header {
+            std::size_t hash;
+            std::uint32_t size;
+        };
+
+        const header* entry = nullptr;
+
+        explicit interned_string(const header* entry) : entry(entry) {}
+    };
+
+
+    // Process-wide pool of interned strings, used for symbol names, which are shared between the objects that contain them,
+    // the symbol registry and the set of exports. Strings are stored in large blocks rather than allocated individually,
+    // and are not freed individually. Instead, a long-running server rebuilds the pool from the strings that are still in use once most of them are not.
+    class string_pool {
+    public:
+        static string_pool& instance(void) {
+            static string_pool i;
+            return i;
+        }
+
+
+        // Returns the handle of the given string, adding it to the pool if it is not present yet. Safe to call concurrently.
+        [[nodiscard]] interned_string intern(std::string_view string);
+
+        // Replaces the pool with one that only contains the strings that are still in use. The given function is invoked with a callback,
+        // which it has to call with every handle that is still in use, and which updates the handle to refer to the new copy of its string.
+        // All other handles become invalid. Not safe to call concurrently with any other method.
+        template <typename F> void rebuild(F&& for_each_handle) {
+            auto old_blocks = release();
+
+            // The old blocks are only freed once every handle refers to the new pool.
+            for_each_handle([&] (interned_string& handle) {
+                if (handle.entry) handle = intern(handle.view());
+            });
+        }
+
+
+        [[nodiscard]] std::size_t size(void) const;
+        // Number of bytes allocated for the strings themselves, excluding the hash tables used to find them.
+        [[nodiscard]] std::size_t get_memory_usage(void) const;
+    private:
+        using header = interned_string::header;
+
+        // Allows looking up entries by their contents without creating an entry first.
+        struct lookup_key {
+            std::size_t hash;
+            std::string_view string;
+        };
+
+        struct entry_hash {
+            using is_transparent = void;
+
+            std::size_t operator()(const header* entry) const { return entry->hash; }
+            std::size_t operator()(const lookup_key& key) const { return key.hash; }
+        };
+
+        struct entry_eq {
+            using is_transparent = void;
+
+            bool operator()(const header* a, const header* b) const { return a == b; }
+            bool operator()(const header* a, const lookup_key& b) const { return interned_string { a }.view() == b.string; }
+            bool operator()(const lookup_key& a, const header* b) const { return (*this)(b, a); }
+        };
+
+
+        // Like the concurrent_hash_map, the pool is split into shards that each have their own lock, and their own blocks to store strings in.
+        struct shard {
+            mutable std::shared_mutex mtx;
+            hash_set<const header*, entry_hash, entry_eq> entries;
+
+            std::vector<std::unique_ptr<std::byte[]>> blocks;
+            // Unused part of the block new strings are currently stored in.
+            std::byte* cursor = nullptr;
+            std::byte* block_end = nullptr;
+            std::size_t memory_usage = 0;
+        };
+
+        constexpr static std::size_t shard_count = 64;
+        constexpr static std::size_t block_size  = 32 * 1024;
+
+        std::array<shard, shard_count> shards;
+
+
+        string_pool(void) = default;
+
+        static const header* allocate(shard& s, std::string_view string, std::size_t hash);
+        // Empties the pool, and returns the blocks its strings are stored in.
+        std::vector<std::unique_ptr<std::byte[]>> release(void);
+    };
+}
\ No newline at end of file
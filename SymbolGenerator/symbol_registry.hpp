@@ -0,0 +1,59 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+#include <SymbolGenerator/concurrent_hash_map.hpp>
+#include <SymbolGenerator/string_pool.hpp>
+
+#include <array>
+#include <cstdint>
+
+
+namespace symgen {
+    enum class symbol_verdict : std::uint8_t {
+        NOT_INCLUDED, INCLUDED, EXCLUDED, FORCE_INCLUDED, FORCE_EXCLUDED
+    };
+
+    constexpr std::array symbol_verdict_names {
+        "NOT_INCLUDED"sv, "INCLUDED"sv, "EXCLUDED"sv, "FORCE_INCLUDED"sv, "FORCE_EXCLUDED"sv
+    };
+
+
+    // Verdict of the -y, -n, -yo and -no rules for a symbol name.
+    struct symbol_classification {
+        symbol_verdict verdict = symbol_verdict::NOT_INCLUDED;
+        // Index of the rule that decided the verdict, within the rule group implied by the verdict.
+        std::uint32_t rule_index = 0;
+    };
+
+
+    // Process-wide record of how every symbol name was classified by the rules.
+    // Inline functions, template instantiations and COMDAT data appear in many objects, but only depend on their name to be classified,
+    // so only the first translation unit to encounter a name has to demangle it and match it against the rules.
+    // Checks that depend on the symbol record itself (section flags, symbol type) or on the object file (the DLL filter) are not stored here.
+    class symbol_registry {
+    public:
+        static symbol_registry& instance(void) {
+            static symbol_registry i;
+            return i;
+        }
+
+
+        [[nodiscard]] std::optional<symbol_classification> find(interned_string mangled_name) const {
+            return classifications.find(mangled_name);
+        }
+
+        // If another thread classified the same name in the meantime, its classification is kept. Both are identical either way.
+        void insert(interned_string mangled_name, const symbol_classification& classification) {
+            classifications.try_emplace(mangled_name, classification);
+        }
+
+        // Forgets all classifications, e.g. to measure the cost of classifying symbols for the first time. Not safe to call while objects are processed.
+        void clear(void) { classifications.clear(); }
+
+        [[nodiscard]] std::size_t size(void) const { return classifications.size(); }
+    private:
+        concurrent_hash_map<interned_string, symbol_classification> classifications;
+
+        symbol_registry(void) = default;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,265 @@
+#include <SymbolGenerator/symbol_scanner.hpp>
+#include <SymbolGenerator/logger.hpp>
+
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__)) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define SYMGEN_SCANNER_X86
+
+    #include <immintrin.h>
+
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+    #endif
+#endif
+
+// GCC and Clang only allow AVX2 intrinsics in functions compiled for AVX2. MSVC allows them everywhere.
+#if defined(__GNUC__) || defined(__clang__)
+    #define SYMGEN_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+    #define SYMGEN_TARGET_AVX2
+#endif
+
+
+namespace symgen {
+    constexpr std::size_t BLOCK_SIZE = 64;
+
+    // Returns a mask of the structural characters in a block of BLOCK_SIZE bytes, where bit i is set if byte i is one of them.
+    using block_scanner = std::uint64_t(*)(const char* block);
+
+
+    constexpr auto structural_characters = [] {
+        std::array<std::uint8_t, 256> result { };
+        for (auto c : "<>`':"sv) result[(unsigned char) c] = 1;
+
+        return result;
+    }();
+
+
+    static std::uint64_t scan_block_scalar(const char* block) {
+        std::uint64_t mask = 0;
+
+        for (std::size_t i = 0; i < BLOCK_SIZE; ++i) {
+            mask |= (std::uint64_t) structural_characters[(unsigned char) block[i]] << i;
+        }
+
+        return mask;
+    }
+
+
+#ifdef SYMGEN_SCANNER_X86
+    static std::uint64_t scan_block_sse2(const char* block) {
+        std::uint64_t mask = 0;
+
+        for (std::size_t i = 0; i < BLOCK_SIZE; i += 16) {
+            const auto bytes = _mm_loadu_si128((const __m128i*) (block + i));
+
+            const auto matches = _mm_or_si128(
+                _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('<')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('>'))),
+                    _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('`')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\'')))
+                ),
+                _mm_cmpeq_epi8(bytes, _mm_set1_epi8(':'))
+            );
+
+            mask |= (std::uint64_t) (std::uint32_t) _mm_movemask_epi8(matches) << i;
+        }
+
+        return mask;
+    }
+
+
+    SYMGEN_TARGET_AVX2 static std::uint64_t scan_block_avx2(const char* block) {
+        std::uint64_t mask = 0;
+
+        for (std::size_t i = 0; i < BLOCK_SIZE; i += 32) {
+            const auto bytes = _mm256_loadu_si256((const __m256i*) (block + i));
+
+            const auto matches = _mm256_or_si256(
+                _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('<')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('>'))),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('`')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\'')))
+                ),
+                _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(':'))
+            );
+
+            mask |= (std::uint64_t) (std::uint32_t) _mm256_movemask_epi8(matches) << i;
+        }
+
+        return mask;
+    }
+
+
+    static bool cpu_supports_avx2(void) {
+        #if defined(_MSC_VER) && !defined(__clang__)
+            int info[4];
+
+            __cpuid(info, 0);
+            if (info[0] < 7) return false;
+
+            // The OS also has to save the AVX registers on context switches.
+            __cpuid(info, 1);
+            if (!(info[2] & (1 << 27)) || (_xgetbv(0) & 0x6) != 0x6) return false;
+
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+        #else
+            return __builtin_cpu_supports("avx2");
+        #endif
+    }
+#endif
+
+
+    bool is_scanner_isa_supported(scanner_isa isa) {
+        switch (isa) {
+            case scanner_isa::SCALAR: return true;
+
+            #ifdef SYMGEN_SCANNER_X86
+                case scanner_isa::SSE2: return true;
+                case scanner_isa::AVX2: {
+                    const static bool supported = cpu_supports_avx2();
+                    return supported;
+                }
+            #endif
+
+            default: return false;
+        }
+    }
+
+
+    scanner_isa get_scanner_isa(void) {
+        const static scanner_isa isa = [] {
+            for (auto isa : { scanner_isa::AVX2, scanner_isa::SSE2 }) {
+                if (is_scanner_isa_supported(isa)) return isa;
+            }
+
+            return scanner_isa::SCALAR;
+        }();
+
+        return isa;
+    }
+
+
+    static block_scanner get_block_scanner(scanner_isa isa) {
+        logger::instance().assert_that(is_scanner_isa_supported(isa), "Instruction set ", scanner_isa_names[(std::size_t) isa], " is not supported by this processor.");
+
+        switch (isa) {
+            #ifdef SYMGEN_SCANNER_X86
+                case scanner_isa::SSE2: return &scan_block_sse2;
+                case scanner_isa::AVX2: return &scan_block_avx2;
+            #endif
+
+            default: return &scan_block_scalar;
+        }
+    }
+
+
+    std::vector<std::string_view> split_symbol_namespaces(std::string_view symbol, scanner_isa isa) {
+        const auto scan_block = get_block_scanner(isa);
+
+        std::vector<std::string_view> result;
+        std::size_t current_token_start = 0;
+
+        // See split_symbol_namespaces_reference for how quotes and templates are handled.
+        std::size_t quote_depth     = 0;
+        std::size_t template_depth  = 0;
+
+        auto at = [&] (std::size_t i) { return i < symbol.size() ? symbol[i] : '\0'; };
+
+
+        for (std::size_t block_start = 0; block_start < symbol.size(); block_start += BLOCK_SIZE) {
+            std::uint64_t mask;
+
+            if (symbol.size() - block_start >= BLOCK_SIZE) {
+                mask = scan_block(symbol.data() + block_start);
+            } else {
+                // Pad the last block with null characters, which are not structural, rather than reading past the end of the name.
+                std::array<char, BLOCK_SIZE> padded { };
+                std::memcpy(padded.data(), symbol.data() + block_start, symbol.size() - block_start);
+
+                mask = scan_block(padded.data());
+            }
+
+
+            while (mask) {
+                const std::size_t i = block_start + (std::size_t) std::countr_zero(mask);
+                mask &= mask - 1;
+
+                // The second colon of a namespace separator.
+                if (i < current_token_start) continue;
+
+                const char c = symbol[i];
+
+                if      (c == '<' && quote_depth == 0) ++template_depth;
+                else if (c == '>' && quote_depth == 0) --template_depth;
+                else if (c == '`' && template_depth == 0 && quote_depth == 0) ++quote_depth;
+
+                else if (c == '\'' && template_depth == 0 && quote_depth > 0) {
+                    const char next = at(i + 1);
+
+                    if ((next == ':' && at(i + 2) == ':') || next == '\'' || i + 1 == symbol.size()) --quote_depth;
+                    else ++quote_depth;
+                }
+
+                else if (c == ':' && at(i + 1) == ':' && template_depth == 0 && quote_depth == 0) {
+                    result.push_back(symbol.substr(current_token_start, i - current_token_start));
+                    current_token_start = i + 2; // +2 to skip leading ::
+                }
+            }
+        }
+
+
+        if (current_token_start < symbol.size()) {
+            result.push_back(symbol.substr(current_token_start));
+        }
+
+        return result;
+    }
+
+
+    std::vector<std::string_view> split_symbol_namespaces_reference(std::string_view symbol) {
+        std::vector<std::string_view> result;
+        std::string_view::iterator current_token_start = symbol.begin();
+
+        // Some symbols have names of the format X::Y::`description' or X::Y::`description 'X::Y::symbol''.
+        // These two different formats prevent us from just keeping track of nesting depth directly.
+        // Fortunately, various C++ limitations seem to make it impossible to have further nesting of quotes,
+        // e.g., X::Y::`description 'X::Y::symbol'' where "symbol" itself contains quotes seem to be impossible,
+        // so we just have to keep track of these special cases.
+        std::size_t quote_depth     = 0;
+        std::size_t template_depth  = 0;
+
+        for (auto it = symbol.begin(); it != symbol.end(); ++it) {
+            std::string_view sv { it, symbol.end() };
+
+            if      (sv.starts_with('<') && quote_depth == 0) ++template_depth;
+            else if (sv.starts_with('>') && quote_depth == 0) --template_depth;
+            else if (sv.starts_with('`') && template_depth == 0 && quote_depth == 0) ++quote_depth;
+
+            else if (sv.starts_with('\'') && template_depth == 0 && quote_depth > 0) {
+                // This could be either a begin quote or an end quote. If it is a begin quote it will be followed by a symbol,
+                // if this is an end quote it will be followed by a namespace separator, another end quote or the end of the string.
+                auto rest = sv.substr(1);
+
+                if (rest.starts_with("::") || rest.starts_with('\'') || rest.empty()) --quote_depth;
+                else ++quote_depth;
+            }
+
+            else if (sv.starts_with("::") && template_depth == 0 && quote_depth == 0) {
+                result.emplace_back(current_token_start, it);
+                current_token_start = it + 2; // +2 to skip leading ::
+
+                // Skip the second colon, so a third colon does not start another separator that overlaps this one.
+                ++it;
+            }
+        }
+
+
+        if (current_token_start != symbol.end()) {
+            result.emplace_back(current_token_start, symbol.end());
+        }
+
+        return result;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+
+namespace symgen {
+    // Instruction sets the structural character scanner can use. SSE2 and AVX2 are only available on x86 processors.
+    enum class scanner_isa : std::uint8_t { SCALAR, SSE2, AVX2 };
+
+    constexpr std::array scanner_isa_names { "SCALAR"sv, "SSE2"sv, "AVX2"sv };
+
+
+    // Returns the best instruction set supported by this processor. This is what split_symbol_namespaces uses by default.
+    [[nodiscard]] extern scanner_isa get_scanner_isa(void);
+
+    // Returns whether the given instruction set can be used on this processor.
+    [[nodiscard]] extern bool is_scanner_isa_supported(scanner_isa isa);
+
+
+    // Splits a demangled name into its namespace components, e.g. A::B<C::D>::f into A, B<C::D> and f.
+    // Rather than checking every character, the name is scanned 64 bytes at a time for the characters that can affect the split
+    // (<, >, `, ' and :) and only those characters are examined, which matters for the long names of template instantiations.
+    extern std::vector<std::string_view> split_symbol_namespaces(std::string_view symbol, scanner_isa isa = get_scanner_isa());
+
+    // Splits a demangled name by checking every character. Produces the same result as split_symbol_namespaces,
+    // and is only used to verify it and as the baseline of the benchmarks.
+    extern std::vector<std::string_view> split_symbol_namespaces_reference(std::string_view symbol);
+}
\ No newline at end of file
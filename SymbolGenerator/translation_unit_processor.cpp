@@ -1,282 +1,521 @@
 #include <SymbolGenerator/translation_unit_processor.hpp>
 #include <SymbolGenerator/rule_cache.hpp>
+#include <SymbolGenerator/namespace_cache.hpp>
+#include <SymbolGenerator/symbol_registry.hpp>
 #include <SymbolGenerator/logger.hpp>
 #include <SymbolGenerator/coff_utils.hpp>
+#include <SymbolGenerator/coff_reader.hpp>
 #include <SymbolGenerator/unexported_symbol_filters.hpp>
+#include <SymbolGenerator/object_cache.hpp>
+#include <SymbolGenerator/cache_database.hpp>
+#include <SymbolGenerator/filter_plugin.hpp>
+#include <SymbolGenerator/statistics.hpp>
+#include <SymbolGenerator/demangler.hpp>
+#include <SymbolGenerator/symbol_scanner.hpp>
 
 #include <coffi/coffi.hpp>
 #include <coffi/coffi_types.hpp>
 
-#include <fstream>
+#include <array>
+#include <span>
 #include <sstream>
 
 
 namespace symgen {
-    void translation_unit_processor::process(const fs::path& directory, std::string_view name) {
-        this->log = logger::instance().fork(std::string { name });
-        log.normal("Processing translation unit ", name, ".obj");
+    void translation_unit_processor::process(const fs::path& obj_path, std::shared_ptr<prefetched_object> prefetched) {
+        this->log = logger::instance().fork(obj_path.stem().string(), true);
+        log.normal("Processing translation unit ", obj_path.filename().string());
 
-        fs::path obj_path   = directory / (std::string { name } + ".obj");
-        fs::path cache_path = directory / (std::string { name } + ".objcache");
-        bool do_cache       = argument_parser::instance().has_argument("cache");
+        source_path = obj_path;
+        cache_key   = obj_path;
 
-        if (do_cache) load_cache(cache_path);
-        parse(obj_path);
-        if (do_cache && has_uncached_symbols) write_cache(cache_path);
+        this->prefetched = std::move(prefetched);
+
+        process_unit();
     }
 
 
-    void translation_unit_processor::parse(const fs::path& obj_path) {
-        COFFI::coffi reader;
-        reader.load(obj_path.string());
-        log.verbose(reader.get_symbols()->size(), " symbols found.");
+    void translation_unit_processor::process(const fs::path& archive_path, const archive_member& member) {
+        this->log = logger::instance().fork(stream_to_string(archive_path.stem().string(), "(", member.get_stem(), ")"), true);
+        log.normal("Processing archive member ", member.name, " of ", archive_path.filename().string());
 
+        // Members are identified by their index as well as their name, since an archive may contain multiple objects with the same name.
+        source_path = archive_path;
+        cache_key   = (fs::path { archive_path } += ".objcache") / stream_to_string(member.index, "_", member.get_stem(), ".obj");
+        member_data = member.data;
 
-        auto get_arg_strings = [] (const auto& arg) {
-            const auto arg_value   = argument_parser::instance().get_argument<std::string>(arg).value_or("");
-            const auto split_value = split(arg_value, " ");
+        process_unit();
+    }
 
-            return split_value | views::transform([] (auto sv) { return std::string { sv }; }) | ranges::to<std::vector>;
-        };
 
-        const auto args_y_split  = get_arg_strings("y");
-        const auto args_n_split  = get_arg_strings("n");
-        const auto args_yo_split = get_arg_strings("yo");
-        const auto args_no_split = get_arg_strings("no");
+    void translation_unit_processor::process_unit(void) {
+        auto& collector = statistics::instance();
+        bool use_cache  = argument_parser::instance().has_argument("cache") || argument_parser::instance().has_argument("cachedb");
+        bool from_cache = false;
 
-        const auto& args_y  = rule_cache::instance().get_includes();
-        const auto& args_n  = rule_cache::instance().get_excludes();
-        const auto& args_yo = rule_cache::instance().get_force_includes();
-        const auto& args_no = rule_cache::instance().get_force_excludes();
+        {
+            auto total_timer = collector.time(stats.total);
 
+            if (use_cache) {
+                auto timer = collector.time(stats, stage::CACHE_LOAD);
 
-        filter_function filter_fn = argument_parser::instance().has_argument("fn")
-            ? load_filter_function(*argument_parser::instance().get_argument<std::string>("fn"))
-            : [] (const char*, const void*, const void*) { return 1; };
+                load_cache();
+                from_cache = try_reuse_cache();
 
+                // Objects that are taken from the cache do not have to be read ahead anymore, unless their tables were already needed to compare them.
+                if (from_cache && prefetched) prefetched->cancel();
+            }
 
-        for (const auto& sym : *reader.get_symbols()) {
-            std::string mangled_name = sym.get_name();
-            log.trace("Current symbol: ", mangled_name);
+            if (!from_cache) parse(use_cache);
+        }
 
+        stats[counter::OBJECTS]            = 1;
+        stats[counter::OBJECTS_FROM_CACHE] = from_cache;
+        stats[counter::SYMBOLS_INCLUDED]   = included_symbols.size();
 
-            if (auto it = cached_symbols.find(mangled_name); it != cached_symbols.end()) {
-                if (it->second != symbol_state::EXCLUDED) {
-                    included_symbols.push_back({ std::move(mangled_name), it->second == symbol_state::DATA });
-                }
+        collector.add_unit(cache_key.string(), stats);
+    }
 
-                log.trace("Symbol was cached and will ", (it->second == symbol_state::EXCLUDED ? "NOT " : ""), "be included");
-                continue;
-            }
 
+    // If -cachedb is provided, caches are stored in the project-wide cache database, rather than in a .objcache file next to each object.
+    static bool use_cache_database(void) {
+        return argument_parser::instance().has_argument("cachedb");
+    }
 
-            std::string demangled_name  = demangle_symbol(mangled_name);
-            auto        name_components = split_symbol_namespaces(demangled_name);
-            log.trace("...which demangled into ", demangled_name);
 
-            enum { NOT_INCLUDED, INCLUDED, EXCLUDED, FORCE_INCLUDED, FORCE_EXCLUDED } state = NOT_INCLUDED;
+    static fs::path get_cache_path(const fs::path& obj_path) {
+        return fs::path { obj_path }.replace_extension(".objcache");
+    }
 
 
-            // Check if this is a symbol that cannot be exported.
-            if (auto filter_reason = filters::apply_all(sym, reader, demangled_name); filter_reason) {
-                state = FORCE_EXCLUDED;
-                log.trace("Symbol is now FORCE_EXCLUDED because it cannot be exported. (Excluded by filter ", *filter_reason, ")");
+    // Settings that affect the contents of a cache file.
+    static hash_map<std::string, std::string> get_cache_settings(void) {
+        hash_map<std::string, std::string> result;
+
+        for (const auto& setting : std::array { "y", "n", "yo", "no", "fn" }) {
+            if (auto arg = argument_parser::instance().get_argument<std::string>(setting); arg) {
+                result.emplace(setting, *arg);
             }
+        }
 
+        return result;
+    }
 
-            // Check if the symbol is force included or force excluded.
-            if (state != FORCE_EXCLUDED) {
-                for (const auto& [i, rgx] : args_yo | views::enumerate) {
-                    if (std::regex_match(demangled_name.begin(), demangled_name.end(), rgx)) {
-                        state = FORCE_INCLUDED;
-                        log.trace("Symbol is now FORCE_INCLUDED because of rule yo = ", args_yo_split[i]);
 
-                        break;
-                    }
-                }
+    void translation_unit_processor::parse(bool use_cache) {
+        auto& collector = statistics::instance();
+        auto& pool      = string_pool::instance();
+
+        // Pages of the object are only read once they are accessed, so this only measures opening the object and reading its headers.
+        // For prefetched objects, this is the time spent waiting for the read_queue instead.
+        auto load_timer = collector.time(stats, stage::OBJECT_LOAD);
+        auto contents   = member_data;
+
+        if (prefetched) {
+            prefetched->wait();
+
+            if (prefetched->get_error()) {
+                log.warning("Skipping ", cache_key, ": ", *prefetched->get_error());
+                return;
             }
+        }
+
+        coff_reader reader =
+            prefetched ? coff_reader { prefetched->get_segments(), prefetched->get_size() } :
+            contents   ? coff_reader { *contents } :
+            coff_reader { source_path };
+        load_timer.stop();
+
+        if (reader.get_error()) {
+            log.warning("Skipping ", cache_key, ": ", *reader.get_error());
+            return;
+        }
+
+        log.verbose(reader.get_symbol_table_size(), " symbol table entries found.");
+
+
+        // Symbols that passed all other filters are passed to the -fn filter library together, once the whole object has been classified.
+        const bool use_filter_plugin = argument_parser::instance().has_argument("fn");
+        std::vector<filter_candidate> filter_candidates;
+
+        // Any symbol could be force included by a -yo rule, and traces show the demangled name of every symbol, so in either case all symbols are demangled.
+        const bool use_mangled_scopes = rule_cache::instance().get_force_includes().empty() && log.get_level() > logger::TRACE;
+
+
+        using enum symbol_verdict;
+        std::size_t symbol_count = 0;
+
+        // Final state of every symbol, to write back to the cache. Names refer into the object file, so the cache is written before the reader is closed.
+        std::vector<std::pair<std::string_view, symbol_state>> symbol_states;
+        bool has_uncached_symbols = false;
+
+        for (const coff_symbol& sym : reader) {
+            ++symbol_count;
+
+            log.trace("Current symbol: ", sym.name);
 
-            for (const auto& [i, rgx] : args_no | views::enumerate) {
-                if (std::regex_match(demangled_name.begin(), demangled_name.end(), rgx)) {
-                    state = FORCE_EXCLUDED;
-                    log.trace("Symbol is now FORCE_EXCLUDED because of rule no = ", args_no_split[i]);
 
-                    break;
+            if (auto cached_state = cache.find(sym.name); cached_state) {
+                ++stats[counter::CACHE_HITS];
+
+                if (*cached_state != symbol_state::EXCLUDED) {
+                    included_symbols.push_back({ pool.intern(sym.name), *cached_state == symbol_state::DATA });
                 }
+
+                symbol_states.emplace_back(sym.name, *cached_state);
+
+                log.trace("Symbol was cached and will ", (*cached_state == symbol_state::EXCLUDED ? "NOT " : ""), "be included");
+                continue;
             }
 
 
-            // If the symbol is not force included or excluded, check the include status of the namespace.
-            // TODO: Cache namespace status?
-            if (state == NOT_INCLUDED) {
-                for (const auto& ns : name_components | views::drop_last(1)) {
-                    if (state == NOT_INCLUDED && !args_y.empty()) {
-                        for (const auto& [i, rgx] : args_y | views::enumerate) {
-                            if (std::regex_match(ns.begin(), ns.end(), rgx)) {
-                                state = INCLUDED;
-                                log.trace("Symbol is now INCLUDED because of rule y = ", args_y_split[i]);
+            if (use_cache) ++stats[counter::CACHE_MISSES];
 
-                                break;
-                            }
-                        }
-                    }
+            interned_string mangled_name;
+            std::string demangled_name;
+            symbol_verdict state;
 
-                    if ((state == NOT_INCLUDED || state == INCLUDED) && !args_n.empty()) {
-                        for (const auto& [i, rgx] : args_n | views::enumerate) {
-                            if (std::regex_match(ns.begin(), ns.end(), rgx)) {
-                                state = EXCLUDED;
-                                log.trace("Symbol is now EXCLUDED because of rule n = ", args_n_split[i]);
 
-                                break;
-                            }
-                        }
-                    }
+            auto filter_timer  = collector.time(stats, stage::BUILTIN_FILTERS);
+            auto filter_reason = filters::apply_all(sym, reader);
+            filter_timer.stop();
+
+            // Check if this is a symbol that cannot be exported. This only depends on the symbol record, so the name doesn't have to be demangled for it.
+            // Otherwise, check the rules, unless another translation unit already did so for the same name.
+            // Names are interned once they passed the filters, so every stage after that refers to the same copy of the name.
+            if (filter_reason) {
+                state = FORCE_EXCLUDED;
+                ++stats[counter::SYMBOLS_FILTERED];
+
+                log.trace("Symbol is now FORCE_EXCLUDED because it cannot be exported. (Excluded by filter ", *filter_reason, ")");
+            } else if (mangled_name = pool.intern(sym.name); auto classification = symbol_registry::instance().find(mangled_name)) {
+                state = classification->verdict;
+                ++stats[counter::DUPLICATE_SYMBOLS];
+
+                log.trace("Symbol was already classified as ", symbol_verdict_names[(std::size_t) state], " by another translation unit.");
+            } else {
+                std::optional<symbol_classification> new_classification;
+
+                if (use_mangled_scopes) {
+                    auto rule_timer = collector.time(stats, stage::RULE_MATCHING);
+                    new_classification = classify_mangled_symbol(sym.name);
                 }
-            }
 
+                if (new_classification) {
+                    ++stats[counter::SYMBOLS_NOT_DEMANGLED];
+                } else {
+                    auto demangle_timer = collector.time(stats, stage::DEMANGLING);
+                    demangled_name = demangle_symbol(sym.name);
+                    demangle_timer.stop();
 
-            // If the symbol is included, check if it isn't excluded by the filter function.
-            if (state == INCLUDED || state == FORCE_INCLUDED) {
-                if (filter_fn(demangled_name.c_str(), &sym, &reader) == 0) {
-                    state = FORCE_EXCLUDED;
-                    log.trace("Symbol is now FORCE_EXCLUDED because of DLL filter.");
+                    log.trace("...which demangled into ", demangled_name);
+
+                    auto rule_timer = collector.time(stats, stage::RULE_MATCHING);
+                    new_classification = classify_symbol(demangled_name);
                 }
+
+                symbol_registry::instance().insert(mangled_name, *new_classification);
+
+                state = new_classification->verdict;
             }
 
 
             if (state == INCLUDED || state == FORCE_INCLUDED) {
                 bool is_data = is_data_symbol(sym);
 
+                if (use_filter_plugin) {
+                    if (demangled_name.empty()) {
+                        auto timer = collector.time(stats, stage::DEMANGLING);
+                        demangled_name = demangle_symbol(sym.name);
+                    }
+
+                    filter_candidates.push_back({ std::move(demangled_name), sym.index, included_symbols.size(), symbol_states.size() });
+                }
+
                 included_symbols.push_back({ mangled_name, is_data });
-                cached_symbols.emplace(std::move(mangled_name), is_data ? symbol_state::DATA : symbol_state::FUNCTION);
+                symbol_states.emplace_back(sym.name, is_data ? symbol_state::DATA : symbol_state::FUNCTION);
             } else {
-                cached_symbols.emplace(std::move(mangled_name), symbol_state::EXCLUDED);
+                symbol_states.emplace_back(sym.name, symbol_state::EXCLUDED);
             }
 
             has_uncached_symbols = true;
         }
 
 
-        log.verbose("Keeping ", included_symbols.size(), "/", reader.get_symbols()->size(), " symbols");
-    }
+        bool filter_applied = true;
 
+        if (!filter_candidates.empty()) {
+            auto timer = collector.time(stats, stage::FILTER_PLUGIN);
+            filter_applied = apply_filter_plugin(filter_candidates, symbol_states);
+        }
 
-    void translation_unit_processor::load_cache(const fs::path& path) {
-        if (!fs::exists(path)) {
-            log.verbose("No cache found.");
-            return;
+        stats[counter::SYMBOLS_SEEN] = symbol_count;
+
+        log.verbose("Keeping ", included_symbols.size(), "/", symbol_count, " symbols");
+
+
+        // Also rewrite the cache if all symbols were cached but the object itself changed, so the next run can skip it entirely.
+        // If the filter library could not be applied, its symbols were excluded for this run only, so the object is not cached.
+        if (use_cache && filter_applied) {
+            auto identity = object_cache::identify(source_path, reader);
+
+            if (has_uncached_symbols || identity != cache.get_object_identity()) {
+                auto timer = collector.time(stats, stage::CACHE_WRITE);
+                write_cache(identity, symbol_states);
+            }
         }
+    }
 
 
-        enum { UNKNOWN, READ_SETTINGS, READ_SYMBOLS, READ_VERSION } state = UNKNOWN;
+    bool translation_unit_processor::apply_filter_plugin(std::span<const filter_candidate> candidates, std::span<std::pair<std::string_view, symbol_state>> symbol_states) {
+        // The filter library receives COFFI objects, so the object is only loaded through COFFI if there are symbols to pass to it.
+        COFFI::coffi legacy_reader;
+        bool loaded;
 
-        std::ifstream stream { path };
-        log.assert_that(!stream.fail(), "Failed to read cache file ", path);
+        if (member_data) {
+            std::istringstream stream { std::string { (const char*) member_data->data(), member_data->size() }, std::ios::binary };
+            loaded = legacy_reader.load(stream);
+        } else {
+            loaded = legacy_reader.load(source_path.string());
+        }
 
-        std::string line;
-        hash_map<std::string, std::string> cached_args;
-        std::string version = "";
+        // COFFI does not support every object the built-in reader does. Without its objects the filter library cannot be invoked, so no candidate is kept.
+        bool applied = loaded && ranges::all_of(candidates, [&] (const filter_candidate& candidate) {
+            return candidate.symbol_index < legacy_reader.get_symbols()->size();
+        });
 
+        std::vector<std::uint8_t> keep((candidates.size() + 7) / 8);
 
-        while (std::getline(stream, line)) {
-            std::string_view sv { line };
-            if (sv.empty()) continue;
+        if (applied) {
+            const auto& legacy_symbols = *legacy_reader.get_symbols();
 
-            if (sv.starts_with("#SETTINGS")) {
-                state = READ_SETTINGS;
-                continue;
-            }
+            std::vector<const char*> names;
+            std::vector<const void*> symbols;
 
-            if (sv.starts_with("#SYMBOLS")) {
-                state = READ_SYMBOLS;
-                continue;
+            for (const auto& candidate : candidates) {
+                names.push_back(candidate.demangled_name.c_str());
+                symbols.push_back(&legacy_symbols[candidate.symbol_index]);
             }
 
-            if (sv.starts_with("#VERSION")) {
-                state = READ_VERSION;
-                continue;
-            }
+            filter_plugin::instance().filter(names, symbols, &legacy_reader, keep.data());
+        } else {
+            log.warning("Failed to load ", cache_key, " for DLL filter, excluding its ", candidates.size(), " remaining symbols.");
+        }
 
-            if (state == READ_SETTINGS) {
-                auto pos = sv.find('=');
-                log.assert_that(pos != std::string_view::npos, "Incorrectly formatted cache file: ", path);
 
-                auto k = sv.substr(0, pos);
-                auto v = sv.substr(pos + 1, std::string_view::npos);
-                cached_args.emplace(k, v);
-            }
+        std::vector<bool> rejected(included_symbols.size(), false);
 
-            if (state == READ_SYMBOLS) {
-                auto pos = sv.find('=');
-                log.assert_that(pos != std::string_view::npos, "Incorrectly formatted cache file: ", path);
+        for (const auto& [i, candidate] : candidates | views::enumerate) {
+            if (keep[i / 8] & (1u << (i % 8))) continue;
 
-                auto k = sv.substr(0, pos);
-                auto v = sv.substr(pos + 1, std::string_view::npos);
+            rejected[candidate.included_index] = true;
+            ++stats[counter::SYMBOLS_REJECTED_BY_PLUGIN];
+            symbol_states[candidate.state_index].second = symbol_state::EXCLUDED;
 
+            log.trace("Symbol ", included_symbols[candidate.included_index].mangled_name, " is now FORCE_EXCLUDED because of DLL filter.");
+        }
 
-                for (auto s : { symbol_state::DATA, symbol_state::FUNCTION, symbol_state::EXCLUDED }) {
-                    if (v.starts_with((char) s)) {
-                        cached_symbols.emplace(k, s);
-                        break;
-                    }
-                }
-            }
+        std::size_t kept = 0;
 
-            if (state == READ_VERSION) {
-                if (!sv.empty()) version = std::string { sv };
-            }
+        for (std::size_t i = 0; i < included_symbols.size(); ++i) {
+            if (rejected[i]) continue;
+            if (kept != i) included_symbols[kept] = std::move(included_symbols[i]);
+
+            ++kept;
+        }
+
+        included_symbols.resize(kept);
+        return applied;
+    }
+
+
+    symbol_classification translation_unit_processor::classify_symbol(const std::string& demangled_name) const {
+        using enum symbol_verdict;
+
+        const auto& args_y  = rule_cache::instance().get_includes();
+        const auto& args_n  = rule_cache::instance().get_excludes();
+        const auto& args_yo = rule_cache::instance().get_force_includes();
+        const auto& args_no = rule_cache::instance().get_force_excludes();
+
+
+        // Check if the symbol is force included or force excluded.
+        if (auto rule = args_no.match(demangled_name); rule) {
+            log.trace("Symbol is now FORCE_EXCLUDED because of rule no = ", args_no.patterns[*rule]);
+            return { FORCE_EXCLUDED, (std::uint32_t) *rule };
         }
 
+        if (auto rule = args_yo.match(demangled_name); rule) {
+            log.trace("Symbol is now FORCE_INCLUDED because of rule yo = ", args_yo.patterns[*rule]);
+            return { FORCE_INCLUDED, (std::uint32_t) *rule };
+        }
+
+
+        // If the symbol is not force included or excluded, check the include status of the namespace.
+        auto name_components = split_symbol_namespaces(demangled_name);
+        if (name_components.empty()) return { NOT_INCLUDED, 0 };
+
+        auto status = namespace_cache::instance().classify(std::span { name_components }.first(name_components.size() - 1));
+
+        if (status.verdict == namespace_verdict::INCLUDED) {
+            log.trace("Symbol is now INCLUDED because of rule y = ", args_y.patterns[status.rule_index]);
+            return { INCLUDED, (std::uint32_t) status.rule_index };
+        }
+
+        if (status.verdict == namespace_verdict::EXCLUDED) {
+            log.trace("Symbol is now EXCLUDED because of rule n = ", args_n.patterns[status.rule_index]);
+            return { EXCLUDED, (std::uint32_t) status.rule_index };
+        }
+
+        return { NOT_INCLUDED, 0 };
+    }
 
-        // Make sure the cache file is using the format version we expect.
-        if (version.empty()) version = "None";
 
-        if (version != CACHE_FMT_VERSION) {
-            log.warning(
-                "Cache file is using an outdated format and cannot be used ",
-                "(Expected ", CACHE_FMT_VERSION, ", got ", version, "). ",
-                "You should delete cache files manually."
-            );
+    std::optional<symbol_classification> translation_unit_processor::classify_mangled_symbol(std::string_view mangled_name) const {
+        using enum symbol_verdict;
 
-            cached_symbols.clear();
+        // Most symbols are decided by their namespace alone, and the namespaces of most symbols can be read from the mangled name directly.
+        auto scopes = get_msvc_scopes(mangled_name);
+        if (!scopes) return std::nullopt;
+
+        auto status = namespace_cache::instance().classify(*scopes);
+
+        // Included symbols still have to be checked against the -no rules, which match the demangled name.
+        if (status.verdict == namespace_verdict::INCLUDED) {
+            if (!rule_cache::instance().get_force_excludes().empty()) return std::nullopt;
+            return symbol_classification { INCLUDED, (std::uint32_t) status.rule_index };
+        }
+
+        if (status.verdict == namespace_verdict::EXCLUDED) return symbol_classification { EXCLUDED, (std::uint32_t) status.rule_index };
+        return symbol_classification { NOT_INCLUDED, 0 };
+    }
+
+
+    void translation_unit_processor::load_cache(void) {
+        object_cache loaded;
+
+        if (use_cache_database()) {
+            auto contents = cache_database::instance().find(cache_key);
+
+            if (!contents) {
+                log.verbose("No cache found.");
+                return;
+            }
+
+            loaded = object_cache { *contents };
+        } else {
+            auto path = get_cache_path(cache_key);
+
+            if (!fs::exists(path)) {
+                log.verbose("No cache found.");
+                return;
+            }
+
+            loaded = object_cache { path };
+        }
+
+        if (loaded.get_error()) {
+            log.verbose("Cache cannot be used and will be replaced. (", *loaded.get_error(), ")");
             return;
         }
 
 
         // Make sure arguments match between cache and current program invocation.
-        hash_map<std::string, std::string> current_args;
-        for (const auto& setting : std::array { "y", "n", "yo", "no", "fn" }) {
-            if (auto arg = argument_parser::instance().get_argument<std::string>(setting); arg) {
-                current_args.emplace(setting, *arg);
+        // If the hashes match the settings are equivalent, otherwise compare them to find out what changed.
+        auto current_args = get_cache_settings();
+
+        if (loaded.get_settings_hash() != object_cache::hash_settings(current_args)) {
+            if (auto error_msg = check_settings_compatible(loaded.get_settings(), current_args); error_msg) {
+                log.verbose("Cache is out of date and cannot be used. (", *error_msg, ")");
+                return;
             }
         }
 
-        auto error_msg = check_settings_compatible(cached_args, current_args);
-        if (error_msg) {
-            log.verbose("Cache is out of date and cannot be used. (", *error_msg, ")");
-            cached_symbols.clear();
-        } else {
-            log.verbose("Loaded ", cached_symbols.size(), " symbols from cache.");
-        }
+
+        cache = std::move(loaded);
+        log.verbose("Loaded ", cache.size(), " symbols from cache.");
     }
 
 
-    void translation_unit_processor::write_cache(const fs::path& path) const {
-        std::ofstream stream { path };
+    bool translation_unit_processor::try_reuse_cache(void) {
+        if (!cache.is_valid()) return false;
 
-        stream << "#SETTINGS\n";
-        for (const auto& setting : std::array { "y", "n", "yo", "no", "fn" }) {
-            if (auto arg = argument_parser::instance().template get_argument<std::string>(setting); arg) {
-                stream << setting << "=" << *arg << "\n";
+        const auto& identity = cache.get_object_identity();
+        std::error_code ec;
+
+        auto size = member_data ? member_data->size() : fs::file_size(source_path, ec);
+        if (ec || size != identity.size) return false;
+
+        // Archive members have no timestamp of their own (lib.exe does not store one), so they use the timestamp of the archive.
+        auto modification_time = fs::last_write_time(source_path, ec);
+        if (ec) return false;
+
+
+        // If the timestamp changed but the size did not, the object may have been rebuilt without changing (or just touched), so compare its tables.
+        // Only the identity in the cache has to be updated in that case.
+        bool touched = modification_time.time_since_epoch().count() != identity.modification_time;
+        object_identity new_identity;
+
+        if (touched) {
+            // The object is opened again by parse(), which skips it with a warning if it still cannot be read.
+            if (prefetched) {
+                prefetched->wait();
+                if (prefetched->get_error()) return false;
             }
+
+            coff_reader reader =
+                prefetched  ? coff_reader { prefetched->get_segments(), prefetched->get_size() } :
+                member_data ? coff_reader { *member_data } :
+                coff_reader { source_path };
+
+            if (reader.get_error()) return false;
+
+            new_identity = object_cache::identify(source_path, reader);
+            if (new_identity.content_hash != identity.content_hash) return false;
         }
 
-        stream << "#SYMBOLS\n";
-        for (const auto& [symbol, state] : cached_symbols) {
-            stream << symbol << "=" << (char) state << "\n";
+
+        cache.for_each_symbol([&] (std::string_view symbol, symbol_state state) {
+            if (state != symbol_state::EXCLUDED) included_symbols.push_back({ string_pool::instance().intern(symbol), state == symbol_state::DATA });
+        });
+
+        log.verbose("Object is unchanged, using ", included_symbols.size(), " symbols from cache.");
+
+
+        if (touched) {
+            if (use_cache_database()) {
+                std::vector<std::byte> contents { cache.get_contents().begin(), cache.get_contents().end() };
+                object_cache::set_object_identity(contents, new_identity);
+
+                cache_database::instance().insert(cache_key, std::move(contents));
+            } else {
+                // Release the cache file first, since a mapped file cannot be written to on Windows.
+                cache = object_cache { };
+                object_cache::update_object_identity(get_cache_path(cache_key), new_identity);
+            }
+        }
+
+        return true;
+    }
+
+
+    void translation_unit_processor::write_cache(const object_identity& identity, std::span<const std::pair<std::string_view, symbol_state>> symbol_states) {
+        // Release the old cache file first, since a mapped file cannot be replaced on Windows.
+        cache = object_cache { };
+
+        auto contents = object_cache::serialize(identity, get_cache_settings(), symbol_states);
+
+        if (use_cache_database()) {
+            cache_database::instance().insert(cache_key, std::move(contents));
+        } else {
+            // Caches of archive members are stored in a directory next to the archive, which may not exist yet.
+            if (member_data) {
+                std::error_code ec;
+                fs::create_directories(cache_key.parent_path(), ec);
+            }
+
+            object_cache::write(get_cache_path(cache_key), contents);
         }
 
-        log.assert_that((bool) stream, "Failed to write to cache file ", path);
-        log.verbose("Wrote ", cached_symbols.size(), " symbols to cache.");
+        log.verbose("Wrote ", symbol_states.size(), " symbols to cache.");
     }
-}
+}
\ No newline at end of file
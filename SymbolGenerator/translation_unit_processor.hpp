@@ -5,16 +5,17 @@
 #include <SymbolGenerator/argument_parser.hpp>
 #include <SymbolGenerator/rule_cache.hpp>
 #include <SymbolGenerator/logger.hpp>
+#include <SymbolGenerator/symbol_registry.hpp>
+#include <SymbolGenerator/object_cache.hpp>
+#include <SymbolGenerator/archive_reader.hpp>
+#include <SymbolGenerator/statistics.hpp>
+#include <SymbolGenerator/string_pool.hpp>
+#include <SymbolGenerator/read_queue.hpp>
 
 
 namespace symgen {
-    enum class symbol_state : char {
-        FUNCTION = 'F', DATA = 'D', EXCLUDED = 'E'
-    };
-
-
     struct included_symbol {
-        std::string mangled_name;
+        interned_string mangled_name;
         bool is_data_symbol;
 
         bool operator==(const included_symbol& other) const {
@@ -22,27 +23,55 @@ namespace symgen {
         }
 
         std::size_t hash(void) const {
-            return hash_of(mangled_name);
+            return mangled_name.hash();
         }
     };
 
 
     class translation_unit_processor {
     public:
-        constexpr static std::string_view CACHE_FMT_VERSION = "0.0.2";
-
+        // Processes a loose object file. If the object was prefetched by a read_queue, its tables are taken from there instead of mapping the file.
+        // Prefetched objects cannot be used with -cache or -cachedb, since the cache stores a hash of the entire object.
+        void process(const fs::path& obj_path, std::shared_ptr<prefetched_object> prefetched = nullptr);
+        // Processes a single object stored in an archive. The archive must stay open until processing is done.
+        void process(const fs::path& archive_path, const archive_member& member);
 
-        void process(const fs::path& directory, std::string_view name);
         [[nodiscard]] const std::vector<included_symbol>& get_included_symbols(void) const { return included_symbols; }
     private:
+        // Symbol that passed all other filters, and still has to be passed to the -fn filter library.
+        struct filter_candidate {
+            std::string demangled_name;
+            std::uint32_t symbol_index;
+            // Indices of the symbol in included_symbols and in the symbol states that are written to the cache.
+            std::size_t included_index, state_index;
+        };
+
+
         mutable logger log;
 
-        hash_map<std::string, symbol_state> cached_symbols;
+        // File the object is stored in, i.e. the object itself or the archive containing it.
+        fs::path source_path;
+        // Path the cache of the object is stored under. For archive members this is a path in a directory next to the archive.
+        fs::path cache_key;
+        // Contents of the object if it is an archive member.
+        std::optional<std::span<const std::byte>> member_data;
+        // Object being read by a read_queue, if it is a loose object that was prefetched.
+        std::shared_ptr<prefetched_object> prefetched;
+
+        object_cache cache;
         std::vector<included_symbol> included_symbols;
-        bool has_uncached_symbols = false;
+        unit_statistics stats;
 
-        void parse(const fs::path& obj_path);
-        void load_cache(const fs::path& path);
-        void write_cache(const fs::path& path) const;
+        void process_unit(void);
+        void parse(bool use_cache);
+        // Passes the candidates to the -fn filter library and removes the rejected ones. Returns false if the object could not be loaded for it,
+        // in which case all candidates are removed.
+        bool apply_filter_plugin(std::span<const filter_candidate> candidates, std::span<std::pair<std::string_view, symbol_state>> symbol_states);
+        symbol_classification classify_symbol(const std::string& demangled_name) const;
+        // Classifies a symbol without demangling it, if it can be decided without its demangled name. Only valid if there are no -yo rules.
+        std::optional<symbol_classification> classify_mangled_symbol(std::string_view mangled_name) const;
+        void load_cache(void);
+        bool try_reuse_cache(void);
+        void write_cache(const object_identity& identity, std::span<const std::pair<std::string_view, symbol_state>> symbol_states);
     };
 }
\ No newline at end of file
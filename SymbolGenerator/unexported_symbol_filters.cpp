@@ -6,70 +6,75 @@
 
 
 namespace symgen::filters {
-    std::string remove_prefix(std::string_view mangled_name, const COFFI::coffi& reader) {
-        std::string result { mangled_name };
+    // The result is always a part of the name itself, so no copy of the name is made.
+    std::string_view remove_prefix(std::string_view mangled_name, const coff_reader& reader) {
+        std::string_view result = mangled_name;
 
         std::size_t leading_whitespace = 0;
-        while (result.size() > leading_whitespace && std::isspace(result[leading_whitespace])) ++leading_whitespace;
-        result.erase(0, leading_whitespace);
+        while (result.size() > leading_whitespace && std::isspace((unsigned char) result[leading_whitespace])) ++leading_whitespace;
+        result.remove_prefix(leading_whitespace);
 
         if (result.starts_with('_')) {
             auto where = result.find('@');
-            if (where != std::string::npos) result.erase(where);
+            if (where != std::string_view::npos) result = result.substr(0, where);
         }
 
-        if (reader.get_header()->get_machine() == IMAGE_FILE_MACHINE_I386) {
-            if (result.starts_with('_')) result.erase(0, 1);
+        if (reader.get_machine() == MACHINE_I386) {
+            if (result.starts_with('_')) result.remove_prefix(1);
         }
 
         return result;
     }
 
 
-    bool filter_symbol_type(const COFFI::symbol& sym, const COFFI::coffi& reader, std::string_view demangled) {
+    bool filter_symbol_type(const coff_symbol& sym, const coff_reader& reader) {
         return is_data_symbol(sym) || is_function_symbol(sym);
     }
 
 
-    bool filter_destructors(const COFFI::symbol& sym, const COFFI::coffi& reader, std::string_view demangled) {
-        auto base_name = remove_prefix(sym.get_name(), reader);
+    bool filter_destructors(const coff_symbol& sym, const coff_reader& reader) {
+        auto base_name = remove_prefix(sym.name, reader);
 
         if (base_name.starts_with("??_G") || base_name.starts_with("??_E")) return false;
         return true;
     }
 
 
-    bool filter_constants(const COFFI::symbol& sym, const COFFI::coffi& reader, std::string_view demangled) {
-        return !(sym.get_type() == IMAGE_SYM_TYPE_NULL && !(get_section_flags_for_symbol(sym, reader) & SECTION_WRITE_BIT));
+    bool filter_constants(const coff_symbol& sym, const coff_reader& reader) {
+        return !(sym.type == SYMBOL_TYPE_NULL && !(get_section_flags_for_symbol(sym, reader) & SECTION_WRITE_BIT));
     }
 
 
-    bool filter_rx_functions(const COFFI::symbol& sym, const COFFI::coffi& reader, std::string_view demangled) {
-        return !(sym.get_type() == IMAGE_SYM_DTYPE_FUNCTION && !(get_section_flags_for_symbol(sym, reader) & (SECTION_READ_BIT | SECTION_EXECUTE_BIT)));
+    bool filter_rx_functions(const coff_symbol& sym, const coff_reader& reader) {
+        return !(sym.type == SYMBOL_DTYPE_FUNCTION && !(get_section_flags_for_symbol(sym, reader) & (SECTION_READ_BIT | SECTION_EXECUTE_BIT)));
     }
 
 
-    bool filter_dot_symbols(const COFFI::symbol& sym, const COFFI::coffi& reader, std::string_view demangled) {
-        return sym.get_name().find('.') == std::string::npos;
+    bool filter_dot_symbols(const coff_symbol& sym, const coff_reader& reader) {
+        return sym.name.find('.') == std::string_view::npos;
     }
 
 
-    bool filter_managed_code(const COFFI::symbol& sym, const COFFI::coffi& reader, std::string_view demangled) {
-        auto base_name = remove_prefix(sym.get_name(), reader);
+    bool filter_managed_code(const coff_symbol& sym, const coff_reader& reader) {
+        auto base_name = remove_prefix(sym.name, reader);
+
+        // Look for $$F and $$J in a single pass over the name.
+        for (auto where = base_name.find("$$"); where != std::string_view::npos; where = base_name.find("$$", where + 1)) {
+            if (where + 2 < base_name.size() && (base_name[where + 2] == 'F' || base_name[where + 2] == 'J')) return false;
+        }
 
-        if (base_name.find("$$F") != std::string::npos || base_name.find("$$J") != std::string::npos) return false;
         if (ranges::contains(std::array { "__t2m", "__m2mep", "__mep" }, base_name)) return false;
 
         return true;
     }
 
 
-    bool filter_arm64ec_thunk(const COFFI::symbol& sym, const COFFI::coffi& reader, std::string_view demangled) {
-        if (reader.get_header()->get_machine() == IMAGE_FILE_MACHINE_ARM64EC) {
+    bool filter_arm64ec_thunk(const coff_symbol& sym, const coff_reader& reader) {
+        if (reader.get_machine() == MACHINE_ARM64EC) {
             const static std::regex filter { "\\$i?(entry|exit)_thunk" };
-            auto base_name = remove_prefix(sym.get_name(), reader);
+            auto base_name = remove_prefix(sym.name, reader);
 
-            if (std::regex_match(base_name, filter)) return false;
+            if (std::regex_match(base_name.begin(), base_name.end(), filter)) return false;
         }
 
         return true;
@@ -1,11 +1,12 @@
 #pragma once
 
-#include <coffi/coffi.hpp>
+#include <SymbolGenerator/coff_reader.hpp>
 
 #include <array>
 #include <string_view>
 #include <optional>
 #include <algorithm>
+#include <functional>
 
 
 // Provides a set of filters to filter out any symbols that should never be exported, like scalar/vector deleting destructors and managed code.
@@ -13,23 +14,23 @@
 // which itself is based on the bindexplib tool from the CERN ROOT Data Analysis Framework project (https://root.cern.ch).
 namespace symgen::filters {
     // Filter unexpected symbol types (Only types 0x00 and 0x20 should be present).
-    extern bool filter_symbol_type(const COFFI::symbol& sym, const COFFI::coffi& reader, std::string_view demangled);
+    extern bool filter_symbol_type(const coff_symbol& sym, const coff_reader& reader);
     // Filter scalar/vector deleting destructors.
-    extern bool filter_destructors(const COFFI::symbol& sym, const COFFI::coffi& reader, std::string_view demangled);
+    extern bool filter_destructors(const coff_symbol& sym, const coff_reader& reader);
     // Filter read-only constants.
-    extern bool filter_constants(const COFFI::symbol& sym, const COFFI::coffi& reader, std::string_view demangled);
+    extern bool filter_constants(const coff_symbol& sym, const coff_reader& reader);
     // Filter function symbols that are not readable or executable.
-    extern bool filter_rx_functions(const COFFI::symbol& sym, const COFFI::coffi& reader, std::string_view demangled);
+    extern bool filter_rx_functions(const coff_symbol& sym, const coff_reader& reader);
     // Filter symbols containing a dot character.
-    extern bool filter_dot_symbols(const COFFI::symbol& sym, const COFFI::coffi& reader, std::string_view demangled);
+    extern bool filter_dot_symbols(const coff_symbol& sym, const coff_reader& reader);
     // Filter symbols from managed code.
-    extern bool filter_managed_code(const COFFI::symbol& sym, const COFFI::coffi& reader, std::string_view demangled);
+    extern bool filter_managed_code(const coff_symbol& sym, const coff_reader& reader);
     // On ARM64EC, filter $i?[entry|exit]_thunk symbols.
-    extern bool filter_arm64ec_thunk(const COFFI::symbol& sym, const COFFI::coffi& reader, std::string_view demangled);
+    extern bool filter_arm64ec_thunk(const coff_symbol& sym, const coff_reader& reader);
 
 
     // Applies all filters to the given symbol. Returns the name of the filter that caused the symbol's exclusion, or nullopt otherwise.
-    inline std::optional<std::string_view> apply_all(const COFFI::symbol& sym, const COFFI::coffi& reader, std::string_view demangled) {
+    inline std::optional<std::string_view> apply_all(const coff_symbol& sym, const coff_reader& reader) {
         const static std::array filters {
             std::pair { &filter_symbol_type,   "filter_symbol_type"   },
             std::pair { &filter_destructors,   "filter_destructors"   },
@@ -42,7 +43,7 @@ namespace symgen::filters {
 
 
         for (auto [filter, name] : filters) {
-            if (!std::invoke(filter, sym, reader, demangled)) return name;
+            if (!std::invoke(filter, sym, reader)) return name;
         }
 
         return std::nullopt;
@@ -1,12 +1,21 @@
 #include <SymbolGenerator/utility.hpp>
+#include <SymbolGenerator/demangler.hpp>
 
-#include <Windows.h>
-#include <DbgHelp.h>
+#ifdef _WIN32
+    #include <Windows.h>
+    #include <DbgHelp.h>
+#else
+    #include <unistd.h>
+#endif
 
+#include <fstream>
+#include <iterator>
 #include <mutex>
+#include <thread>
 
 
 namespace symgen {
+#ifdef _WIN32
     std::string get_last_winapi_error(void) {
         DWORD error_code     = GetLastError();
         LPSTR message_buffer = nullptr;
@@ -33,33 +42,7 @@ namespace symgen {
     }
 
 
-    filter_function load_filter_function(const fs::path& path) {
-        struct dll_raii_lifetime {
-            HINSTANCE dll_handle;
-            ~dll_raii_lifetime(void) { FreeLibrary(dll_handle); }
-        };
-
-
-        static dll_raii_lifetime lifetime { [&] {
-            std::string path_str  = path.string();
-            LPCSTR      path_cstr = path_str.c_str();
-
-            auto result = LoadLibrary(path_cstr);
-            logger::instance().assert_that(result, "Failed to load DLL ", path, ": ", get_last_winapi_error());
-            logger::instance().verbose("Loaded ", path, " as additional filter function.");
-
-            return result;
-        } () };
-
-
-        auto result = GetProcAddress(lifetime.dll_handle, "keep_symbol");
-        logger::instance().assert_that(result, "Failed to load keep_symbol method from DLL ", path, ": ", get_last_winapi_error());
-
-        return (filter_function) result;
-    }
-
-
-    std::string demangle_symbol(const std::string& symbol) {
+    static std::string undecorate_symbol_name(const std::string& symbol) {
         static std::array<char, (1 << 16)> symbol_buffer;
         static std::mutex mtx;
         std::lock_guard lock { mtx }; // DbgHelp functions are not threadsafe.
@@ -73,4 +56,67 @@ namespace symgen {
 
         return std::string { symbol_buffer.begin(), symbol_buffer.begin() + count };
     }
+#endif
+
+
+    std::string demangle_symbol(std::string_view symbol) {
+        // Names that aren't C++-mangled (e.g. extern "C" functions) are their own demangled name.
+        if (!symbol.starts_with('?')) return std::string { symbol };
+
+        #ifdef _WIN32
+            // The output of the built-in demangler has not been verified against DbgHelp yet,
+            // so DbgHelp stays authoritative where it is available, to keep existing rules matching the same symbols.
+            // DbgHelp requires a null-terminated string.
+            return undecorate_symbol_name(std::string { symbol });
+        #else
+            if (auto demangled = demangle_msvc_name(symbol); demangled) return std::move(*demangled);
+            return std::string { symbol };
+        #endif
+    }
+
+
+    write_result write_file_if_changed(const fs::path& path, std::string_view contents) {
+        std::error_code ec;
+
+        if (fs::exists(path, ec) && fs::file_size(path, ec) == contents.size() && !ec) {
+            std::ifstream stream { path, std::ios::binary };
+            std::string existing { std::istreambuf_iterator<char> { stream }, std::istreambuf_iterator<char> { } };
+
+            if (stream.good() || stream.eof()) {
+                if (existing == contents) return write_result::UNCHANGED;
+            }
+        }
+
+
+        // Write to a temporary file first, so anything reading the file never sees it half-written.
+        fs::path temp_path = get_temporary_path(path);
+        bool written;
+
+        {
+            std::ofstream stream { temp_path, std::ios::binary | std::ios::trunc };
+            stream.write(contents.data(), (std::streamsize) contents.size());
+
+            written = (bool) stream;
+        }
+
+        if (written) fs::rename(temp_path, path, ec);
+
+        if (!written || ec) {
+            fs::remove(temp_path, ec);
+            return write_result::FAILED;
+        }
+
+        return write_result::WRITTEN;
+    }
+
+
+    fs::path get_temporary_path(const fs::path& path) {
+        #ifdef _WIN32
+            const auto process = GetCurrentProcessId();
+        #else
+            const auto process = ::getpid();
+        #endif
+
+        return fs::path { path } += stream_to_string(".", process, ".", std::hex, hash_of(std::this_thread::get_id()), ".tmp");
+    }
 }
\ No newline at end of file
@@ -6,13 +6,28 @@
 #include <vector>
 #include <string_view>
 #include <sstream>
+#include <span>
+#include <cstring>
+#include <cstdint>
 
 
 namespace symgen {
-    using filter_function = int(*)(const char*, const void*, const void*);
+    #ifdef _WIN32
+        extern std::string get_last_winapi_error(void);
+    #endif
 
-    extern filter_function load_filter_function(const fs::path& path);
-    extern std::string demangle_symbol(const std::string& symbol);
+    extern std::string demangle_symbol(std::string_view symbol);
+
+
+    enum class write_result { UNCHANGED, WRITTEN, FAILED };
+
+    // Writes the given contents to a file, unless the file already contains exactly the same contents.
+    // This keeps the modification time of unchanged outputs, so build systems do not rebuild anything that depends on them.
+    extern write_result write_file_if_changed(const fs::path& path, std::string_view contents);
+
+    // Path of a temporary file next to the given file, to write its new contents to before replacing it.
+    // The path includes the current process and thread, so processes and threads writing the same file at the same time do not collide.
+    extern fs::path get_temporary_path(const fs::path& path);
 
 
     template <typename T> inline std::size_t hash_of(const T& v) {
@@ -20,6 +35,57 @@ namespace symgen {
     }
 
 
+    // Index of the shard a hash belongs to, for hash tables that are split into the given number of shards.
+    // The tables within each shard use the low bits of the hash to pick a bucket, so the shard is picked from the high bits.
+    template <std::size_t Shards> inline std::size_t get_shard_index(std::size_t hash) {
+        static_assert((Shards & (Shards - 1)) == 0, "Shard count must be a power of two.");
+        return (hash >> (8 * sizeof(std::size_t) - 16)) & (Shards - 1);
+    }
+
+
+    // Hash that does not change between runs or builds of the program (unlike std::hash and absl::Hash), for hashes that are stored on disk.
+    inline std::uint64_t stable_hash(std::span<const std::byte> data, std::uint64_t seed = 0) {
+        constexpr auto mix = [] (std::uint64_t x) {
+            x ^= x >> 32;
+            x *= 0xD6E8FEB86659FD93ull;
+            x ^= x >> 32;
+            x *= 0xD6E8FEB86659FD93ull;
+            x ^= x >> 32;
+
+            return x;
+        };
+
+
+        std::uint64_t result = mix(seed ^ (data.size() * 0x9E3779B97F4A7C15ull));
+        std::size_t i = 0;
+
+        for (; i + sizeof(std::uint64_t) <= data.size(); i += sizeof(std::uint64_t)) {
+            std::uint64_t word;
+            std::memcpy(&word, data.data() + i, sizeof(word));
+
+            result = mix(result ^ word);
+        }
+
+        std::uint64_t tail = 0;
+        if (i < data.size()) std::memcpy(&tail, data.data() + i, data.size() - i);
+
+        return mix(result ^ tail);
+    }
+
+
+    inline std::uint64_t stable_hash(std::string_view sv, std::uint64_t seed = 0) {
+        return stable_hash(std::as_bytes(std::span { sv.data(), sv.size() }), seed);
+    }
+
+
+    // Reads a little-endian value from the given offset. Data read from files is not necessarily aligned, so this copies rather than casting.
+    template <typename T> inline T read_le(std::span<const std::byte> data, std::size_t offset) {
+        T result;
+        std::memcpy(&result, data.data() + offset, sizeof(T));
+        return result;
+    }
+
+
     template <typename... Ts> inline std::string stream_to_string(const Ts&... args) {
         std::stringstream stream;
         (stream << ... << args);
@@ -55,17 +121,6 @@ namespace symgen {
     }
 
 
-    inline std::vector<fs::path> find_all_of_type(const fs::path& dir, std::string_view extension) {
-        std::vector<fs::path> result;
-
-        for (const auto& entry : fs::recursive_directory_iterator(dir)) {
-            if (entry.is_regular_file() && entry.path().extension() == extension) result.emplace_back(entry.path());
-        }
-
-        return result;
-    }
-
-
     template <typename T> inline auto construct(void) {
         return [] (auto&& arg) -> T { return T { std::forward<decltype(arg)>(arg) }; };
     }
@@ -117,47 +172,4 @@ namespace symgen {
 
         return std::nullopt;
     }
-
-
-    inline std::vector<std::string_view> split_symbol_namespaces(std::string_view symbol) {
-        std::vector<std::string_view> result;
-        std::string_view::iterator current_token_start = symbol.begin();
-
-        // Some symbols have names of the format X::Y::`description' or X::Y::`description 'X::Y::symbol''.
-        // These two different formats prevent us from just keeping track of nesting depth directly.
-        // Fortunately, various C++ limitations seem to make it impossible to have further nesting of quotes,
-        // e.g., X::Y::`description 'X::Y::symbol'' where "symbol" itself contains quotes seem to be impossible,
-        // so we just have to keep track of these special cases.
-        std::size_t quote_depth     = 0;
-        std::size_t template_depth  = 0;
-
-        for (auto it = symbol.begin(); it != symbol.end(); ++it) {
-            std::string_view sv { it, symbol.end() };
-
-            if      (sv.starts_with('<') && quote_depth == 0) ++template_depth;
-            else if (sv.starts_with('>') && quote_depth == 0) --template_depth;
-            else if (sv.starts_with('`') && template_depth == 0 && quote_depth == 0) ++quote_depth;
-
-            else if (sv.starts_with('\'') && template_depth == 0 && quote_depth > 0) {
-                // This could be either a begin quote or an end quote. If it is a begin quote it will be followed by a symbol,
-                // if this is an end quote it will be followed by a namespace separator, another end quote or the end of the string.
-                auto rest = sv.substr(1);
-
-                if (rest.starts_with("::") || rest.starts_with('\'') || rest.empty()) --quote_depth;
-                else ++quote_depth;
-            }
-
-            else if (sv.starts_with("::") && template_depth == 0 && quote_depth == 0) {
-                result.emplace_back(current_token_start, it);
-                current_token_start = it + 2; // +2 to skip leading ::
-            }
-        }
-
-
-        if (current_token_start != symbol.end()) {
-            result.emplace_back(current_token_start, symbol.end());
-        }
-
-        return result;
-    }
 }
\ No newline at end of file
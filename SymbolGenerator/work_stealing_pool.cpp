@@ -0,0 +1,177 @@
+#include <SymbolGenerator/work_stealing_pool.hpp>
+
+#include <algorithm>
+
+
+namespace symgen {
+    using std::chrono::steady_clock;
+
+
+    work_stealing_pool::work_stealing_pool(std::size_t thread_count, std::size_t max_pending) : max_pending(std::max<std::size_t>(max_pending, 1)) {
+        thread_count = std::max<std::size_t>(thread_count, 1);
+
+        workers.reserve(thread_count);
+        for (std::size_t i = 0; i < thread_count; ++i) workers.emplace_back(std::make_unique<worker>());
+
+        // Workers are only started once all deques exist, since any worker may try to steal from any other.
+        for (std::size_t i = 0; i < thread_count; ++i) {
+            workers[i]->thread = std::thread { [this, i] { worker_main(i); } };
+        }
+    }
+
+
+    work_stealing_pool::~work_stealing_pool(void) {
+        {
+            std::lock_guard lock { wait_mtx };
+            finishing = true;
+        }
+
+        wait_cv.notify_all();
+
+        for (auto& w : workers) {
+            if (w->thread.joinable()) w->thread.join();
+        }
+    }
+
+
+    void work_stealing_pool::push(task_t task, std::uint64_t weight) {
+        auto& target = *workers[next_worker.fetch_add(1, std::memory_order_relaxed) % workers.size()];
+
+        // Pending is incremented before the task becomes visible so it can never underflow,
+        // and must be updated while holding the wait mutex, otherwise a worker could miss the notification
+        // between checking its wait condition and going to sleep.
+        {
+            std::unique_lock lock { wait_mtx };
+            space_cv.wait(lock, [&] { return pending.load(std::memory_order_acquire) < max_pending; });
+
+            pending.fetch_add(1, std::memory_order_release);
+        }
+
+
+        {
+            std::lock_guard lock { target.mtx };
+
+            // Keep the deque sorted from heaviest to lightest. Tasks are usually pushed in descending order of weight,
+            // in which case this is just an insertion at the end.
+            auto where = std::upper_bound(
+                target.tasks.begin(),
+                target.tasks.end(),
+                weight,
+                [] (std::uint64_t w, const task_entry& entry) { return w > entry.weight; }
+            );
+
+            target.tasks.insert(where, task_entry { std::move(task), weight });
+        }
+
+        wait_cv.notify_one();
+    }
+
+
+    void work_stealing_pool::finish(void) {
+        {
+            std::lock_guard lock { wait_mtx };
+            finishing = true;
+        }
+
+        wait_cv.notify_all();
+
+        for (auto& w : workers) {
+            if (w->thread.joinable()) w->thread.join();
+        }
+
+
+        if (first_exception) std::rethrow_exception(first_exception);
+    }
+
+
+    std::vector<work_stealing_pool::worker_statistics> work_stealing_pool::get_statistics(void) const {
+        std::vector<worker_statistics> result;
+        result.reserve(workers.size());
+
+        for (const auto& w : workers) result.push_back(w->stats);
+        return result;
+    }
+
+
+    void work_stealing_pool::worker_main(std::size_t index) {
+        auto& self = *workers[index];
+        steady_clock::time_point start = steady_clock::now();
+
+
+        while (true) {
+            bool stolen = false;
+
+            if (auto entry = take_task(index, stolen); entry) {
+                steady_clock::time_point task_start = steady_clock::now();
+
+                try {
+                    entry->task();
+                } catch (...) {
+                    std::lock_guard lock { exception_mtx };
+                    if (!first_exception) first_exception = std::current_exception();
+                }
+
+                self.stats.busy_time += steady_clock::now() - task_start;
+                self.stats.tasks_executed += 1;
+                self.stats.tasks_stolen   += (std::size_t) stolen;
+
+                continue;
+            }
+
+
+            std::unique_lock lock { wait_mtx };
+            wait_cv.wait(lock, [&] { return pending.load(std::memory_order_acquire) > 0 || finishing; });
+
+            if (finishing && pending.load(std::memory_order_acquire) == 0) break;
+        }
+
+
+        self.stats.idle_time = (steady_clock::now() - start) - self.stats.busy_time;
+    }
+
+
+    std::optional<work_stealing_pool::task_entry> work_stealing_pool::take_task(std::size_t index, bool& stolen) {
+        auto on_taken = [&] {
+            // Only the transition from a full queue to a non-full one can unblock a producer.
+            if (pending.fetch_sub(1, std::memory_order_acq_rel) == max_pending) {
+                std::lock_guard lock { wait_mtx };
+                space_cv.notify_all();
+            }
+        };
+
+
+        // Take the heaviest task from our own deque first.
+        {
+            auto& self = *workers[index];
+            std::lock_guard lock { self.mtx };
+
+            if (!self.tasks.empty()) {
+                task_entry result = std::move(self.tasks.front());
+                self.tasks.pop_front();
+                on_taken();
+
+                return result;
+            }
+        }
+
+
+        // Steal the heaviest waiting task from the next worker that has any work, so large objects queued behind
+        // a busy worker's current task are started by idle workers instead of waiting until last.
+        for (std::size_t offset = 1; offset < workers.size(); ++offset) {
+            auto& victim = *workers[(index + offset) % workers.size()];
+            std::lock_guard lock { victim.mtx };
+
+            if (!victim.tasks.empty()) {
+                task_entry result = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                on_taken();
+
+                stolen = true;
+                return result;
+            }
+        }
+
+
+        return std::nullopt;
+    }
+}
\ No newline at end of file
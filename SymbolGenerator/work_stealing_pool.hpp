@@ -0,0 +1,90 @@
+#pragma once
+
+#include <SymbolGenerator/defs.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+
+namespace symgen {
+    // Persistent thread pool where every worker owns a deque of tasks, ordered from heaviest to lightest.
+    // Workers start with the heaviest task in their own deque, and steal the heaviest waiting task from another worker once they run out of work.
+    // The number of tasks waiting to be executed can optionally be bounded, in which case push() blocks until there is space,
+    // so that producers cannot run arbitrarily far ahead of the workers.
+    class work_stealing_pool {
+    public:
+        using task_t = std::function<void(void)>;
+
+
+        struct worker_statistics {
+            std::size_t tasks_executed = 0;
+            std::size_t tasks_stolen   = 0;
+            std::chrono::nanoseconds busy_time { 0 };
+            std::chrono::nanoseconds idle_time { 0 };
+        };
+
+
+        explicit work_stealing_pool(std::size_t thread_count, std::size_t max_pending = std::numeric_limits<std::size_t>::max());
+        ~work_stealing_pool(void);
+
+        work_stealing_pool(const work_stealing_pool&) = delete;
+        work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+
+
+        // Adds a task to the pool. Tasks with a higher weight are started before lighter tasks assigned to the same worker.
+        // If the pool is bounded, this must not be called from within a task, since it may block until another task is taken.
+        void push(task_t task, std::uint64_t weight = 0);
+
+        // Waits until all tasks have been executed and stops the workers. No tasks may be pushed after calling this method.
+        // If any task threw an exception, the first such exception is rethrown from here.
+        void finish(void);
+
+
+        // Only valid after finish() has been called.
+        [[nodiscard]] std::vector<worker_statistics> get_statistics(void) const;
+        [[nodiscard]] std::size_t get_thread_count(void) const { return workers.size(); }
+    private:
+        struct task_entry {
+            task_t task;
+            std::uint64_t weight;
+        };
+
+        struct worker {
+            std::mutex mtx;
+            std::deque<task_entry> tasks;
+            worker_statistics stats;
+            std::thread thread;
+        };
+
+
+        std::vector<std::unique_ptr<worker>> workers;
+        std::atomic_size_t next_worker = 0;
+
+        // Number of tasks that have been pushed but not yet taken by a worker.
+        std::atomic_size_t pending = 0;
+        std::mutex wait_mtx;
+        std::condition_variable wait_cv;
+        bool finishing = false;
+
+        std::size_t max_pending;
+        std::condition_variable space_cv;
+
+        std::mutex exception_mtx;
+        std::exception_ptr first_exception = nullptr;
+
+
+        void worker_main(std::size_t index);
+        std::optional<task_entry> take_task(std::size_t index, bool& stolen);
+    };
+}
\ No newline at end of file